@@ -0,0 +1,136 @@
+#pragma once
+
+#include <ip/core/logging/ILogger.h>
+
+#include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/logging/LogArchiver.h>
+#include <ip/core/logging/LogFileUtils.h>
+#include <ip/core/logging/LogFlushPolicy.h>
+#include <ip/core/logging/LogRollPolicy.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/TimeUtils.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+
+namespace Metrics
+{
+class Counter;
+}
+
+namespace Logging
+{
+
+struct AsyncFileRing;
+
+// Rolling file logger (same naming, roll policy and archiving as RollingFileLogger) that never waits on the disk.  Lines are
+// packed into a fixed set of registered buffers which are handed to io_uring as they fill (or as the flush policy
+// dictates), with an fdatasync linked behind a write whenever the sync interval is due.  If every buffer is in flight
+// lines are staged in memory rather than blocking the caller.
+//
+// Where io_uring is unavailable (older kernels or headers, seccomp, non-Linux posix) filled buffers are written
+// synchronously with pwritev instead, and the same happens from the point a submission fails.  Failed writes are
+// counted in ip_log_write_errors_total.
+//
+// The first file is opened by the constructor, which throws if it can't be.  If a rolled file can't be opened, entries
+// are dropped (and counted in ip_log_file_entries_lost_total) while the open is retried once a second, and the first
+// line of the file that finally opens says how many were lost.  Posix only.
+class AsyncFileLogger : public ILogger
+{
+    public:
+        AsyncFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory);
+        AsyncFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy, size_t bufferSize, uint32_t bufferCount, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy);
+        virtual ~AsyncFileLogger();
+
+        virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_formatter.get(); }
+        virtual void Flush() override;
+        virtual void Service() override;
+
+        bool IsUsingIoUring() const { return m_ring != nullptr && !m_ringFailed; }
+
+    private:
+
+        enum class WriteBufferState
+        {
+            Free,
+            Filling,
+            Ready,
+            InFlight
+        };
+
+        struct RetiredFile
+        {
+            int m_fd;
+            std::experimental::filesystem::path m_path;
+        };
+
+        struct WriteBuffer
+        {
+            char* m_data;
+            size_t m_length;
+            size_t m_written;
+            int m_fd;
+            uint64_t m_fileOffset;
+            WriteBufferState m_state;
+        };
+
+        void WriteEntry(const LogEntry& entry, const IP::String* renderedLine);
+        void RollLogFile(void);
+        bool OpenLogFile(IP::Time::SystemTimePoint currentTime);
+
+        void Append(const char* data, size_t length);
+        bool AcquireBuffer(void);
+        void SubmitCurrentBuffer(void);
+        void DrainStagedOutput(void);
+
+        bool ShouldSync(void);
+
+        bool QueueWrite(uint32_t bufferIndex, bool sync);
+        bool SubmitToRing(bool wait);
+        void ReapCompletions(bool wait);
+        void WriteReadyBuffers(void);
+        void CloseRetiredFiles(void);
+
+        IP::UniquePtr<ILogLineFormatter> m_formatter;
+        LogFlushPolicy m_flushPolicy;
+        IP::String m_lineBuffer;
+
+        size_t m_bufferSize;
+        IP::Vector<char> m_bufferMemory;
+        IP::Vector<WriteBuffer> m_buffers;
+        int32_t m_currentBuffer;
+        IP::Time::SystemTimePoint m_currentBufferStartTime;
+        IP::String m_stagedOutput;
+
+        IP::UniquePtr<AsyncFileRing> m_ring;
+
+        // set once io_uring_enter fails for good; the ring is then only read for writes already in flight
+        bool m_ringFailed;
+        IP::Vector<uint64_t> m_unsubmitted;
+        IP::Time::SystemTimePoint m_lastSyncTime;
+
+        int m_fd;
+        std::experimental::filesystem::path m_fileName;
+        uint64_t m_fileOffset;
+        IP::Time::SystemTimePoint m_lastOpenTime;
+        uint64_t m_droppedEntries;
+        IP::Vector<RetiredFile> m_retiredFiles;
+        LogFileRoller m_roller;
+
+        IP::UniquePtr<LogArchiver> m_archiver;
+
+        IP::Metrics::Counter& m_writeErrorMetric;
+        IP::Metrics::Counter& m_lostMetric;
+};
+
+} // namespace Logging
+} // namespace IP
@@ -3,6 +3,7 @@
 #include <thread>
 
 #include <ip/core/logging/ILogger.h>
+#include <ip/core/logging/LogQueuePolicy.h>
 
 namespace IP
 {
@@ -11,15 +12,21 @@ namespace Logging
 
 struct BackgroundLoggerThreadData;
 
+// Queues entries for a logger that runs on its own thread.  The queue is bounded by a LogQueuePolicy; anything dropped
+// on overflow is counted per level and periodically reported through the logger.
 class BackgroundLogger : public ILogger
 {
     public:
 
         BackgroundLogger(const LoggerFactory& factory);
+        BackgroundLogger(const LoggerFactory& factory, const LogQueuePolicy& queuePolicy);
         virtual ~BackgroundLogger();
 
         virtual void Log(LogEntry&& entry) override;
 
+        // asynchronous; the background thread flushes its logger after draining everything queued before this call
+        virtual void Flush() override;
+
     private:
 
         std::shared_ptr<BackgroundLoggerThreadData> m_threadData;
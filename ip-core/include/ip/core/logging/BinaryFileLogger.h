@@ -0,0 +1,51 @@
+#pragma once
+
+#include <ip/core/logging/ILogger.h>
+
+#include <ip/core/logging/BufferedLogFile.h>
+#include <ip/core/logging/LogArchiver.h>
+#include <ip/core/logging/LogFileUtils.h>
+#include <ip/core/logging/LogFlushPolicy.h>
+#include <ip/core/logging/LogRollPolicy.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/UnorderedMap.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Rolling file logger (same naming, policies and archiving as RollingFileLogger) that writes the compact binary record
+// stream described in BinaryLogFormat.h instead of formatted text.  Structured entries are stored as their site id and
+// raw field values, so nothing is formatted at all; the log-decoder tool turns the files back into text or JSON.
+class BinaryFileLogger : public ILogger
+{
+    public:
+        BinaryFileLogger(IP::String filenamePrefix, const std::experimental::filesystem::path& directory);
+        BinaryFileLogger(IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy);
+        virtual ~BinaryFileLogger();
+
+        virtual void Log(LogEntry&& entry) override;
+        virtual void Flush() override;
+        virtual void Service() override;
+
+    private:
+
+        void EncodeSite(IP::String& output, LogSite& site, uint32_t siteId, const LogEntry& entry);
+        void EncodeEntry(IP::String& output, const LogEntry& entry, uint32_t siteId);
+
+        void RollLogFile(void);
+
+        BufferedLogFile m_outputFile;
+        std::experimental::filesystem::path m_outputFileName;
+
+        // field count each site was last defined with in the current file
+        IP::UnorderedMap<uint32_t, size_t> m_definedSites;
+
+        LogFileRoller m_roller;
+
+        IP::UniquePtr<LogArchiver> m_archiver;
+};
+
+} // namespace Logging
+} // namespace IP
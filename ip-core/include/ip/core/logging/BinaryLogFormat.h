@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/memory/stl/Deque.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/UnorderedMap.h>
+#include <ip/core/memory/stl/Vector.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Binary log files start with BINARY_LOG_MAGIC and are followed by a stream of records, each introduced by a
+// BinaryLogRecordType byte.  Integers are in host byte order; strings are a uint32 length followed by the bytes.
+//
+//   Site:  uint32 site id, uint32 line, string file, string message, uint8 key count, string keys...
+//   Entry: int64 time (ns since the epoch), uint8 level, uint8 channel, uint32 site id, then for site id zero a string holding the
+//          text, otherwise uint8 field count and per field a LogFieldType byte and its value (8 bytes for numbers,
+//          1 for bool, a string for strings)
+//
+// A site record always precedes the first entry from that site in each file, and is repeated if the site's field
+// count changes.
+
+static const char BINARY_LOG_MAGIC[8] = { 'I', 'P', 'B', 'L', 'O', 'G', '0', '2' };
+static const char* const BINARY_LOG_FILE_EXTENSION = ".blog";
+
+enum class BinaryLogRecordType : uint8_t
+{
+    Site = 1,
+    Entry = 2
+};
+
+// Decodes a binary log file held in memory back into entries
+class BinaryLogReader
+{
+    public:
+
+        // throws if the data doesn't start with BINARY_LOG_MAGIC
+        BinaryLogReader(const char* data, size_t length);
+
+        // false at the end of the data or at a truncated record, as left behind by a crash.  The entry's site and
+        // field keys point into the reader and stay valid until the reader is destroyed or the site is redefined.
+        bool ReadNext(LogEntry& entry);
+
+    private:
+
+        struct DecodedSite
+        {
+            IP::String m_file;
+            IP::String m_message;
+            IP::Vector<IP::String> m_keys;
+            LogSite m_site;
+        };
+
+        bool ReadSite(void);
+        bool ReadEntry(LogEntry& entry);
+
+        bool ReadBytes(void* destination, size_t length);
+        bool ReadString(IP::String& value);
+
+        template<typename T>
+        bool ReadValue(T& value) { return ReadBytes(&value, sizeof(value)); }
+
+        const char* m_data;
+        size_t m_length;
+        size_t m_position;
+
+        IP::Deque<DecodedSite> m_sites;
+        IP::UnorderedMap<uint32_t, DecodedSite*> m_sitesById;
+};
+
+} // namespace Logging
+} // namespace IP
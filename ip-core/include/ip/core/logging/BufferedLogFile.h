@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <ip/core/logging/LogFlushPolicy.h>
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/metrics/Counter.h>
+#include <ip/core/utils/OutputFile.h>
+#include <ip/core/utils/TimeUtils.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+// The output file of a file logger, with its writes batched and synced per a LogFlushPolicy.  Loggers append each
+// entry's bytes between BeginEntry and EndEntry, and pass Flush and Service through.  A batch that fails to write (a
+// full disk, say) is lost, and only the part of it that got out counts towards the file's size; the loss is counted,
+// and the logger writes TakeLossReport's warning ahead of its next entry.
+class BufferedLogFile
+{
+    public:
+
+        explicit BufferedLogFile(const LogFlushPolicy& flushPolicy);
+        ~BufferedLogFile();
+
+        BufferedLogFile(const BufferedLogFile& rhs) = delete;
+        BufferedLogFile& operator =(const BufferedLogFile& rhs) = delete;
+
+        // the previous file is flushed and closed first
+        bool Open(const std::experimental::filesystem::path& path);
+        void Close();
+        bool IsOpen() const { return m_outputFile.IsOpen(); }
+
+        // returns the buffer to append the entry to
+        IP::String& BeginEntry();
+
+        // writes the pending output if the policy calls for it after an entry at this level
+        void EndEntry(LogLevel level);
+
+        // bytes written to the file plus those still pending, which is where the next entry will start
+        uint64_t GetSize() const { return m_outputFileBytes + m_pendingOutput.size(); }
+
+        void Flush();
+        void Service();
+
+        // whether the file ends partway through an entry because the last write failed after some of it got out
+        bool EndsMidEntry() const { return m_endsMidEntry; }
+
+        // describes the entries lost since the last report, if there were any
+        bool TakeLossReport(IP::String& message);
+
+    private:
+
+        void WritePendingOutput();
+        void SyncData(IP::Time::SystemTimePoint currentTime);
+
+        LogFlushPolicy m_flushPolicy;
+
+        IP::String m_pendingOutput;
+        uint64_t m_pendingEntries;
+        IP::Time::SystemTimePoint m_oldestPendingTime;
+        IP::Time::SystemTimePoint m_lastSyncTime;
+        bool m_unsyncedOutput;
+
+        IP::FileUtils::OutputFile m_outputFile;
+        uint64_t m_outputFileBytes;
+        bool m_endsMidEntry;
+
+        uint64_t m_unreportedLostEntries;
+        uint64_t m_unreportedLostBytes;
+        IP::Metrics::Counter& m_lostMetric;
+};
+
+} // namespace Logging
+} // namespace IP
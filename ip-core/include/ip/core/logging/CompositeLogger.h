@@ -2,6 +2,10 @@
 
 #include <ip/core/logging/ILogger.h>
 
+#include <mutex>
+
+#include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/logging/LogLevel.h>
 #include <ip/core/memory/stl/Vector.h>
 
 namespace IP
@@ -9,18 +13,62 @@ namespace IP
 namespace Logging
 {
 
+struct CompositeLoggerSink
+{
+    IP::UniquePtr<ILogger> m_logger;
+
+    // entries below this level are never handed to the sink
+    LogLevel m_minimumLevel;
+};
+
+// Fans each entry out to a set of sinks.  Sinks are filtered by level before anything is copied; when more than one
+// sink takes an entry it's wrapped in a single shared LogRecord, with each format used by two or more of those sinks
+// rendered into it once.  Which sinks and shared formats an entry needs is worked out per level up front, so Log only
+// reads the composite's state and is as threadsafe as its sinks.
 class CompositeLogger : public ILogger
 {
     public:
         CompositeLogger(IP::Vector<IP::UniquePtr<ILogger>>&& loggers);
+        CompositeLogger(IP::Vector<CompositeLoggerSink>&& sinks);
         virtual ~CompositeLogger();
 
         virtual void Log(LogEntry&& entry) override;
+        virtual void Flush() override;
+        virtual void Service() override;
 
     private:
 
-        IP::Vector<IP::UniquePtr<ILogger>> m_loggers;
+        struct SinkState
+        {
+            CompositeLoggerSink m_sink;
+
+            // index into m_renderers, or -1 if the sink has no formatter to share
+            int32_t m_rendererIndex;
+        };
+
+        struct Renderer
+        {
+            // a clone of the sinks' formatter, so rendering never touches state owned by a sink's thread; formatters
+            // cache state between lines, so threads logging through the composite take turns with it
+            IP::UniquePtr<ILogLineFormatter> m_formatter;
+            std::mutex m_mutex;
+        };
+
+        // what an entry at one level fans out to
+        struct LevelPlan
+        {
+            uint32_t m_acceptingSinkCount;
+            size_t m_lastAcceptingSink;
+
+            // the renderers of formats wanted by two or more of the accepting sinks
+            IP::Vector<size_t> m_sharedRenderers;
+        };
+
+        static const size_t LEVEL_COUNT = static_cast<size_t>(LogLevel::None) + 1;
 
+        IP::Vector<SinkState> m_sinks;
+        IP::Vector<IP::UniquePtr<Renderer>> m_renderers;
+        LevelPlan m_levelPlans[LEVEL_COUNT];
 };
 
 } // namespace Logging
@@ -3,24 +3,67 @@
 #include <ip/core/logging/ILogger.h>
 
 #include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/logging/LogFlushPolicy.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/StandardOutput.h>
+#include <ip/core/utils/TimeUtils.h>
 
 namespace IP
 {
 namespace Logging
 {
 
+// Writes lines to standard output, collecting them and handing each group to the OS in a single gather write instead
+// of a write per line.  On a terminal, pending lines go out at the end of every batch (Service), so output stays
+// interactive; until something such as a BackgroundLogger calls Service, nothing is batching and each line is written
+// as it's logged.  Redirected to a file or pipe, lines are coalesced according to the flush policy.  Shared records are
+// kept alive and written from their existing rendering rather than copied.
+//
+// Lines are written straight to the standard output descriptor, bypassing std::cout, so anything else buffered in
+// std::cout can appear out of order with them.
 class ConsoleLogger : public ILogger
 {
     public:
         ConsoleLogger(IP::UniquePtr<ILogLineFormatter>&& formatter);
+        ConsoleLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const LogFlushPolicy& flushPolicy);
         virtual ~ConsoleLogger();
 
         virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_formatter.get(); }
+        virtual void Flush() override;
+        virtual void Service() override;
 
     private:
 
+        // either one of m_lines, or a line rendered by a shared record held in m_sharedRecords
+        struct PendingLine
+        {
+            const IP::String* m_sharedLine;
+            size_t m_lineIndex;
+        };
+
+        void AddPendingLine(const LogEntry& entry, const PendingLine& line, size_t length);
+        void WritePendingOutput();
+
         IP::UniquePtr<ILogLineFormatter> m_formatter;
+        LogFlushPolicy m_flushPolicy;
+        bool m_isTerminal;
+
+        // set once Service is called, meaning lines arrive in batches that end with it
+        bool m_serviced;
+
+        // reused between writes; only the first m_lineCount hold pending lines
+        IP::Vector<IP::String> m_lines;
+        size_t m_lineCount;
+
+        IP::Vector<LogRecordPtr> m_sharedRecords;
+        IP::Vector<PendingLine> m_pendingLines;
+        IP::Vector<IP::FileUtils::OutputBuffer> m_writeBuffers;
+        size_t m_pendingBytes;
+        IP::Time::SystemTimePoint m_oldestPendingTime;
 };
 
 } // namespace Logging
-} // namespace IP
\ No newline at end of file
+} // namespace IP
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+enum class DatagramDropPolicy
+{
+    // datagrams the collector still hasn't taken once the retries run out are discarded
+    DropUnsent,
+
+    // unsent datagrams wait for the next batch, and the oldest are discarded once m_maxPendingDatagrams are waiting
+    KeepNewest
+};
+
+// Controls how a DatagramLogger batches its datagrams and what it gives up when the collector can't keep up
+struct DatagramLogPolicy
+{
+    DatagramLogPolicy();
+
+    // a batch is sent as soon as this many datagrams are queued
+    size_t m_batchSize;
+
+    // longer lines are truncated to fit
+    size_t m_maxDatagramSize;
+
+    // upper bound on datagrams held back while the collector is slow, before the oldest are dropped
+    size_t m_maxPendingDatagrams;
+
+    DatagramDropPolicy m_dropPolicy;
+
+    // how long a batch keeps being retried, as the collector makes room in its receive queue, before the drop policy
+    // applies to whatever is left; zero gives up as soon as the queue is full
+    std::chrono::milliseconds m_retryTimeout;
+
+    // while the collector isn't listening entries are dropped, and reconnecting is attempted at most this often
+    std::chrono::milliseconds m_reconnectInterval;
+
+    // how often dropped entry counts are reported, as a warning sent to the collector
+    std::chrono::milliseconds m_dropReportInterval;
+};
+
+} // namespace Logging
+} // namespace IP
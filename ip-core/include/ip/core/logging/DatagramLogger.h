@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ip/core/logging/ILogger.h>
+
+#include <ip/core/logging/DatagramLogPolicy.h>
+#include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/logging/LogFlushPolicy.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/DatagramSocket.h>
+#include <ip/core/utils/TimeUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Ships entries to a log collector listening on a local Unix datagram socket, one datagram per entry, sent in batches
+// of a few system calls each (sendmmsg on Linux).  With a formatter each datagram is a formatted line; without one it
+// is a self-contained binary entry record as described in BinaryLogFormat.h, with site id zero and the rendered
+// message as its text, so every datagram decodes on its own.
+//
+// The collector never holds the logger up for long: a full receive queue gets a bounded number of short retries and
+// then the drop policy applies, and while nothing is listening entries are dropped and reconnects are rate limited.
+// A datagram larger than the socket will send is dropped on its own.  Drops are counted and periodically reported to the collector as a warning.  Posix only.
+class DatagramLogger : public ILogger
+{
+    public:
+
+        // the collector doesn't have to be listening yet
+        DatagramLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* socketPath);
+        DatagramLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* socketPath, const LogFlushPolicy& flushPolicy, const DatagramLogPolicy& datagramPolicy);
+        virtual ~DatagramLogger();
+
+        virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_formatter.get(); }
+        virtual void Flush() override;
+        virtual void Service() override;
+
+        bool IsConnected() const { return m_socket.IsOpen(); }
+        uint64_t GetDroppedCount() const { return m_droppedCount; }
+
+    private:
+
+        void WriteEntry(const LogEntry& entry, const IP::String* renderedLine);
+        void AppendDatagram(IP::String& buffer, const LogEntry& entry, const IP::String* renderedLine);
+        void EncodeBinaryEntry(IP::String& buffer, const LogEntry& entry);
+
+        bool Connect(IP::Time::SystemTimePoint currentTime);
+        void SendPendingDatagrams(void);
+        void DropPendingDatagrams(size_t count);
+        void CompactPendingDatagrams(void);
+        void SendDropReport(IP::Time::SystemTimePoint currentTime, bool force);
+
+        size_t GetPendingCount() const { return m_datagramEnds.size() - m_firstPending; }
+        size_t GetPendingOffset(size_t index) const { return index == 0 ? 0 : m_datagramEnds[index - 1]; }
+
+        IP::UniquePtr<ILogLineFormatter> m_formatter;
+        LogFlushPolicy m_flushPolicy;
+        DatagramLogPolicy m_datagramPolicy;
+        IP::String m_lineBuffer;
+
+        IP::String m_socketPath;
+        IP::System::DatagramSocket m_socket;
+        IP::Time::SystemTimePoint m_lastConnectTime;
+
+        // queued datagrams back to back, with the end offset of each; those before m_firstPending have been sent or
+        // dropped and are compacted away once they make up half the queue
+        IP::String m_pendingData;
+        IP::Vector<size_t> m_datagramEnds;
+        size_t m_firstPending;
+
+        // datagrams at the front of the queue that the collector had no room for last time; a new batch is only
+        // attempted once enough entries have arrived behind them
+        size_t m_heldBackCount;
+        IP::Time::SystemTimePoint m_oldestPendingTime;
+        IP::Vector<IP::System::DatagramBuffer> m_sendBuffers;
+
+        uint64_t m_droppedCount;
+        uint64_t m_unreportedDrops;
+        IP::String m_reportBuffer;
+        IP::Time::SystemTimePoint m_lastDropReportTime;
+};
+
+} // namespace Logging
+} // namespace IP
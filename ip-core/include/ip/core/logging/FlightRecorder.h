@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/memory/Memory.h>
+#include <ip/core/utils/OutputFile.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+struct LogEntry;
+
+// Always-on ring of the most recent entries at every level, kept in memory allocated up front.  Recording an entry is a
+// ticket increment and a copy into a fixed-size slot (long lines are truncated), with no locks or system calls, so the
+// verbose history that's normally filtered out costs only memory writes.  Dumps make no allocations and are safe from
+// a signal handler.
+class FlightRecorder
+{
+    public:
+
+        static constexpr size_t SLOT_TEXT_LENGTH = 232;
+
+        FlightRecorder(size_t slotCount);
+        ~FlightRecorder();
+
+        FlightRecorder(const FlightRecorder& rhs) = delete;
+        FlightRecorder& operator =(const FlightRecorder& rhs) = delete;
+
+        // threadsafe
+        void Record(const LogEntry& entry);
+
+        // appends every complete slot, oldest first, under a header naming the reason
+        void Dump(IP::FileUtils::OutputFile& file, const char* reason) const;
+
+    private:
+
+        struct Slot
+        {
+            // the entry's ticket plus one once the slot is complete, zero while it's being written
+            std::atomic<uint64_t> m_sequence;
+
+            // local time in milliseconds since the epoch, converted when recorded since that isn't async-signal-safe
+            int64_t m_localTime;
+            uint8_t m_level;
+            uint8_t m_channel;
+            uint16_t m_length;
+            char m_text[SLOT_TEXT_LENGTH];
+        };
+
+        IP::UniquePtr<Slot> m_slots;
+        size_t m_slotCount;
+        std::atomic<uint64_t> m_nextTicket;
+
+        // refreshed by Record whenever the hour changes, which is when daylight saving starts and ends
+        std::atomic<int64_t> m_utcOffsetHour;
+        std::atomic<int64_t> m_utcOffsetSeconds;
+};
+
+// Installs a recorder for the process: LOG sites at or above captureLevel are formatted and recorded even when the
+// log level filters them out, and the recorder is dumped to <dumpDirectory>/flight_recorder_<pid>.log on LOG_FATAL
+// and when the process crashes.  Not threadsafe relative to logging.
+void InstallFlightRecorder(FlightRecorder* recorder, LogLevel captureLevel, const std::experimental::filesystem::path& dumpDirectory);
+void UninstallFlightRecorder();
+
+// records the entry if a recorder is installed and capturing its level
+void RecordFlightRecorderEntry(const LogEntry& entry);
+
+// safe from a signal handler; does nothing without an installed recorder
+void DumpFlightRecorder(const char* reason);
+
+extern std::atomic<LogLevel> g_flightRecorderCaptureLevel;
+
+inline bool IsFlightRecorderCapturing(LogLevel level)
+{
+    return level >= g_flightRecorderCaptureLevel.load(std::memory_order_relaxed);
+}
+
+// Owns a FlightRecorder and keeps it installed for its lifetime
+class FlightRecorderScope
+{
+    public:
+
+        FlightRecorderScope(size_t slotCount, LogLevel captureLevel, const std::experimental::filesystem::path& dumpDirectory);
+        ~FlightRecorderScope();
+
+    private:
+
+        FlightRecorder m_recorder;
+};
+
+} // namespace Logging
+} // namespace IP
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/String.h>
 
 namespace IP
 {
@@ -15,7 +16,15 @@ class ILogLineFormatter
 
         virtual ~ILogLineFormatter() {}
 
-        virtual void FormatLogLine(IP::StringStream& ss, LogEntry&& entry) const = 0;
+        // appends the formatted line, without a line terminator, to the end of buffer
+        virtual void FormatLogLine(IP::String& buffer, const LogEntry& entry) const = 0;
+
+        // formatters that produce identical output for every entry must return the same signature, so a line rendered
+        // by one can stand in for the other
+        virtual const char* GetFormatSignature() const = 0;
+
+        // a new formatter with the same output, for formatting on a different thread than this one's owner
+        virtual IP::UniquePtr<ILogLineFormatter> Clone() const = 0;
 };
 
 }
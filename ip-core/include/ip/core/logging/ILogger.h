@@ -2,6 +2,7 @@
 
 #include <functional>
 
+#include <ip/core/logging/LogRecord.h>
 #include <ip/core/memory/Memory.h>
 
 namespace IP
@@ -9,7 +10,7 @@ namespace IP
 namespace Logging
 {
 
-struct LogEntry;
+class ILogLineFormatter;
 
 class ILogger
 {
@@ -18,6 +19,25 @@ class ILogger
         virtual ~ILogger() {}
 
         virtual void Log(LogEntry&& entry) = 0;
+
+        // logs a record shared with other sinks; loggers that can use a pre-rendered line override this, everything
+        // else gets its own copy of the entry
+        virtual void LogShared(const LogRecordPtr& record)
+        {
+            LogEntry entry = record->GetEntry();
+            Log(std::move(entry));
+        }
+
+        // the formatter whose lines this logger writes verbatim, or nullptr; a CompositeLogger uses it to render lines
+        // once on behalf of every sink sharing the same format
+        virtual const ILogLineFormatter* GetFormatter() const { return nullptr; }
+
+        // pushes any buffered output to its destination
+        virtual void Flush() {}
+
+        // invoked periodically (and after each batch when driven by a BackgroundLogger) so buffering loggers can apply
+        // time-based policies
+        virtual void Service() {}
 };
 
 using LoggerFactory = std::function<IP::UniquePtr<ILogger>()>;
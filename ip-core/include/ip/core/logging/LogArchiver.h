@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include <thread>
+
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/String.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+struct LogArchiverThreadData;
+
+struct LogArchivePolicy
+{
+    LogArchivePolicy();
+
+    // gzip files on their way into the archive; ignored (files are moved as-is) when built without zlib
+    bool m_compress;
+
+    // archived files older than this are deleted
+    std::chrono::hours m_maxAge;
+
+    // once the archive grows past this many bytes the oldest files are deleted; zero means no limit
+    uint64_t m_maxTotalBytes;
+
+    // how often retention is enforced when no files are being archived
+    std::chrono::minutes m_maintenanceInterval;
+};
+
+// Moves closed log files into the log directory's archive on a low priority background thread, compressing them on the
+// way, and enforces the retention policy on the archive.  At startup it also sweeps up files left in the log directory
+// by earlier processes, so none of that work delays the logger that owns it.
+class LogArchiver
+{
+    public:
+
+        LogArchiver(const std::experimental::filesystem::path& logDirectory, const IP::String& filenamePrefix, const LogArchivePolicy& policy);
+        ~LogArchiver();
+
+        // queues a closed log file for archiving
+        void ArchiveFile(const std::experimental::filesystem::path& logFile);
+
+    private:
+
+        std::shared_ptr<LogArchiverThreadData> m_threadData;
+        IP::UniquePtr<std::thread> m_backgroundThread;
+};
+
+} // namespace Logging
+} // namespace IP
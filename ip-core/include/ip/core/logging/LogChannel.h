@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include <ip/core/logging/LogLevel.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Subsystems that can be given their own log level with SetLogChannelLevel.  At most eight, since each channel's
+// enabled levels are packed into one byte of a single atomic word.
+enum class LogChannel : uint8_t
+{
+    General,
+    Render,
+    Vulkan,
+    Memory,
+    IO,
+    Count
+};
+
+const char* GetLogChannelName(LogChannel channel);
+
+// threadsafe; channels start at the same level as the global default.  General is the channel plain LOG sites use and
+// follows SetLogLevel.
+LogLevel GetLogChannelLevel(LogChannel channel);
+void SetLogChannelLevel(LogChannel channel, LogLevel level);
+
+// byte N holds channel N's enabled levels, bit M of it set if level M is enabled
+extern std::atomic<uint64_t> g_logChannelLevelMasks;
+
+inline bool IsLogChannelEnabled(LogChannel channel, LogLevel level)
+{
+    uint32_t bit = static_cast<uint32_t>(channel) * 8 + static_cast<uint32_t>(level);
+    return (g_logChannelLevelMasks.load(std::memory_order_relaxed) >> bit) & 1;
+}
+
+} // namespace Logging
+} // namespace IP
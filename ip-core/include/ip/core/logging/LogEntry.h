@@ -1,6 +1,11 @@
 #pragma once
 
+#include <ip/core/logging/LogChannel.h>
+#include <ip/core/logging/LogField.h>
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/logging/LogSite.h>
 #include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
 #include <ip/core/utils/TimeUtils.h>
 
 namespace IP
@@ -11,17 +16,33 @@ namespace Logging
 struct LogEntry
 {
     LogEntry();
-    LogEntry(const char* levelName, IP::String&& text, IP::Time::SystemTimePoint time);
+    LogEntry(LogLevel level, IP::String&& text, IP::Time::SystemTimePoint time);
     LogEntry(const LogEntry& entry);
-    LogEntry(LogEntry&& entry);
+    LogEntry(LogEntry&& entry) noexcept;
+    ~LogEntry();
 
+    // moves are noexcept so growing a vector of entries moves them instead of copying their text
     LogEntry& operator =(const LogEntry& entry);
-    LogEntry& operator =(LogEntry&& entry);
+    LogEntry& operator =(LogEntry&& entry) noexcept;
 
+    LogLevel m_level;
+    LogChannel m_channel;
     const char* m_levelName;
+
+    // returned to the log text pool when the entry is destroyed
     IP::String m_text;
     IP::Time::SystemTimePoint m_time;
+
+    // the thread that created the entry
+    uint32_t m_threadId;
+
+    // set for structured entries, whose message is the site's and whose text is empty
+    LogSite* m_site;
+    IP::Vector<LogField> m_fields;
 };
 
+// appends the entry's text, or for a structured entry its site's message followed by " key=value" for each field
+void AppendLogMessage(IP::String& buffer, const LogEntry& entry);
+
 }
 }
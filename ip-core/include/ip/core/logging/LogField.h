@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+
+#include <ip/core/memory/stl/String.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+enum class LogFieldType : uint8_t
+{
+    Int,
+    UInt,
+    Double,
+    Bool,
+    String
+};
+
+// A typed key/value pair attached to a structured log entry.  Keys are expected to be string literals.
+struct LogField
+{
+    LogField();
+    LogField(const char* key, bool value);
+    LogField(const char* key, const char* value);
+    LogField(const char* key, const IP::String& value);
+    LogField(const char* key, IP::String&& value);
+
+    template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+    LogField(const char* key, T value) :
+        m_key(key),
+        m_type(LogFieldType::Int),
+        m_int(static_cast<int64_t>(value)),
+        m_string()
+    {}
+
+    template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::type = 0>
+    LogField(const char* key, T value) :
+        m_key(key),
+        m_type(LogFieldType::UInt),
+        m_uint(static_cast<uint64_t>(value)),
+        m_string()
+    {}
+
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    LogField(const char* key, T value) :
+        m_key(key),
+        m_type(LogFieldType::Double),
+        m_double(static_cast<double>(value)),
+        m_string()
+    {}
+
+    const char* m_key;
+    LogFieldType m_type;
+
+    union
+    {
+        int64_t m_int;
+        uint64_t m_uint;
+        double m_double;
+        bool m_bool;
+    };
+
+    IP::String m_string;
+};
+
+// appends the field's value as text; strings are appended as-is
+void AppendLogFieldValue(IP::String& buffer, const LogField& field);
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/OutputFile.h>
+#include <ip/core/utils/TimeUtils.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+// A text log file's sidecar index is named after it with LOG_INDEX_FILE_EXTENSION appended.  It starts with
+// LOG_INDEX_MAGIC followed by LogIndexBucket records in host byte order, one per LOG_INDEX_BUCKET_DURATION aligned
+// period that has lines, in file order.  Each bucket is followed by the byte length of each of its entries as a
+// uint32_t, then the level of each as a uint8_t, so readers know which entry every byte belongs to without parsing
+// the text.  Buckets are appended as they close, so after a crash the lines past the last bucket's end offset are
+// simply unindexed.
+
+static const char LOG_INDEX_MAGIC[8] = { 'I', 'P', 'L', 'O', 'G', 'I', 'X', '2' };
+static const char* const LOG_INDEX_FILE_EXTENSION = ".idx";
+static const std::chrono::milliseconds LOG_INDEX_BUCKET_DURATION(1000);
+static const size_t LOG_INDEX_LEVEL_COUNT = static_cast<size_t>(LogLevel::None);
+
+struct LogIndexBucket
+{
+    // entry times, in milliseconds since the epoch; entries queued from several threads can arrive slightly out of order
+    int64_t m_firstTime;
+    int64_t m_lastTime;
+
+    // byte range of the bucket's lines
+    uint64_t m_startOffset;
+    uint64_t m_endOffset;
+
+    // entries per level
+    uint32_t m_levelCounts[LOG_INDEX_LEVEL_COUNT];
+
+    // entries in the bucket, all levels included; they're contiguous from m_startOffset to m_endOffset
+    uint32_t m_entryCount;
+};
+
+// an index as read back, with the entries of every bucket concatenated in file order
+struct LogIndex
+{
+    IP::Vector<LogIndexBucket> m_buckets;
+    IP::Vector<uint32_t> m_entryLengths;
+    IP::Vector<uint8_t> m_entryLevels;
+};
+
+struct LogFileRange
+{
+    uint64_t m_startOffset;
+    uint64_t m_endOffset;
+};
+
+std::experimental::filesystem::path BuildLogIndexFileName(const std::experimental::filesystem::path& logFile);
+
+// Builds the index for one log file as its lines are written
+class LogFileIndexWriter
+{
+    public:
+
+        LogFileIndexWriter();
+        ~LogFileIndexWriter();
+
+        // starts the index for a new, empty log file
+        bool Open(const std::experimental::filesystem::path& logFile);
+
+        // writes the open bucket and closes the index
+        void Close();
+
+        // closes the index without the open bucket, once the log file no longer holds every line it records; the lines
+        // after the last bucket are then read as an unindexed tail
+        void Abandon();
+
+        // records an entry occupying [startOffset, endOffset) of the log file, directly after the previous one
+        void AddLine(IP::Time::SystemTimePoint time, LogLevel level, uint64_t startOffset, uint64_t endOffset);
+
+    private:
+
+        void WriteBucket();
+
+        IP::FileUtils::OutputFile m_indexFile;
+        LogIndexBucket m_bucket;
+        IP::Vector<uint32_t> m_entryLengths;
+        IP::Vector<uint8_t> m_entryLevels;
+        int64_t m_bucketPeriod;
+        bool m_bucketOpen;
+};
+
+// reads every complete bucket and its entries from an index file; throws if the file isn't an index
+LogIndex ReadLogIndex(const std::experimental::filesystem::path& indexFile);
+
+// The byte ranges of the log file holding the entries at or above minimumLevel logged between fromTime and toTime
+// (inclusive, milliseconds since the epoch), in file order with adjacent ranges merged.  Levels are matched exactly
+// per entry; time is resolved to a bucket, which is exact for whole seconds.
+IP::Vector<LogFileRange> FindLogIndexRanges(const LogIndex& index, int64_t fromTime, int64_t toTime, LogLevel minimumLevel);
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ip/core/logging/LogRollPolicy.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/utils/TimeUtils.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+// Shared file layout for the file-based loggers: <directory>/<prefix>_<pid>_<yyyy_mm_dd_hh>[_<sequence>].log (or
+// another extension for non-text sinks), with older files moved into <directory>/archive
+
+// truncates a time point to the start of the log interval (hour) it belongs to
+IP::Time::SystemTimePoint ComputeLogFileInterval(IP::Time::SystemTimePoint timePoint);
+
+std::experimental::filesystem::path BuildLogArchiveDirectoryName(const std::experimental::filesystem::path& directory);
+
+// "<prefix>_<pid>_", the start of every file name this process writes
+IP::String BuildProcessLogFilePrefix(const IP::String& filenamePrefix);
+
+// reads the pid out of a file name with the layout above; false if the name isn't "<prefix>_<pid>_..."
+bool ParseLogFileProcessId(const IP::String& filename, const IP::String& filenamePrefix, uint32_t& processId);
+
+// sequence numbers distinguish files rolled by size within one interval; the first file has none
+std::experimental::filesystem::path BuildLogFileName(const std::experimental::filesystem::path& directory, const IP::String& filenamePrefix, IP::Time::SystemTimePoint logInterval, uint32_t sequence = 0, const char* extension = ".log");
+
+// creates the log and archive directories if necessary; archiving and cleanup of old files is left to LogArchiver
+void InitializeLogDirectories(const std::experimental::filesystem::path& directory);
+
+// Tracks which file a logger is writing and decides, per LogRollPolicy, when it needs a new one
+class LogFileRoller
+{
+    public:
+
+        LogFileRoller(const std::experimental::filesystem::path& directory, const IP::String& filenamePrefix, const LogRollPolicy& policy, const char* extension = ".log");
+
+        // true before the first file, and whenever the policy says the current file is finished
+        bool ShouldRoll(IP::Time::SystemTimePoint currentTime, uint64_t currentFileBytes) const;
+
+        // moves on to the next file and returns its name
+        std::experimental::filesystem::path Roll(IP::Time::SystemTimePoint currentTime);
+
+    private:
+
+        std::experimental::filesystem::path m_directory;
+        IP::String m_filenamePrefix;
+        LogRollPolicy m_policy;
+        const char* m_extension;
+
+        bool m_hasFile;
+        IP::Time::SystemTimePoint m_interval;
+        uint32_t m_sequence;
+};
+
+} // namespace Logging
+} // namespace IP
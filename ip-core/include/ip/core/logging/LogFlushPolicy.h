@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+
+#include <ip/core/logging/LogLevel.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Controls when a buffering logger hands its pending output to the OS and when it forces that output to disk
+struct LogFlushPolicy
+{
+    LogFlushPolicy();
+
+    // flush as soon as this many bytes are pending
+    size_t m_maxBufferedBytes;
+
+    // flush once the oldest pending line has waited this long
+    std::chrono::milliseconds m_maxBufferedTime;
+
+    // lines at or above this level are flushed immediately, along with everything pending ahead of them
+    LogLevel m_immediateFlushLevel;
+
+    // when nonzero, written data is synced to the device at most this often; zero leaves durability to the OS
+    std::chrono::milliseconds m_syncInterval;
+};
+
+} // namespace Logging
+} // namespace IP
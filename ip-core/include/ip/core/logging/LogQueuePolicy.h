@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+
+#include <ip/core/logging/LogLevel.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+enum class LogOverflowPolicy
+{
+    // the entry being logged is discarded
+    DropNewest,
+
+    // the oldest queued entry is discarded to make room
+    DropOldest,
+
+    // the caller waits up to m_blockTimeout for room, then the entry is discarded
+    Block,
+
+    // entries below m_sampleLevel are thinned out once the queue is half full and discarded when it's full; entries at
+    // or above it displace the oldest queued entry
+    SampleByLevel
+};
+
+// Bounds a BackgroundLogger's queue and decides what's lost when producers outrun the background thread.  Fatal entries
+// are never lost: when the queue is full they displace the oldest entry, whatever the overflow policy.
+struct LogQueuePolicy
+{
+    LogQueuePolicy();
+
+    // maximum number of queued entries; zero means unbounded
+    size_t m_capacity;
+
+    LogOverflowPolicy m_overflowPolicy;
+
+    std::chrono::milliseconds m_blockTimeout;
+
+    LogLevel m_sampleLevel;
+
+    // while sampling, one in this many low-level entries is kept; zero is taken as one, keeping them all
+    uint32_t m_sampleInterval;
+
+    // how often dropped entry counts are reported, as a warning through the logger itself
+    std::chrono::milliseconds m_dropReportInterval;
+};
+
+// the policy with out-of-range settings brought into range, as BackgroundLogger applies it
+LogQueuePolicy ClampLogQueuePolicy(const LogQueuePolicy& policy);
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// An entry plus its formatted lines, built once by a CompositeLogger and shared read-only by every sink it fans out
+// to.  Each rendering is keyed by the format signature of the formatter that produced it.
+class LogRecord
+{
+    public:
+
+        LogRecord(LogEntry&& entry);
+        ~LogRecord();
+
+        LogRecord(const LogRecord& rhs) = delete;
+        LogRecord& operator =(const LogRecord& rhs) = delete;
+
+        // only called while the record is being built, before it's shared
+        void AddRendering(const char* formatSignature, IP::String&& line);
+
+        const LogEntry& GetEntry() const { return m_entry; }
+
+        // the line rendered for formatSignature, or nullptr if the sink has to format the entry itself
+        const IP::String* FindRendering(const char* formatSignature) const;
+
+    private:
+
+        struct Rendering
+        {
+            const char* m_formatSignature;
+            IP::String m_line;
+        };
+
+        LogEntry m_entry;
+        IP::Vector<Rendering> m_renderings;
+};
+
+using LogRecordPtr = std::shared_ptr<const LogRecord>;
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Controls when a file logger moves on to a new file; with both limits set, whichever is hit first wins
+struct LogRollPolicy
+{
+    LogRollPolicy();
+
+    // start a new file at the top of every hour
+    bool m_rollHourly;
+
+    // start a new file once the current one reaches this many bytes; zero means no size limit
+    uint64_t m_maxFileBytes;
+};
+
+} // namespace Logging
+} // namespace IP
@@ -15,6 +15,9 @@ class LogScope {
         LogScope(IP::UniquePtr<ILogger> &&logger);
         ~LogScope();
 
+        // installs the new logger while other threads keep logging; the old one is destroyed once no call uses it
+        void Replace(IP::UniquePtr<ILogger> &&logger);
+
     private:
 
         IP::UniquePtr<ILogger> m_logger;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Identifies a structured logging call site.  Each LOG_STRUCTURED expansion owns a static one, so binary sinks can
+// write the site's file, line and message once and refer to it by id afterwards.
+struct LogSite
+{
+    const char* m_file;
+    uint32_t m_line;
+    const char* m_message;
+
+    // assigned on first use; zero until then
+    std::atomic<uint32_t> m_id{0};
+};
+
+// the site's process-wide id, assigning the next free one if it doesn't have one yet; ids start at 1
+uint32_t GetLogSiteId(LogSite& site);
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <ostream>
+
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/String.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Appends everything streamed to it to a pooled IP::String
+class LogStreamBuf : public std::streambuf
+{
+    public:
+
+        LogStreamBuf();
+        virtual ~LogStreamBuf();
+
+        // hands over the text written so far and starts again on a fresh pooled string
+        IP::String TakeText();
+
+        void Clear();
+
+    protected:
+
+        virtual int_type overflow(int_type character) override;
+        virtual std::streamsize xsputn(const char* text, std::streamsize length) override;
+
+    private:
+
+        IP::String m_text;
+};
+
+class LogStream : public std::ostream
+{
+    public:
+
+        LogStream();
+        virtual ~LogStream();
+
+        // clears any text, error state and formatting flags left behind by a previous statement
+        void Reset();
+
+        IP::String TakeText() { return m_buffer.TakeText(); }
+
+    private:
+
+        LogStreamBuf m_buffer;
+};
+
+// Lends a LOG statement its thread's reusable stream, so formatting doesn't construct a stream per statement.  If the
+// thread's stream is already lent out, because something streamed into a LOG statement logs itself, the scope formats
+// into a private stream instead.
+class LogStreamScope
+{
+    public:
+
+        LogStreamScope();
+        ~LogStreamScope();
+
+        LogStreamScope(const LogStreamScope& rhs) = delete;
+        LogStreamScope& operator =(const LogStreamScope& rhs) = delete;
+
+        std::ostream& GetStream() { return *m_stream; }
+        IP::String TakeText() { return m_stream->TakeText(); }
+
+    private:
+
+        IP::UniquePtr<LogStream> m_nestedStream;
+        LogStream* m_stream;
+};
+
+} // namespace Logging
+} // namespace IP
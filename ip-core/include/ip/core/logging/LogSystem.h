@@ -1,10 +1,12 @@
 
 #pragma once
 
+#include <ip/core/logging/LogChannel.h>
+#include <ip/core/logging/FlightRecorder.h>
 #include <ip/core/logging/LogEntry.h>
 #include <ip/core/logging/LogLevel.h>
+#include <ip/core/logging/LogStream.h>
 #include <ip/core/memory/stl/String.h>
-#include <ip/core/memory/stl/StringStream.h>
 #include <ip/core/utils/TimeUtils.h>
 
 namespace IP
@@ -14,14 +16,20 @@ namespace Logging
 
 class ILogger;
 
-// not threadsafe
+// Threadsafe relative to logging calls.  Publishes the new logger (or none) and waits until every Log/Flush call that
+// could still be using the previous logger has returned, so the caller may destroy it as soon as these return.  Must not
+// be called from inside a logger, since the wait would never finish.  Shutdown first reports the repeat counts
+// LOG_DEDUP is still holding.
 void Initialize(ILogger* logger);
 void Shutdown();
+ILogger* SwapLogger(ILogger* logger);
 
-// threadsafe relative to other logging calls, but not Initialize/Shutdown
+// threadsafe and lock-free.  Entries below their channel's level are only given to the flight recorder; Fatal entries
+// flush the logger and dump the flight recorder.
 void Log(LogEntry&& text);
+void Flush();
 
-// threadsafe
+// threadsafe; the level of LogChannel::General, which plain LOG sites check
 LogLevel GetLogLevel();
 void SetLogLevel(LogLevel level);
 
@@ -29,12 +37,36 @@ void SetLogLevel(LogLevel level);
 } // namespace IP
 
 #define LOG(level, streamExpression) \
-    if (IP::Logging::GetLogLevel() <= level) { \
-        IP::StringStream ss; \
-        ss << streamExpression; \
-        IP::Logging::Log(IP::Logging::LogEntry(IP::Logging::GetLogLevelName(level), std::move(ss.str()), IP::Time::GetCurrentSystemTime())); \
+    if (IP::Logging::IsLogChannelEnabled(IP::Logging::LogChannel::General, level) || IP::Logging::IsFlightRecorderCapturing(level)) { \
+        IP::Logging::LogStreamScope logStream; \
+        logStream.GetStream() << streamExpression; \
+        IP::Logging::Log(IP::Logging::LogEntry(level, logStream.TakeText(), IP::Time::GetCurrentSystemTime())); \
     }
     
+// Structured entries carry typed fields (at least one, as IP::Logging::LogField(key, value)) instead of formatted text.
+// Nothing is formatted on the calling thread; binary sinks store the fields as-is and text sinks render them as
+// "<message> key=value ...".  A site must pass the same keys, in the same order, every time.
+#define LOG_STRUCTURED(level, message, ...) \
+    do { \
+        if (IP::Logging::IsLogChannelEnabled(IP::Logging::LogChannel::General, level) || IP::Logging::IsFlightRecorderCapturing(level)) { \
+            static IP::Logging::LogSite logSite = { __FILE__, __LINE__, message }; \
+            IP::Logging::LogEntry entry(level, IP::String(), IP::Time::GetCurrentSystemTime()); \
+            entry.m_site = &logSite; \
+            entry.m_fields = { __VA_ARGS__ }; \
+            IP::Logging::Log(std::move(entry)); \
+        } \
+    } while (0)
+
+// gated by the channel's own level rather than General's
+#define LOG_CH(channel, level, streamExpression) \
+    if (IP::Logging::IsLogChannelEnabled(channel, level) || IP::Logging::IsFlightRecorderCapturing(level)) { \
+        IP::Logging::LogStreamScope logStream; \
+        logStream.GetStream() << streamExpression; \
+        IP::Logging::LogEntry entry(level, logStream.TakeText(), IP::Time::GetCurrentSystemTime()); \
+        entry.m_channel = channel; \
+        IP::Logging::Log(std::move(entry)); \
+    }
+
 #define LOG_TRACE(streamExpression) LOG(IP::Logging::LogLevel::Trace, streamExpression)
 #define LOG_DEBUG(streamExpression) LOG(IP::Logging::LogLevel::Debug, streamExpression)
 #define LOG_INFO(streamExpression) LOG(IP::Logging::LogLevel::Info, streamExpression)
@@ -42,4 +74,9 @@ void SetLogLevel(LogLevel level);
 #define LOG_ERROR(streamExpression) LOG(IP::Logging::LogLevel::Error, streamExpression)
 #define LOG_FATAL(streamExpression) LOG(IP::Logging::LogLevel::Fatal, streamExpression)
 
-
+#define LOG_CH_TRACE(channel, streamExpression) LOG_CH(channel, IP::Logging::LogLevel::Trace, streamExpression)
+#define LOG_CH_DEBUG(channel, streamExpression) LOG_CH(channel, IP::Logging::LogLevel::Debug, streamExpression)
+#define LOG_CH_INFO(channel, streamExpression) LOG_CH(channel, IP::Logging::LogLevel::Info, streamExpression)
+#define LOG_CH_WARN(channel, streamExpression) LOG_CH(channel, IP::Logging::LogLevel::Warn, streamExpression)
+#define LOG_CH_ERROR(channel, streamExpression) LOG_CH(channel, IP::Logging::LogLevel::Error, streamExpression)
+#define LOG_CH_FATAL(channel, streamExpression) LOG_CH(channel, IP::Logging::LogLevel::Fatal, streamExpression)
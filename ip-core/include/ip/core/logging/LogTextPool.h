@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ip/core/memory/stl/String.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Recycles the heap blocks behind log entry text, so a warm thread can format and queue entries without allocating.
+// Each thread caches a few released strings and trades them in batches with a shared depot, which lets text released
+// by a logger's background thread flow back to the threads producing entries.
+
+// an empty string with room for a typical line, carrying the capacity of a previously released one when the pool has any
+IP::String AcquireLogText();
+
+// returns the string's storage to the pool; undersized and oversized strings are simply freed
+void ReleaseLogText(IP::String&& text);
+
+} // namespace Logging
+} // namespace IP
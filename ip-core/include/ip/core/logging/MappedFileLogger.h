@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ip/core/logging/ILogger.h>
+
+#include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/logging/LogArchiver.h>
+#include <ip/core/logging/LogFileUtils.h>
+#include <ip/core/logging/LogRollPolicy.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/utils/MappedFile.h>
+#include <ip/core/utils/TimeUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Rolling file logger (same naming, roll policy and archiving as RollingFileLogger) that preallocates each file and copies
+// lines straight into a mapped window that slides through it.  Lines land in the page cache without a write call, so
+// they survive a process crash.  Each file is truncated to the length actually used when it rolls or the logger is
+// destroyed; until then readers see zero-filled space past the last line.
+class MappedFileLogger : public ILogger
+{
+    public:
+        MappedFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory);
+        MappedFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, size_t windowSize, uint64_t preallocationSize, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy);
+        virtual ~MappedFileLogger();
+
+        virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_formatter.get(); }
+
+    private:
+
+        void WriteEntry(const LogEntry& entry, const IP::String* renderedLine);
+        void RollLogFile(void);
+        void CloseLogFile(void);
+
+        void Append(const char* data, size_t length);
+        bool AdvanceWindow(void);
+
+        IP::UniquePtr<ILogLineFormatter> m_formatter;
+        IP::String m_lineBuffer;
+
+        size_t m_windowSize;
+        uint64_t m_preallocationSize;
+
+        IP::FileUtils::MappedFile m_file;
+        std::experimental::filesystem::path m_fileName;
+        char* m_window;
+        size_t m_windowPosition;
+        uint64_t m_usedLength;
+
+        LogFileRoller m_roller;
+
+        IP::UniquePtr<LogArchiver> m_archiver;
+};
+
+} // namespace Logging
+} // namespace IP
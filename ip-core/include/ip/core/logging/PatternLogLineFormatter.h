@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/TimeUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Formats lines from a pattern such as "%D %T.%e [%l] %t %v".  The pattern is compiled once into a flat list of
+// append operations, with the literal text between fields precomputed, so formatting is a single pass with no parsing.
+//
+//   %T  local time of day, HH:MM:SS          %l  level name
+//   %e  milliseconds, 000-999                %c  channel name
+//   %D  local date, YYYY-MM-DD               %t  id of the thread that logged the entry
+//   %P  process id                           %v  the message, including structured fields
+//   %%  a literal '%'
+class PatternLogLineFormatter : public ILogLineFormatter
+{
+    public:
+
+        // throws on an unknown or unterminated field
+        PatternLogLineFormatter(const char* pattern);
+        virtual ~PatternLogLineFormatter() {}
+
+        virtual void FormatLogLine(IP::String& buffer, const LogEntry& entry) const override;
+        virtual const char* GetFormatSignature() const override { return m_signature.c_str(); }
+        virtual IP::UniquePtr<ILogLineFormatter> Clone() const override;
+
+    private:
+
+        enum class PatternOperationType : uint8_t
+        {
+            Literal,
+            TimeOfDay,
+            Milliseconds,
+            Date,
+            Level,
+            Channel,
+            ThreadId,
+            ProcessId,
+            Message
+        };
+
+        struct PatternOperation
+        {
+            PatternOperationType m_type;
+
+            // for literals, the range of m_literals to append
+            uint32_t m_literalOffset;
+            uint32_t m_literalLength;
+        };
+
+        void CompilePattern(const char* pattern);
+        void AddLiteral(const char* text, size_t length);
+
+        IP::String m_pattern;
+        IP::String m_signature;
+        IP::String m_literals;
+        IP::Vector<PatternOperation> m_operations;
+        IP::String m_processId;
+
+        // like the standard formatter's, this caches the last second formatted; a formatter is owned by a single
+        // logger and shares its (lack of) thread safety
+        mutable IP::Time::CachedTimeOfDayFormatter m_timeFormatter;
+};
+
+} // namespace Logging
+} // namespace IP
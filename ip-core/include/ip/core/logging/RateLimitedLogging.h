@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include <ip/core/logging/LogSystem.h>
+#include <ip/core/memory/stl/String.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Per call site state for the rate limited LOG variants below.  Each macro expansion owns a function-local static of
+// one of these; they're constant initialized and lock-free, so a suppressed call costs a level check and an atomic op.
+
+struct LogEveryNSite
+{
+    std::atomic<uint64_t> m_count{0};
+
+    // n of zero logs every call
+    bool ShouldLog(uint64_t n)
+    {
+        uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed);
+        return n == 0 || count % n == 0;
+    }
+};
+
+struct LogFirstNSite
+{
+    std::atomic<uint64_t> m_count{0};
+
+    bool ShouldLog(uint64_t n)
+    {
+        // the plain load keeps sites that are done with logging from contending on the counter's cache line
+        return m_count.load(std::memory_order_relaxed) < n && m_count.fetch_add(1, std::memory_order_relaxed) < n;
+    }
+};
+
+struct LogEveryMsSite
+{
+    std::atomic<int64_t> m_nextLogTime{0};
+    std::atomic<uint64_t> m_suppressedCount{0};
+
+    // on success suppressedCount is the number of calls swallowed since the last logged one
+    bool ShouldLog(int64_t intervalMs, uint64_t& suppressedCount);
+};
+
+struct LogDedupSite
+{
+    std::atomic<uint64_t> m_lastTextHash{0};
+    std::atomic<uint64_t> m_repeatCount{0};
+    std::atomic<int64_t> m_nextReportTime{0};
+
+    // sites link themselves into a process-wide list on first use so ReportRepeatedMessages can find them
+    std::atomic<bool> m_registered{false};
+    LogLevel m_level{LogLevel::Debug};
+    LogDedupSite* m_nextSite{nullptr};
+
+    // false if text is the same as the last message from this site.  repeatCount is set to the number of unreported
+    // repeats of the previous message when they're due: when a different message arrives, or every few seconds
+    // during a long run of repeats.
+    bool ShouldLog(LogLevel level, const IP::String& text, uint64_t& repeatCount);
+};
+
+// logs the pending repeat counts of every LOG_DEDUP site, so runs that are still going aren't lost; called by Shutdown
+void ReportRepeatedMessages();
+
+} // namespace Logging
+} // namespace IP
+
+#define LOG_EVERY_N(level, n, streamExpression) \
+    do { \
+        static IP::Logging::LogEveryNSite logSite; \
+        if (IP::Logging::IsLogChannelEnabled(IP::Logging::LogChannel::General, level) && logSite.ShouldLog(n)) { \
+            LOG(level, streamExpression); \
+        } \
+    } while (0)
+
+#define LOG_FIRST_N(level, n, streamExpression) \
+    do { \
+        static IP::Logging::LogFirstNSite logSite; \
+        if (IP::Logging::IsLogChannelEnabled(IP::Logging::LogChannel::General, level) && logSite.ShouldLog(n)) { \
+            LOG(level, streamExpression); \
+        } \
+    } while (0)
+
+#define LOG_EVERY_MS(level, intervalMs, streamExpression) \
+    do { \
+        static IP::Logging::LogEveryMsSite logSite; \
+        uint64_t suppressedCount = 0; \
+        if (IP::Logging::IsLogChannelEnabled(IP::Logging::LogChannel::General, level) && logSite.ShouldLog(intervalMs, suppressedCount)) { \
+            if (suppressedCount > 0) { \
+                LOG(level, streamExpression << " (" << suppressedCount << " similar messages suppressed)"); \
+            } else { \
+                LOG(level, streamExpression); \
+            } \
+        } \
+    } while (0)
+
+// collapses identical consecutive messages from one call site; the message still has to be formatted to be compared,
+// but repeats never reach the logger.  The count for a run of repeats is reported when a different message arrives,
+// periodically while the run lasts, and at Shutdown.
+#define LOG_DEDUP(level, streamExpression) \
+    do { \
+        static IP::Logging::LogDedupSite logSite; \
+        if (IP::Logging::IsLogChannelEnabled(IP::Logging::LogChannel::General, level)) { \
+            IP::String text; \
+            { \
+                IP::Logging::LogStreamScope logStream; \
+                logStream.GetStream() << streamExpression; \
+                text = logStream.TakeText(); \
+            } \
+            uint64_t repeatCount = 0; \
+            bool logText = logSite.ShouldLog(level, text, repeatCount); \
+            if (repeatCount > 0) { \
+                LOG(level, "Previous message repeated " << repeatCount << " times"); \
+            } \
+            if (logText) { \
+                IP::Logging::Log(IP::Logging::LogEntry(level, std::move(text), IP::Time::GetCurrentSystemTime())); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_WARN_EVERY_N(n, streamExpression) LOG_EVERY_N(IP::Logging::LogLevel::Warn, n, streamExpression)
+#define LOG_ERROR_EVERY_N(n, streamExpression) LOG_EVERY_N(IP::Logging::LogLevel::Error, n, streamExpression)
+#define LOG_WARN_FIRST_N(n, streamExpression) LOG_FIRST_N(IP::Logging::LogLevel::Warn, n, streamExpression)
+#define LOG_ERROR_FIRST_N(n, streamExpression) LOG_FIRST_N(IP::Logging::LogLevel::Error, n, streamExpression)
+#define LOG_WARN_EVERY_MS(intervalMs, streamExpression) LOG_EVERY_MS(IP::Logging::LogLevel::Warn, intervalMs, streamExpression)
+#define LOG_ERROR_EVERY_MS(intervalMs, streamExpression) LOG_EVERY_MS(IP::Logging::LogLevel::Error, intervalMs, streamExpression)
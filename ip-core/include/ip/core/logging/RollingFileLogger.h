@@ -2,10 +2,14 @@
 
 #include <ip/core/logging/ILogger.h>
 
+#include <ip/core/logging/BufferedLogFile.h>
 #include <ip/core/logging/ILogLineFormatter.h>
-#include <ip/core/memory/stl/Stream.h>
-#include <ip/core/memory/stl/UnorderedMap.h>
-#include <ip/core/utils/TimeUtils.h>
+#include <ip/core/logging/LogArchiver.h>
+#include <ip/core/logging/LogFileIndex.h>
+#include <ip/core/logging/LogFileUtils.h>
+#include <ip/core/logging/LogFlushPolicy.h>
+#include <ip/core/logging/LogRollPolicy.h>
+#include <ip/core/memory/stl/String.h>
 
 #ifdef _WIN32
 #include <filesystem>
@@ -18,28 +22,36 @@ namespace IP
 namespace Logging
 {
 
+// Writes formatted lines to hourly (and optionally size-capped) files, each with a sidecar index of where lines from
+// each second and level sit in the file; see LogFileIndex.h
 class RollingFileLogger : public ILogger
 {
     public:
         RollingFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory);
+        RollingFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy);
+        RollingFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy);
         virtual ~RollingFileLogger();
 
         virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_formatter.get(); }
+        virtual void Flush() override;
+        virtual void Service() override;
 
     private:
 
-        void InitializeAndCleanDirectories();
-
+        void WriteEntry(const LogEntry& entry, const IP::String* renderedLine);
         void RollLogFile(void);
-        std::experimental::filesystem::path BuildLogFileName(IP::Time::SystemTimePoint logInterval) const;
 
         IP::UniquePtr<ILogLineFormatter> m_formatter;
 
-        IP::UniquePtr<IP::OFStream> m_outputStream;
-        IP::Time::SystemTimePoint m_outputLogInterval;
+        BufferedLogFile m_outputFile;
+        std::experimental::filesystem::path m_outputFileName;
+        LogFileIndexWriter m_index;
+
+        LogFileRoller m_roller;
 
-        std::experimental::filesystem::path m_logFileDirectory;
-        IP::String m_filenamePrefix;
+        IP::UniquePtr<LogArchiver> m_archiver;
 };
 
 } // namespace Logging
@@ -17,6 +17,10 @@ class SerializedLogger : public ILogger
         virtual ~SerializedLogger();
 
         virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_logger->GetFormatter(); }
+        virtual void Flush() override;
+        virtual void Service() override;
 
     private:
 
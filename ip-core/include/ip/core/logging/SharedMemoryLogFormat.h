@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/utils/SharedMemory.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// A shared-memory log ring is a SharedMemoryLogHeader followed by m_slotCount slots of m_slotSize bytes, each a
+// SharedMemoryLogSlot with the line's text after it.  The single writer publishes entry n into slot n % m_slotCount:
+// it zeroes the slot's sequence, writes the slot, then stores n + 1, so readers detect torn reads and entries that
+// were overwritten before they got to them without ever blocking the writer.
+
+static const char SHARED_MEMORY_LOG_MAGIC[8] = { 'I', 'P', 'S', 'H', 'M', 'L', 'G', '1' };
+
+struct SharedMemoryLogHeader
+{
+    char m_magic[8];
+    uint32_t m_slotCount;
+    uint32_t m_slotSize;
+
+    // sequence number the next entry will get
+    std::atomic<uint64_t> m_nextSequence;
+
+    // cleared when the writer shuts down
+    std::atomic<uint32_t> m_writerOpen;
+    uint32_t m_writerProcessId;
+};
+
+struct SharedMemoryLogSlot
+{
+    // entry sequence + 1 once the slot holds a complete entry, zero while it's being written
+    std::atomic<uint64_t> m_sequence;
+    int64_t m_time;
+    uint8_t m_level;
+    uint8_t m_channel;
+    uint16_t m_length;
+    uint32_t m_padding;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory log rings need address-free 64 bit atomics");
+
+inline size_t GetSharedMemoryLogSize(uint32_t slotCount, uint32_t slotSize)
+{
+    return sizeof(SharedMemoryLogHeader) + static_cast<size_t>(slotCount) * slotSize;
+}
+
+// Follows a ring published by a SharedMemoryLogger in another process
+class SharedMemoryLogReader
+{
+    public:
+
+        // throws if there's no ring with that name; starts at the oldest entry still in the ring
+        SharedMemoryLogReader(const char* name);
+
+        // skips everything already published
+        void SeekToEnd();
+
+        // copies out the next entry's line, returning false when caught up with the writer.  lostCount is set to the
+        // number of entries overwritten before they could be read.
+        bool ReadNext(IP::String& line, LogLevel& level, uint64_t& lostCount);
+
+        bool IsWriterOpen() const;
+        uint32_t GetWriterProcessId() const;
+
+    private:
+
+        const SharedMemoryLogSlot& GetSlot(uint64_t sequence) const;
+        uint64_t GetOldestSequence() const;
+
+        IP::System::SharedMemory m_memory;
+        const SharedMemoryLogHeader* m_header;
+        uint64_t m_nextSequence;
+};
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ip/core/logging/ILogger.h>
+
+#include <ip/core/logging/ILogLineFormatter.h>
+#include <ip/core/logging/SharedMemoryLogFormat.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/utils/SharedMemory.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// Publishes formatted lines into a named shared-memory ring (see SharedMemoryLogFormat.h) for live viewers on the same
+// host, such as the log-tail tool.  Nothing touches the disk and a slow or absent viewer never holds the writer back;
+// it just loses the entries that were overwritten.  Lines longer than a slot are truncated.
+class SharedMemoryLogger : public ILogger
+{
+    public:
+
+        static const uint32_t DEFAULT_SLOT_COUNT = 16384;
+        static const uint32_t DEFAULT_SLOT_SIZE = 512;
+
+        // throws if the segment can't be created, including when another live logger is using the name
+        SharedMemoryLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* name);
+        SharedMemoryLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* name, uint32_t slotCount, uint32_t slotSize);
+        virtual ~SharedMemoryLogger();
+
+        virtual void Log(LogEntry&& entry) override;
+        virtual void LogShared(const LogRecordPtr& record) override;
+        virtual const ILogLineFormatter* GetFormatter() const override { return m_formatter.get(); }
+
+    private:
+
+        void WriteEntry(const LogEntry& entry, const IP::String* renderedLine);
+
+        IP::UniquePtr<ILogLineFormatter> m_formatter;
+        IP::String m_lineBuffer;
+
+        IP::System::SharedMemory m_memory;
+        SharedMemoryLogHeader* m_header;
+};
+
+} // namespace Logging
+} // namespace IP
@@ -2,6 +2,8 @@
 
 #include <ip/core/logging/ILogLineFormatter.h>
 
+#include <ip/core/utils/TimeUtils.h>
+
 namespace IP
 {
 namespace Logging
@@ -11,9 +13,17 @@ class StandardLogLineFormatter : public ILogLineFormatter
 {
     public:
 
+    StandardLogLineFormatter();
     virtual ~StandardLogLineFormatter() {}
 
-    virtual void FormatLogLine(IP::StringStream& ss, LogEntry&& entry) const override;
+    virtual void FormatLogLine(IP::String& buffer, const LogEntry& entry) const override;
+    virtual const char* GetFormatSignature() const override;
+    virtual IP::UniquePtr<ILogLineFormatter> Clone() const override;
+
+    private:
+
+    // formatters are owned by a single logger and share its (lack of) thread safety
+    mutable IP::Time::CachedTimeOfDayFormatter m_timeOfDayFormatter;
 };
 
 } // namespace Logging
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+static const size_t METRICS_STRIPE_COUNT = 16;
+
+extern std::atomic<uint32_t> g_nextMetricsStripe;
+
+// Threads are dealt stripes round robin, so a few busy threads don't share one
+inline size_t GetMetricsStripe()
+{
+    static thread_local size_t stripe = g_nextMetricsStripe.fetch_add(1, std::memory_order_relaxed) % METRICS_STRIPE_COUNT;
+
+    return stripe;
+}
+
+// A monotonically increasing total.  Increments go to the calling thread's stripe, each on its own cache line, so
+// threads counting the same thing don't contend; reading sums the stripes.
+class Counter
+{
+    public:
+
+        Counter();
+
+        Counter(const Counter& rhs) = delete;
+        Counter& operator =(const Counter& rhs) = delete;
+
+        void Increment(uint64_t amount = 1)
+        {
+            m_stripes[GetMetricsStripe()].m_value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        uint64_t GetValue() const;
+
+    private:
+
+        struct CounterStripe
+        {
+            std::atomic<uint64_t> m_value;
+            char m_padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+
+        CounterStripe m_stripes[METRICS_STRIPE_COUNT];
+};
+
+} // namespace Metrics
+} // namespace IP
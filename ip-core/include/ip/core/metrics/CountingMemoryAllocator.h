@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ip/core/memory/Memory.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+class Counter;
+class MetricsRegistry;
+
+// Passes IP::Malloc and IP::Free through to the C heap, counting allocations, frees and bytes allocated in the
+// registry as ip_memory_allocations_total, ip_memory_frees_total and ip_memory_allocated_bytes_total.  Install it with
+// a ScopedMemoryAllocator; the counters are registered up front so counting never re-enters the registry.
+class CountingMemoryAllocator : public IP::IMemoryAllocator
+{
+    public:
+
+        explicit CountingMemoryAllocator(MetricsRegistry& registry);
+        virtual ~CountingMemoryAllocator() {}
+
+        virtual void* Allocate(const char* tag, size_t memory_size) override;
+        virtual void Free(void* memory) override;
+
+    private:
+
+        Counter& m_allocations;
+        Counter& m_frees;
+        Counter& m_allocatedBytes;
+};
+
+} // namespace Metrics
+} // namespace IP
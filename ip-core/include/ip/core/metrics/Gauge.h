@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+
+namespace IP
+{
+namespace Metrics
+{
+
+// A value that goes up and down, such as a queue depth; the last write wins
+class Gauge
+{
+    public:
+
+        Gauge() :
+            m_value(0.0)
+        {}
+
+        Gauge(const Gauge& rhs) = delete;
+        Gauge& operator =(const Gauge& rhs) = delete;
+
+        void Set(double value) { m_value.store(value, std::memory_order_relaxed); }
+
+        void Add(double amount)
+        {
+            double value = m_value.load(std::memory_order_relaxed);
+            while (!m_value.compare_exchange_weak(value, value + amount, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        double GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+    private:
+
+        std::atomic<double> m_value;
+};
+
+} // namespace Metrics
+} // namespace IP
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <ip/core/memory/stl/Vector.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+// buckets at most 1/64, about 1.6%, as wide as the values in them
+static const uint32_t DEFAULT_HISTOGRAM_PRECISION_BITS = 7;
+
+// The counts of a histogram at one moment, for percentile queries away from the recording threads
+struct HistogramSnapshot
+{
+    uint32_t m_precisionBits;
+    IP::Vector<uint64_t> m_bucketCounts;
+
+    uint64_t m_count;
+    uint64_t m_sum;
+
+    // zero while empty
+    uint64_t m_min;
+    uint64_t m_max;
+};
+
+// Log-linear (HDR) histogram of unsigned integer values, such as durations in nanoseconds.  Values below
+// 2^precisionBits get a bucket each; above that every power of two is split into 2^(precisionBits - 1) equal buckets,
+// so a bucket is never wider than 2^(1 - precisionBits) of the values in it, at any magnitude.  Recording is a few
+// relaxed atomic adds with no locks or allocation.
+class Histogram
+{
+    public:
+
+        explicit Histogram(uint32_t precisionBits = DEFAULT_HISTOGRAM_PRECISION_BITS);
+
+        Histogram(const Histogram& rhs) = delete;
+        Histogram& operator =(const Histogram& rhs) = delete;
+
+        void Record(uint64_t value);
+
+        // not atomic across buckets; values recorded while it's taken may or may not be included
+        HistogramSnapshot GetSnapshot() const;
+
+        uint32_t GetPrecisionBits() const { return m_precisionBits; }
+
+    private:
+
+        uint32_t m_precisionBits;
+
+        IP::Vector<std::atomic<uint64_t>> m_bucketCounts;
+        std::atomic<uint64_t> m_count;
+        std::atomic<uint64_t> m_sum;
+        std::atomic<uint64_t> m_min;
+        std::atomic<uint64_t> m_max;
+};
+
+size_t GetHistogramBucketIndex(uint32_t precisionBits, uint64_t value);
+
+// the smallest and largest values that land in a bucket
+uint64_t GetHistogramBucketLowerBound(uint32_t precisionBits, size_t bucketIndex);
+uint64_t GetHistogramBucketUpperBound(uint32_t precisionBits, size_t bucketIndex);
+
+// The value at or below which the given percentage, 0 to 100, of recorded values lie, accurate to the width of its
+// bucket: the upper bound of the bucket holding that rank, capped at the largest value recorded.  Zero when empty.
+uint64_t GetHistogramPercentile(const HistogramSnapshot& snapshot, double percentile);
+
+double GetHistogramMean(const HistogramSnapshot& snapshot);
+
+} // namespace Metrics
+} // namespace IP
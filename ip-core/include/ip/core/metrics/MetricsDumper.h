@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/String.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Metrics
+{
+
+class MetricsRegistry;
+
+// Rewrites a file with a snapshot of a registry in the Prometheus text format, on its own thread, until destroyed,
+// which writes one last snapshot.  Each snapshot is written under a temporary name and renamed into place, so a
+// scraper, such as node_exporter's textfile collector pointed at a *.prom file, never reads half a snapshot.
+class MetricsDumper
+{
+    public:
+
+        MetricsDumper(MetricsRegistry& registry, const std::experimental::filesystem::path& path, std::chrono::milliseconds interval);
+        ~MetricsDumper();
+
+        MetricsDumper(const MetricsDumper& rhs) = delete;
+        MetricsDumper& operator =(const MetricsDumper& rhs) = delete;
+
+    private:
+
+        void Run();
+        bool Dump();
+
+        MetricsRegistry& m_registry;
+        std::experimental::filesystem::path m_path;
+        std::experimental::filesystem::path m_partialPath;
+        std::chrono::milliseconds m_interval;
+
+        IP::String m_buffer;
+
+        std::mutex m_stopLock;
+        std::condition_variable m_stopSignal;
+        bool m_stopping;
+
+        IP::UniquePtr<std::thread> m_thread;
+};
+
+} // namespace Metrics
+} // namespace IP
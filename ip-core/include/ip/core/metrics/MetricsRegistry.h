@@ -0,0 +1,79 @@
+#pragma once
+
+#include <mutex>
+#include <stdint.h>
+
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/Map.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/metrics/Counter.h>
+#include <ip/core/metrics/Gauge.h>
+#include <ip/core/metrics/Histogram.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+enum class MetricType
+{
+    Counter,
+    Gauge,
+    Histogram
+};
+
+// Named metrics, created on first use and kept for the registry's lifetime, so call sites can look one up once and
+// hold on to the reference:
+//
+//   static IP::Metrics::Counter& resets = IP::Metrics::GetMetricsRegistry().GetCounter("ip_render_swapchain_resets_total", "...");
+//   resets.Increment();
+//
+// Lookups are threadsafe but take a lock; updating a metric doesn't.
+class MetricsRegistry
+{
+    public:
+
+        MetricsRegistry();
+        ~MetricsRegistry();
+
+        MetricsRegistry(const MetricsRegistry& rhs) = delete;
+        MetricsRegistry& operator =(const MetricsRegistry& rhs) = delete;
+
+        // Names follow the Prometheus rules, [a-zA-Z_:][a-zA-Z0-9_:]*, and include their unit.  Throws if the name is
+        // malformed or already belongs to a metric of another type; the help text of the first registration is kept.
+        Counter& GetCounter(const char* name, const char* help);
+        Gauge& GetGauge(const char* name, const char* help);
+        Histogram& GetHistogram(const char* name, const char* help, uint32_t precisionBits = DEFAULT_HISTOGRAM_PRECISION_BITS);
+
+        // Appends every metric in the Prometheus text exposition format, ordered by name.  Histograms are written as
+        // summaries, with 50th, 90th, 99th and 99.9th percentile quantiles, a sum and a count, followed by a _max gauge.
+        void AppendPrometheusText(IP::String& buffer) const;
+
+    private:
+
+        struct Metric
+        {
+            MetricType m_type;
+            IP::String m_help;
+
+            // only the one matching the type is set
+            IP::UniquePtr<Counter> m_counter;
+            IP::UniquePtr<Gauge> m_gauge;
+            IP::UniquePtr<Histogram> m_histogram;
+        };
+
+        // throws if the name is malformed or taken by another type; nullptr if it isn't registered yet
+        Metric* FindMetric(const char* name, MetricType type);
+
+        // the metric object is built before it's added, so a constructor that throws leaves nothing behind
+        Metric& AddMetric(const char* name, const char* help, Metric&& metric);
+
+        mutable std::mutex m_lock;
+        IP::Map<IP::String, Metric> m_metrics;
+};
+
+// the process-wide registry
+MetricsRegistry& GetMetricsRegistry();
+
+} // namespace Metrics
+} // namespace IP
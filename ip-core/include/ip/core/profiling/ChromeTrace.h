@@ -0,0 +1,25 @@
+#pragma once
+
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/profiling/Profiler.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Profiling
+{
+
+// Renders a capture in the Chrome trace event format, which chrome://tracing and ui.perfetto.dev both open: one
+// complete ("X") event per scope, a global instant event per frame mark and a name for each thread.  Times are in
+// microseconds from the earliest timestamp in the capture.
+void AppendChromeTrace(IP::String& buffer, const ProfileCapture& capture);
+
+bool WriteChromeTrace(const ProfileCapture& capture, const std::experimental::filesystem::path& path);
+
+} // namespace Profiling
+} // namespace IP
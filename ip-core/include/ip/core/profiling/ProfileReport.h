@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/profiling/Profiler.h>
+#include <ip/core/utils/TimeUtils.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+// Where a scope's time went, averaged over the frames of a report
+struct ProfileScopeStatistics
+{
+    IP::String m_name;
+
+    double m_callsPerFrame;
+
+    // total includes nested scopes, self excludes them
+    IP::Time::MonotonicDuration m_totalTime;
+    IP::Time::MonotonicDuration m_selfTime;
+
+    // the most total time spent in the scope in any one frame
+    IP::Time::MonotonicDuration m_maxFrameTotalTime;
+};
+
+struct ProfileFrameReport
+{
+    size_t m_frameCount;
+    IP::Time::MonotonicDuration m_averageFrameTime;
+    IP::Time::MonotonicDuration m_maxFrameTime;
+
+    // longest total time first
+    IP::Vector<ProfileScopeStatistics> m_scopes;
+};
+
+// Aggregates the scopes of every complete frame in the capture, i.e. those between consecutive frame marks, on all
+// threads.  A scope counts towards the frame it started in.
+ProfileFrameReport BuildProfileFrameReport(const ProfileCapture& capture);
+
+// appends the report as a text table, one scope per line, times in milliseconds
+void FormatProfileFrameReport(IP::String& buffer, const ProfileFrameReport& report);
+
+} // namespace Profiling
+} // namespace IP
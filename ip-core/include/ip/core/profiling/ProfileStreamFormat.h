@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <ip/core/profiling/Profiler.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+// Profile stream files start with PROFILE_STREAM_MAGIC and are followed by a stream of records, each introduced by a
+// ProfileStreamRecordType byte.  Integers are in host byte order; strings are a uint32 length followed by the bytes.
+//
+//   Calibration: double nanoseconds per timestamp tick
+//   Thread:      uint16 thread index, uint32 thread id, string name
+//   Name:        uint32 name id, string name
+//   Events:      uint32 count, then that many ProfileStreamEvents
+//   Dropped:     uint16 thread index, uint64 events the thread dropped since its last Dropped record
+//
+// The calibration comes first, and a thread or name record always precedes the first event that refers to it.  A
+// thread record is repeated if the thread is renamed.
+
+static const char PROFILE_STREAM_MAGIC[8] = { 'I', 'P', 'P', 'R', 'O', 'F', '0', '1' };
+static const char* const PROFILE_STREAM_FILE_EXTENSION = ".iprof";
+
+enum class ProfileStreamRecordType : uint8_t
+{
+    Calibration = 1,
+    Thread = 2,
+    Name = 3,
+    Events = 4,
+    Dropped = 5
+};
+
+enum class ProfileStreamEventType : uint8_t
+{
+    Begin = 1,
+    End = 2,
+    Frame = 3
+};
+
+// One scope entry or exit, or a frame mark, as written to the file.  An end closes the latest begin at the same depth
+// on its thread; the name id is only meaningful for begins.
+struct ProfileStreamEvent
+{
+    uint64_t m_timestamp;
+    uint32_t m_nameId;
+    uint16_t m_threadIndex;
+    ProfileStreamEventType m_type;
+
+    // clamped to 255
+    uint8_t m_depth;
+};
+
+static_assert(sizeof(ProfileStreamEvent) == 16, "ProfileStreamEvent is written to disk as is");
+
+// Rebuilds a capture from a profile stream file held in memory.  Scopes whose begin or end was dropped, or that were
+// still open when the stream ended, are left out.  Event names point into capture.m_names.  Reading stops at a
+// truncated record, as left behind by a crash; returns false if the data doesn't start with PROFILE_STREAM_MAGIC.
+bool ReadProfileStream(const char* data, size_t length, ProfileCapture& capture);
+
+} // namespace Profiling
+} // namespace IP
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <stddef.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+// Controls the buffering between profiled threads and the thread streaming their events to disk
+struct ProfileStreamPolicy
+{
+    ProfileStreamPolicy();
+
+    // events each thread can have waiting for the writer, rounded up to a power of two; a thread that fills its
+    // buffer drops events, and the drops are recorded in the file
+    size_t m_threadBufferCapacity;
+
+    // how often the writer drains the threads' buffers
+    std::chrono::milliseconds m_flushInterval;
+};
+
+} // namespace Profiling
+} // namespace IP
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <ip/core/memory/stl/Deque.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/profiling/ProfileStreamPolicy.h>
+#include <ip/core/utils/TimeUtils.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace Profiling
+{
+
+// One completed profile scope; times are IP::Time timestamps, see ReadTimestamp
+struct ProfileEvent
+{
+    const char* m_name;
+    uint64_t m_startTimestamp;
+    uint64_t m_endTimestamp;
+
+    // nesting depth on its thread, zero for outermost scopes
+    uint32_t m_depth;
+};
+
+struct ProfileThreadCapture
+{
+    ProfileThreadCapture() :
+        m_threadId(0),
+        m_threadName(),
+        m_events(),
+        m_droppedEvents(0)
+    {}
+
+    uint32_t m_threadId;
+    IP::String m_threadName;
+
+    // in the order the scopes were entered, so a scope's children follow it
+    IP::Vector<ProfileEvent> m_events;
+
+    // events the thread couldn't record because its stream buffer, or its share of an in-memory capture, was full
+    uint64_t m_droppedEvents;
+};
+
+// Everything recorded since StartProfiling, copied out so it can be reported on while recording continues.  Captures
+// read back from a stream file own their event names, so they can be moved but not copied.
+struct ProfileCapture
+{
+    ProfileCapture() :
+        m_threads(),
+        m_frameTimestamps(),
+        m_nanosecondsPerTick(1.0),
+        m_names()
+    {}
+
+    ProfileCapture(ProfileCapture&& rhs) = default;
+    ProfileCapture& operator =(ProfileCapture&& rhs) = default;
+
+    ProfileCapture(const ProfileCapture& rhs) = delete;
+    ProfileCapture& operator =(const ProfileCapture& rhs) = delete;
+
+    IP::Vector<ProfileThreadCapture> m_threads;
+
+    // the timestamp of each MarkProfileFrame call, in order
+    IP::Vector<uint64_t> m_frameTimestamps;
+
+    // the rate the timestamps were recorded at, which for a stream file need not be this machine's
+    double m_nanosecondsPerTick;
+
+    // names of events read from a stream file; elements of a deque don't move as it grows
+    IP::Deque<IP::String> m_names;
+};
+
+// the time between two of the capture's timestamps
+double GetProfileNanoseconds(const ProfileCapture& capture, uint64_t startTimestamp, uint64_t endTimestamp);
+
+// Threadsafe.  Starting discards whatever was captured before; scopes entered while stopped aren't recorded.  An
+// in-memory capture keeps the first million scopes of each thread and counts the rest as dropped, so it suits short
+// sessions; use StartProfileStream for long ones.
+void StartProfiling();
+bool IsProfiling();
+
+// Threadsafe.  Returns false if a stream stopped early because writing to its file failed; the file then holds
+// everything up to the failed write.
+bool StopProfiling();
+
+// Threadsafe.  Streams every scope and frame mark to a ProfileStreamFormat file until StopProfiling, instead of keeping
+// them for CaptureProfile, so captures can run for hours.  Each thread records into its own fixed-size buffer without
+// locks and a background thread drains the buffers to the file.  Returns false if the file can't be created.  If a
+// write fails, say on a full disk, the error is logged and recording stops, so IsProfiling turns false.
+bool StartProfileStream(const std::experimental::filesystem::path& path, const ProfileStreamPolicy& policy = ProfileStreamPolicy());
+
+// marks the start of a frame, for per-frame reports; call it from one thread, once per frame
+void MarkProfileFrame();
+
+// names the calling thread in exported traces
+void SetProfileThreadName(const char* name);
+
+// threadsafe, and may be called while scopes are being recorded; scopes that are still open are left out, and so is
+// everything while streaming
+ProfileCapture CaptureProfile();
+
+struct ProfileEventRecord;
+
+// Records the time spent between construction and destruction, nested inside whatever scope is open on the same
+// thread.  Recording is a timestamp read and a write into the thread's own buffer, without locks, except when the
+// buffer needs another block.  The name must outlive the capture, which string literals do.
+class ProfileScope
+{
+    public:
+
+        explicit ProfileScope(const char* name) :
+            m_record(BeginProfileEvent(name, m_generation, m_streamed))
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (m_record != nullptr)
+            {
+                EndProfileEvent(m_record, m_generation);
+            }
+            else if (m_streamed)
+            {
+                EndStreamedProfileEvent(m_generation);
+            }
+        }
+
+        ProfileScope(const ProfileScope& rhs) = delete;
+        ProfileScope& operator =(const ProfileScope& rhs) = delete;
+
+    private:
+
+        // nullptr when not profiling, when the thread's capture is full, or when streaming, where streamed says whether the begin made it into the buffer
+        static ProfileEventRecord* BeginProfileEvent(const char* name, uint32_t& generation, bool& streamed);
+        static void EndProfileEvent(ProfileEventRecord* record, uint32_t generation);
+        static void EndStreamedProfileEvent(uint32_t generation);
+
+        // the capture the scope was recorded in; a scope left open across a restart isn't written into the new one
+        uint32_t m_generation;
+        bool m_streamed;
+        ProfileEventRecord* m_record;
+};
+
+} // namespace Profiling
+} // namespace IP
+
+// Markers compile to nothing unless IP_ENABLE_PROFILING is defined, which the build does for every debug level but Gold
+#if defined(IP_ENABLE_PROFILING)
+
+#define IP_PROFILE_CONCAT_INNER(a, b) a##b
+#define IP_PROFILE_CONCAT(a, b) IP_PROFILE_CONCAT_INNER(a, b)
+
+#define IP_PROFILE_SCOPE(name) IP::Profiling::ProfileScope IP_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define IP_PROFILE_FUNCTION() IP_PROFILE_SCOPE(__func__)
+#define IP_PROFILE_FRAME() IP::Profiling::MarkProfileFrame()
+
+#else
+
+#define IP_PROFILE_SCOPE(name) do {} while (0)
+#define IP_PROFILE_FUNCTION() do {} while (0)
+#define IP_PROFILE_FRAME() do {} while (0)
+
+#endif
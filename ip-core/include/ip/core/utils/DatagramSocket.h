@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <ip/core/memory/stl/String.h>
+
+namespace IP
+{
+namespace System
+{
+
+struct DatagramBuffer
+{
+    const char* m_data;
+    size_t m_length;
+};
+
+enum class DatagramSendStatus
+{
+    // everything passed in was sent
+    Sent,
+
+    // the receiver's queue is full; the rest can be retried once it drains
+    WouldBlock,
+
+    // the next datagram (sentCount) is larger than the socket will ever send; the ones after it can still go
+    TooLarge,
+
+    // nobody is bound to the address (any more), or the socket failed
+    Disconnected
+};
+
+// A non-blocking local (Unix domain) datagram socket, either connected to a receiver's path or bound to one.  Posix
+// only; on Windows Connect and Bind always fail.
+class DatagramSocket
+{
+    public:
+
+        DatagramSocket();
+        ~DatagramSocket();
+
+        DatagramSocket(const DatagramSocket& rhs) = delete;
+        DatagramSocket& operator =(const DatagramSocket& rhs) = delete;
+
+        // connects to the socket bound at path; fails if there is no receiver
+        bool Connect(const char* path);
+
+        // binds to path, replacing any stale socket file left there; the file is removed again on close
+        bool Bind(const char* path);
+        void Close();
+
+        bool IsOpen() const { return m_handle >= 0; }
+
+        // sends as many datagrams as the receiver will take without blocking, in as few system calls as the platform
+        // allows; sentCount says how many went
+        DatagramSendStatus Send(const DatagramBuffer* datagrams, size_t count, size_t& sentCount);
+
+        // waits up to timeout for the receiver to have room again
+        bool WaitUntilWritable(std::chrono::milliseconds timeout);
+
+        // waits up to timeout for a datagram and replaces datagram's contents with it
+        bool Receive(IP::String& datagram, std::chrono::milliseconds timeout);
+
+    private:
+
+        intptr_t m_handle;
+        IP::String m_boundPath;
+};
+
+} // namespace System
+} // namespace IP
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace FileUtils
+{
+
+enum class MappedFileMode
+{
+    ReadOnly,
+    ReadWrite
+};
+
+// A file with at most one memory-mapped view at a time.  Views are shared with the OS page cache, so writes through a
+// read-write view are visible to other readers (and survive a process crash) without any further system calls.
+class MappedFile
+{
+    public:
+
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile& rhs) = delete;
+        MappedFile& operator =(const MappedFile& rhs) = delete;
+
+        // ReadWrite creates the file, truncating it if it already exists; ReadOnly requires an existing file
+        bool Open(const std::experimental::filesystem::path& path, MappedFileMode mode);
+        void Close();
+
+        bool IsOpen() const;
+        uint64_t GetSize() const;
+
+        // sets the file length; on Linux growth is backed by allocated blocks and fails if they can't be allocated,
+        // elsewhere the file grows sparsely.  Unmaps any view.
+        bool Resize(uint64_t size);
+
+        // maps [offset, offset + length) replacing any previous view; offset must be a multiple of GetMappingGranularity()
+        char* Map(uint64_t offset, size_t length);
+        void Unmap();
+
+        static size_t GetMappingGranularity();
+
+    private:
+
+        intptr_t m_handle;
+        MappedFileMode m_mode;
+        uint64_t m_size;
+
+        void* m_view;
+        size_t m_viewLength;
+};
+
+} // namespace FileUtils
+} // namespace IP
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace IP
+{
+namespace FileUtils
+{
+
+// Thin unbuffered wrapper around a native file handle; callers are expected to do their own buffering
+class OutputFile
+{
+    public:
+
+        OutputFile();
+        ~OutputFile();
+
+        OutputFile(const OutputFile& rhs) = delete;
+        OutputFile& operator =(const OutputFile& rhs) = delete;
+
+        // creates the file, truncating it if it already exists
+        bool Open(const std::experimental::filesystem::path& path);
+
+        // creates the file if necessary and appends to it; makes no allocations, so it's safe in a signal handler
+        bool OpenForAppend(const char* path);
+        void Close();
+
+        bool IsOpen() const;
+
+        // writes the entire range, retrying partial writes; on failure writtenLength says how much got out first
+        bool Write(const void* data, size_t length, size_t* writtenLength = nullptr);
+
+        // blocks until written data (but not necessarily metadata) has reached the device
+        bool SyncData();
+
+    private:
+
+        intptr_t m_handle;
+};
+
+} // namespace FileUtils
+} // namespace IP
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <ip/core/memory/stl/String.h>
+
+namespace IP
+{
+namespace System
+{
+
+// A named block of memory shared between processes on the same host.  The creating process owns the name: it replaces
+// any segment left behind under that name by a crashed process and removes the name again when closed, while processes
+// that opened it keep their mapping until they close it themselves.
+class SharedMemory
+{
+    public:
+
+        SharedMemory();
+        ~SharedMemory();
+
+        SharedMemory(const SharedMemory& rhs) = delete;
+        SharedMemory& operator =(const SharedMemory& rhs) = delete;
+
+        // creates and maps a zero-filled, writable segment; fails if another creator still has a segment of this name
+        // open, and replaces one left behind by a creator that exited
+        bool Create(const char* name, size_t size);
+
+        // maps an existing segment read-only
+        bool Open(const char* name);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        char* GetData() const { return static_cast<char*>(m_data); }
+        size_t GetSize() const { return m_size; }
+
+    private:
+
+        intptr_t m_handle;
+        IP::String m_name;
+        bool m_isOwner;
+
+        void* m_data;
+        size_t m_size;
+};
+
+} // namespace System
+} // namespace IP
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+struct OutputBuffer
+{
+    const void* m_data;
+    size_t m_length;
+};
+
+// whether the process's standard output is an interactive terminal rather than a file or pipe
+bool IsStandardOutputTerminal();
+
+// Writes the buffers to standard output in order, bypassing std::cout and its buffering, with as few system calls
+// as the platform allows.  Returns false if the output could not be written.
+bool WriteStandardOutput(const OutputBuffer* buffers, size_t count);
+
+} // namespace FileUtils
+} // namespace IP
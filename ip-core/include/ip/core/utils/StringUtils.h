@@ -31,6 +31,9 @@ namespace StringUtils
 
     IP::String ToString(const IP::Vector<IP::String>& items, const char *separator);
 
+    // Appends the base-10 representation of value, left-padded with zeros to at least width digits
+    void AppendZeroPaddedInteger(IP::String& buffer, uint64_t value, uint32_t width);
+
 } // namespace StringUtils
 } // namespace IP
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 #include <ip/core/memory/stl/String.h>
 
 namespace IP
@@ -10,5 +12,21 @@ namespace System
 IP::String GetProcessId();
 IP::String AppendProcessId(const IP::String& value);
 
+// true if a process with the id exists, including one this process isn't allowed to signal or open
+bool IsProcessRunning(uint32_t processId);
+
+// the OS id of the calling thread, as shown by debuggers and profilers; cached per thread
+uint32_t GetCurrentThreadId();
+
+// drops the calling thread's CPU (and, where supported, I/O) scheduling priority for background maintenance work
+void LowerCurrentThreadPriority();
+
+// called with a short description of what went wrong; must restrict itself to async-signal-safe work
+using FatalErrorHandler = void (*)(const char* description);
+
+// runs handler when the process crashes (fatal signals on posix, unhandled SEH exceptions on Windows) before the
+// default crash handling continues
+void InstallFatalErrorHandler(FatalErrorHandler handler);
+
 }
 }
\ No newline at end of file
@@ -1,6 +1,16 @@
 #pragma once
 
 #include <chrono>
+#include <ctime>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define IP_HAS_TIMESTAMP_COUNTER
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define IP_HAS_TIMESTAMP_COUNTER
+#endif
 
 #include <ip/core/memory/stl/String.h>
 
@@ -9,18 +19,124 @@ namespace IP
 namespace Time
 {
 
+// Wall clock time, for stamping and naming things; it jumps whenever the clock is adjusted, so measure durations with
+// the monotonic clock instead
 using SystemTimePoint = std::chrono::system_clock::time_point;
 using SystemDuration = std::chrono::system_clock::duration;
 
+// Never goes backwards and is unaffected by clock adjustments, but has no meaning as a time of day
+using MonotonicClock = std::chrono::steady_clock;
+using MonotonicTimePoint = MonotonicClock::time_point;
+using MonotonicDuration = MonotonicClock::duration;
+
 SystemTimePoint GetCurrentSystemTime(void);
+
+// time since the system clock's epoch
 SystemDuration GetElapsedSystemTime(void);
 bool GetFileLastModifiedTime(const IP::String &fileName, SystemTimePoint& lastModifiedTime);
 
-double ConvertDurationToSeconds(SystemDuration duration);
+MonotonicTimePoint GetCurrentMonotonicTime(void);
+
+// time since the process started, or at least since ip-core's statics were initialized
+MonotonicDuration GetElapsedMonotonicTime(void);
+
+template<typename Rep, typename Period>
+double ConvertDurationToSeconds(std::chrono::duration<Rep, Period> duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+template<typename Rep, typename Period>
+double ConvertDurationToMilliseconds(std::chrono::duration<Rep, Period> duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+template<typename Rep, typename Period>
+int64_t ConvertDurationToNanoseconds(std::chrono::duration<Rep, Period> duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+// whole or fractional nanoseconds
+template<typename Rep>
+MonotonicDuration ConvertNanosecondsToDuration(Rep nanoseconds)
+{
+    return std::chrono::duration_cast<MonotonicDuration>(std::chrono::duration<Rep, std::nano>(nanoseconds));
+}
+
+// Timestamps are the cheapest monotonic reading available, for timing short spans on hot paths such as profiling
+// scopes.  Where the CPU has an invariant time-stamp counter they're raw counter ticks, calibrated against the
+// monotonic clock the first time they're used; otherwise they're monotonic clock nanoseconds.  Compare and subtract
+// them freely, but convert them before treating them as time.
+struct TimestampCalibration
+{
+    bool m_usesCounter;
+    double m_nanosecondsPerTick;
+
+    // a timestamp and the monotonic time it was read at, anchoring conversions
+    uint64_t m_baseTimestamp;
+    MonotonicTimePoint m_baseTime;
+};
+
+const TimestampCalibration& GetTimestampCalibration(void);
+
+inline uint64_t ReadTimestamp(void)
+{
+#if defined(IP_HAS_TIMESTAMP_COUNTER)
+    static const bool usesCounter = GetTimestampCalibration().m_usesCounter;
+    if (usesCounter)
+    {
+        return __rdtsc();
+    }
+#endif
+
+    return static_cast<uint64_t>(ConvertDurationToNanoseconds(GetCurrentMonotonicTime().time_since_epoch()));
+}
+
+MonotonicDuration ConvertTimestampsToDuration(uint64_t startTimestamp, uint64_t endTimestamp);
+
+// for timestamps recorded under a calibration other than this process's, such as a loaded profile capture's
+double ConvertTimestampsToNanoseconds(uint64_t startTimestamp, uint64_t endTimestamp, double nanosecondsPerTick);
+MonotonicTimePoint ConvertTimestampToMonotonicTime(uint64_t timestamp);
 
 IP::String FormatSystemTime(SystemTimePoint timePoint);
 IP::String FormatTimeOfDay(SystemTimePoint timePoint);
 IP::String ConvertSystemTimeToFileSuffix(SystemTimePoint timePoint);
 
+// Appends the same HH:MM:SS.mmm text as FormatTimeOfDay without going through a stream, along with its parts and the
+// date for formatters that lay them out themselves.  The local time of day and date are cached per second so
+// consecutive calls within the same second only format the milliseconds.  Not threadsafe.
+class CachedTimeOfDayFormatter
+{
+    public:
+
+        CachedTimeOfDayFormatter();
+
+        // HH:MM:SS.mmm
+        void AppendTimeOfDay(IP::String& buffer, SystemTimePoint timePoint);
+
+        // HH:MM:SS
+        void AppendClockTime(IP::String& buffer, SystemTimePoint timePoint);
+
+        // YYYY-MM-DD
+        void AppendDate(IP::String& buffer, SystemTimePoint timePoint);
+
+        // 000-999
+        static void AppendMilliseconds(IP::String& buffer, SystemTimePoint timePoint);
+
+    private:
+
+        static const size_t PREFIX_LENGTH = 9; // "HH:MM:SS."
+        static const size_t DATE_LENGTH = 10; // "YYYY-MM-DD"
+
+        void UpdateCache(SystemTimePoint timePoint);
+
+        std::time_t m_cachedSecond;
+        bool m_cacheValid;
+        char m_cachedPrefix[PREFIX_LENGTH];
+        char m_cachedDate[DATE_LENGTH];
+};
+
 } // namespace Time
 } // namespace IP
@@ -1,29 +1,112 @@
 #include <ip/core/logging/BackgroundLogger.h>
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <stdio.h>
 
 #include <ip/core/logging/LogEntry.h>
 #include <ip/core/memory/stl/Vector.h>
+#include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/metrics/MetricsRegistry.h>
 
 namespace IP
 {
 namespace Logging
 {
 
+// how long the background thread sleeps without new entries before servicing its logger's time-based policies
+static const std::chrono::milliseconds SERVICE_INTERVAL(100);
+
+static const size_t LOG_LEVEL_COUNT = static_cast<size_t>(LogLevel::None);
+
+// The queue is a pair of vectors swapped between the producers and the background thread, so once both have grown to
+// a typical batch queuing an entry doesn't allocate.
+static const size_t INITIAL_QUEUE_RESERVE = 256;
+
+// Each background logger reports its queue depth under its own gauge, ip_log_queue_depth_<slot>.  A destroyed logger's
+// slot goes to the next one created, so swapping loggers doesn't keep adding gauges.
+class QueueDepthSlots
+{
+    public:
+
+        QueueDepthSlots() :
+            m_lock(),
+            m_slotsInUse()
+        {
+        }
+
+        size_t Acquire()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            auto found = std::find(m_slotsInUse.begin(), m_slotsInUse.end(), false);
+            if (found != m_slotsInUse.end())
+            {
+                *found = true;
+                return static_cast<size_t>(found - m_slotsInUse.begin());
+            }
+
+            m_slotsInUse.push_back(true);
+            return m_slotsInUse.size() - 1;
+        }
+
+        void Release(size_t slot)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_slotsInUse[slot] = false;
+        }
+
+    private:
+
+        std::mutex m_lock;
+        IP::Vector<bool> m_slotsInUse;
+};
+
+static QueueDepthSlots& GetQueueDepthSlots()
+{
+    static QueueDepthSlots slots;
+
+    return slots;
+}
+
+static IP::Metrics::Gauge& GetQueueDepthGauge(size_t slot)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "ip_log_queue_depth_%zu", slot);
+
+    return IP::Metrics::GetMetricsRegistry().GetGauge(name, "Entries waiting for one background logger's thread");
+}
+
 struct BackgroundLoggerThreadData 
 {
     public:
 
-        BackgroundLoggerThreadData(IP::UniquePtr<ILogger>&& logger) :
+        BackgroundLoggerThreadData(IP::UniquePtr<ILogger>&& logger, const LogQueuePolicy& queuePolicy) :
             m_queueLock(),
             m_entries(),
+            m_firstEntry(0),
             m_queueSignal(),
+            m_spaceSignal(),
             m_shutdown(false),
-            m_backgroundLogger(std::move(logger))
-        {}
+            m_flushRequested(false),
+            m_queuePolicy(ClampLogQueuePolicy(queuePolicy)),
+            m_sampleCounter(0),
+            m_droppedEntries(),
+            m_backgroundLogger(std::move(logger)),
+            m_queuedMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_log_entries_queued_total", "Entries queued for background loggers")),
+            m_droppedMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_log_entries_dropped_total", "Entries background loggers dropped under their queue policy")),
+            m_queueDepthSlot(GetQueueDepthSlots().Acquire()),
+            m_queueDepthMetric(GetQueueDepthGauge(m_queueDepthSlot))
+        {
+            m_entries.reserve(INITIAL_QUEUE_RESERVE);
+        }
 
-        ~BackgroundLoggerThreadData() {}
+        ~BackgroundLoggerThreadData()
+        {
+            m_queueDepthMetric.Set(0.0);
+            GetQueueDepthSlots().Release(m_queueDepthSlot);
+        }
 
         BackgroundLoggerThreadData(const BackgroundLoggerThreadData& rhs) = delete;
         BackgroundLoggerThreadData(BackgroundLoggerThreadData&& rhs) = delete;
@@ -32,44 +115,217 @@ struct BackgroundLoggerThreadData
 
         std::mutex m_queueLock;
         IP::Vector<LogEntry> m_entries;
+        size_t m_firstEntry; // entries before this one were dropped from the front of the queue
         std::condition_variable m_queueSignal;
+        std::condition_variable m_spaceSignal;
         std::atomic<bool> m_shutdown;
+        bool m_flushRequested;
+
+        const LogQueuePolicy m_queuePolicy;
+        uint32_t m_sampleCounter;
+        uint64_t m_droppedEntries[LOG_LEVEL_COUNT];
+
         IP::UniquePtr<ILogger> m_backgroundLogger;
+
+        // shared by every background logger in the process
+        IP::Metrics::Counter& m_queuedMetric;
+        IP::Metrics::Counter& m_droppedMetric;
+
+        // this logger's own
+        size_t m_queueDepthSlot;
+        IP::Metrics::Gauge& m_queueDepthMetric;
 };
 
+static size_t GetQueuedEntryCount(const BackgroundLoggerThreadData& data)
+{
+    return data.m_entries.size() - data.m_firstEntry;
+}
+
+// called with the queue lock held
+static void DropOldestEntry(BackgroundLoggerThreadData& data)
+{
+    LogEntry& oldest = data.m_entries[data.m_firstEntry++];
+    ++data.m_droppedEntries[static_cast<size_t>(oldest.m_level)];
+    data.m_droppedMetric.Increment();
+    oldest = LogEntry();
+
+    // compact once the dropped prefix is half the queue, which keeps dropping amortized constant time
+    if (data.m_firstEntry * 2 >= data.m_entries.size())
+    {
+        data.m_entries.erase(data.m_entries.begin(), data.m_entries.begin() + data.m_firstEntry);
+        data.m_firstEntry = 0;
+    }
+}
+
+// called with the queue lock held; returns false if the entry has to be dropped
+static bool MakeRoomForEntry(BackgroundLoggerThreadData& data, std::unique_lock<std::mutex>& lock, const LogEntry& entry)
+{
+    const LogQueuePolicy& policy = data.m_queuePolicy;
+    if (policy.m_capacity == 0)
+    {
+        return true;
+    }
+
+    // a fatal entry is likely the last thing the process says; it's never sampled, blocked or dropped
+    if (entry.m_level >= LogLevel::Fatal)
+    {
+        if (GetQueuedEntryCount(data) >= policy.m_capacity)
+        {
+            DropOldestEntry(data);
+        }
+
+        return true;
+    }
+
+    if (policy.m_overflowPolicy == LogOverflowPolicy::SampleByLevel && entry.m_level < policy.m_sampleLevel && GetQueuedEntryCount(data) >= policy.m_capacity / 2)
+    {
+        if (data.m_sampleCounter++ % policy.m_sampleInterval != 0)
+        {
+            return false;
+        }
+    }
+
+    if (GetQueuedEntryCount(data) < policy.m_capacity)
+    {
+        return true;
+    }
+
+    switch (policy.m_overflowPolicy)
+    {
+        case LogOverflowPolicy::DropOldest:
+            DropOldestEntry(data);
+            return true;
+
+        case LogOverflowPolicy::Block:
+            return data.m_spaceSignal.wait_for(lock, policy.m_blockTimeout, [&](){ return GetQueuedEntryCount(data) < policy.m_capacity || data.m_shutdown; });
+
+        case LogOverflowPolicy::SampleByLevel:
+            if (entry.m_level < policy.m_sampleLevel)
+            {
+                return false;
+            }
+
+            DropOldestEntry(data);
+            return true;
+
+        case LogOverflowPolicy::DropNewest:
+        default:
+            return false;
+    }
+}
+
+static void ReportDroppedEntries(ILogger& logger, const uint64_t (&droppedEntries)[LOG_LEVEL_COUNT])
+{
+    uint64_t totalDropped = 0;
+    for (size_t level = 0; level < LOG_LEVEL_COUNT; ++level)
+    {
+        totalDropped += droppedEntries[level];
+    }
+
+    if (totalDropped == 0)
+    {
+        return;
+    }
+
+    IP::OStringStream message;
+    message << "Log queue overflow: dropped " << totalDropped << " entries (";
+
+    const char* separator = "";
+    for (size_t level = 0; level < LOG_LEVEL_COUNT; ++level)
+    {
+        if (droppedEntries[level] > 0)
+        {
+            message << separator << GetLogLevelName(static_cast<LogLevel>(level)) << "=" << droppedEntries[level];
+            separator = ", ";
+        }
+    }
+
+    message << ")";
+
+    logger.Log(LogEntry(LogLevel::Warn, message.str(), IP::Time::GetCurrentSystemTime()));
+}
+
 static void BackgroundThreadFunction(const std::shared_ptr<BackgroundLoggerThreadData>& data)
 {
     std::shared_ptr<BackgroundLoggerThreadData> threadData = data;
     bool done = false;
 
     IP::Vector<LogEntry> entries;
+    entries.reserve(INITIAL_QUEUE_RESERVE);
+    size_t firstEntry = 0;
+    size_t peakQueueCapacity = INITIAL_QUEUE_RESERVE;
+    IP::Time::SystemTimePoint lastDropReportTime = IP::Time::GetCurrentSystemTime();
 
     while (!done)
     {
+        bool flush = false;
+        bool reportDrops = false;
+        uint64_t droppedEntries[LOG_LEVEL_COUNT] = {};
         entries.clear();
 
         {
             std::unique_lock<std::mutex> lock(threadData->m_queueLock);
-            threadData->m_queueSignal.wait(lock, [&](){return !threadData->m_entries.empty() || threadData->m_shutdown;});
+            threadData->m_queueSignal.wait_for(lock, SERVICE_INTERVAL, [&](){return !threadData->m_entries.empty() || threadData->m_shutdown || threadData->m_flushRequested;});
 
-            entries = std::move(threadData->m_entries);
+            entries.swap(threadData->m_entries);
+            peakQueueCapacity = std::max(peakQueueCapacity, entries.capacity());
+            firstEntry = threadData->m_firstEntry;
+            threadData->m_firstEntry = 0;
+            threadData->m_queueDepthMetric.Set(0.0);
             done = threadData->m_shutdown;
+            flush = threadData->m_flushRequested;
+            threadData->m_flushRequested = false;
+
+            auto currentTime = IP::Time::GetCurrentSystemTime();
+            if (done || currentTime - lastDropReportTime >= threadData->m_queuePolicy.m_dropReportInterval)
+            {
+                std::copy(std::begin(threadData->m_droppedEntries), std::end(threadData->m_droppedEntries), std::begin(droppedEntries));
+                std::fill(std::begin(threadData->m_droppedEntries), std::end(threadData->m_droppedEntries), 0);
+                lastDropReportTime = currentTime;
+                reportDrops = true;
+            }
         }
 
-        for (auto& entry : entries)
+        threadData->m_spaceSignal.notify_all();
+
+        for (size_t i = firstEntry; i < entries.size(); ++i)
         {
-            threadData->m_backgroundLogger->Log(std::move(entry));
+            threadData->m_backgroundLogger->Log(std::move(entries[i]));
+        }
+
+        if (reportDrops)
+        {
+            ReportDroppedEntries(*threadData->m_backgroundLogger, droppedEntries);
+        }
+
+        if (done || flush)
+        {
+            threadData->m_backgroundLogger->Flush();
+        }
+        else
+        {
+            threadData->m_backgroundLogger->Service();
         }
 
         if (done)
         {
             threadData->m_backgroundLogger = nullptr;
         }
+
+        // the two queues trade places every batch; growing this one to match the other here, on the background thread,
+        // means producers only pay for queue growth when the backlog reaches a new high
+        entries.clear();
+        entries.reserve(peakQueueCapacity);
     }
 }
 
 BackgroundLogger::BackgroundLogger(const LoggerFactory& factory) :
-    m_threadData(IP::MakeShared<BackgroundLoggerThreadData>(MEMORY_TAG, std::move(factory()))),
+    BackgroundLogger(factory, LogQueuePolicy())
+{
+}
+
+BackgroundLogger::BackgroundLogger(const LoggerFactory& factory, const LogQueuePolicy& queuePolicy) :
+    m_threadData(IP::MakeShared<BackgroundLoggerThreadData>(MEMORY_TAG, std::move(factory()), queuePolicy)),
     m_backgroundThread(IP::MakeUnique<std::thread>(MEMORY_TAG, BackgroundThreadFunction, m_threadData))
 {
 }
@@ -78,8 +334,13 @@ BackgroundLogger::~BackgroundLogger()
 {
     if (m_threadData)
     {
-        m_threadData->m_shutdown = true;
+        {
+            std::unique_lock<std::mutex> queueLock(m_threadData->m_queueLock);
+            m_threadData->m_shutdown = true;
+        }
+
         m_threadData->m_queueSignal.notify_one();
+        m_threadData->m_spaceSignal.notify_all();
         m_threadData = nullptr;
     }
 
@@ -95,7 +356,29 @@ void BackgroundLogger::Log(LogEntry&& entry)
     {
         {
             std::unique_lock<std::mutex> queueLock(m_threadData->m_queueLock);
+            if (!MakeRoomForEntry(*m_threadData, queueLock, entry))
+            {
+                ++m_threadData->m_droppedEntries[static_cast<size_t>(entry.m_level)];
+                m_threadData->m_droppedMetric.Increment();
+                return;
+            }
+
             m_threadData->m_entries.push_back(std::move(entry));
+            m_threadData->m_queuedMetric.Increment();
+            m_threadData->m_queueDepthMetric.Set(static_cast<double>(GetQueuedEntryCount(*m_threadData)));
+        }
+
+        m_threadData->m_queueSignal.notify_one();
+    }
+}
+
+void BackgroundLogger::Flush()
+{
+    if (m_threadData)
+    {
+        {
+            std::unique_lock<std::mutex> queueLock(m_threadData->m_queueLock);
+            m_threadData->m_flushRequested = true;
         }
 
         m_threadData->m_queueSignal.notify_one();
@@ -0,0 +1,179 @@
+#include <ip/core/logging/BinaryFileLogger.h>
+
+#include <ip/core/logging/BinaryLogFormat.h>
+#include <ip/core/logging/LogEntry.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+template<typename T>
+static void AppendValue(IP::String& buffer, T value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void AppendString(IP::String& buffer, const char* value, size_t length)
+{
+    AppendValue(buffer, static_cast<uint32_t>(length));
+    buffer.append(value, length);
+}
+
+BinaryFileLogger::BinaryFileLogger(IP::String filenamePrefix, const std::experimental::filesystem::path& directory) :
+    BinaryFileLogger(filenamePrefix, directory, LogFlushPolicy(), LogRollPolicy(), LogArchivePolicy())
+{
+}
+
+BinaryFileLogger::BinaryFileLogger(IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy) :
+    m_outputFile(flushPolicy),
+    m_outputFileName(),
+    m_definedSites(),
+    m_roller(directory, filenamePrefix, rollPolicy, BINARY_LOG_FILE_EXTENSION),
+    m_archiver(nullptr)
+{
+    InitializeLogDirectories(directory);
+
+    m_archiver = IP::MakeUnique<LogArchiver>(MEMORY_TAG, directory, filenamePrefix, archivePolicy);
+}
+
+BinaryFileLogger::~BinaryFileLogger()
+{
+    m_outputFile.Close();
+}
+
+void BinaryFileLogger::Log(LogEntry&& entry)
+{
+    RollLogFile();
+
+    // the lost output may have held site definitions, so every site is defined again
+    IP::String lossReport;
+    if (m_outputFile.TakeLossReport(lossReport))
+    {
+        m_definedSites.clear();
+        Log(LogEntry(LogLevel::Warn, std::move(lossReport), entry.m_time));
+    }
+
+    IP::String& output = m_outputFile.BeginEntry();
+
+    uint32_t siteId = 0;
+    if (entry.m_site != nullptr)
+    {
+        siteId = GetLogSiteId(*entry.m_site);
+
+        auto definedSite = m_definedSites.find(siteId);
+        if (definedSite == m_definedSites.end() || definedSite->second != entry.m_fields.size())
+        {
+            EncodeSite(output, *entry.m_site, siteId, entry);
+            m_definedSites[siteId] = entry.m_fields.size();
+        }
+    }
+
+    EncodeEntry(output, entry, siteId);
+
+    m_outputFile.EndEntry(entry.m_level);
+}
+
+void BinaryFileLogger::Flush()
+{
+    m_outputFile.Flush();
+}
+
+void BinaryFileLogger::Service()
+{
+    m_outputFile.Service();
+}
+
+void BinaryFileLogger::EncodeSite(IP::String& output, LogSite& site, uint32_t siteId, const LogEntry& entry)
+{
+    size_t keyCount = std::min<size_t>(entry.m_fields.size(), UINT8_MAX);
+
+    AppendValue(output, static_cast<uint8_t>(BinaryLogRecordType::Site));
+    AppendValue(output, siteId);
+    AppendValue(output, site.m_line);
+    AppendString(output, site.m_file, strlen(site.m_file));
+    AppendString(output, site.m_message, strlen(site.m_message));
+    AppendValue(output, static_cast<uint8_t>(keyCount));
+
+    for (size_t i = 0; i < keyCount; ++i)
+    {
+        AppendString(output, entry.m_fields[i].m_key, strlen(entry.m_fields[i].m_key));
+    }
+}
+
+void BinaryFileLogger::EncodeEntry(IP::String& output, const LogEntry& entry, uint32_t siteId)
+{
+    int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.m_time.time_since_epoch()).count();
+
+    AppendValue(output, static_cast<uint8_t>(BinaryLogRecordType::Entry));
+    AppendValue(output, time);
+    AppendValue(output, static_cast<uint8_t>(entry.m_level));
+    AppendValue(output, static_cast<uint8_t>(entry.m_channel));
+    AppendValue(output, siteId);
+
+    if (siteId == 0)
+    {
+        AppendString(output, entry.m_text.data(), entry.m_text.size());
+        return;
+    }
+
+    size_t fieldCount = std::min<size_t>(entry.m_fields.size(), UINT8_MAX);
+    AppendValue(output, static_cast<uint8_t>(fieldCount));
+
+    for (size_t i = 0; i < fieldCount; ++i)
+    {
+        const LogField& field = entry.m_fields[i];
+        AppendValue(output, static_cast<uint8_t>(field.m_type));
+
+        switch (field.m_type)
+        {
+            case LogFieldType::Int:
+                AppendValue(output, field.m_int);
+                break;
+
+            case LogFieldType::UInt:
+                AppendValue(output, field.m_uint);
+                break;
+
+            case LogFieldType::Double:
+                AppendValue(output, field.m_double);
+                break;
+
+            case LogFieldType::Bool:
+                AppendValue(output, static_cast<uint8_t>(field.m_bool ? 1 : 0));
+                break;
+
+            case LogFieldType::String:
+                AppendString(output, field.m_string.data(), field.m_string.size());
+                break;
+        }
+    }
+}
+
+void BinaryFileLogger::RollLogFile()
+{
+    IP::Time::SystemTimePoint currentTime = IP::Time::GetCurrentSystemTime();
+    if (!m_roller.ShouldRoll(currentTime, m_outputFile.GetSize()))
+    {
+        return;
+    }
+
+    if (m_outputFile.IsOpen())
+    {
+        m_outputFile.Close();
+        m_archiver->ArchiveFile(m_outputFileName);
+    }
+
+    m_outputFileName = m_roller.Roll(currentTime);
+    m_outputFile.Open(m_outputFileName);
+    m_outputFile.BeginEntry().append(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+
+    // every file carries its own site dictionary
+    m_definedSites.clear();
+}
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,233 @@
+#include <ip/core/logging/BinaryLogFormat.h>
+
+#include <ip/core/debug/IPException.h>
+
+#include <string.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+BinaryLogReader::BinaryLogReader(const char* data, size_t length) :
+    m_data(data),
+    m_length(length),
+    m_position(0),
+    m_sites(),
+    m_sitesById()
+{
+    if (m_length < sizeof(BINARY_LOG_MAGIC) || memcmp(m_data, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)))
+    {
+        THROW_IP_EXCEPTION("Not a binary log file");
+    }
+
+    m_position = sizeof(BINARY_LOG_MAGIC);
+}
+
+bool BinaryLogReader::ReadNext(LogEntry& entry)
+{
+    while (true)
+    {
+        uint8_t recordType = 0;
+        if (!ReadValue(recordType))
+        {
+            return false;
+        }
+
+        switch (static_cast<BinaryLogRecordType>(recordType))
+        {
+            case BinaryLogRecordType::Site:
+                if (!ReadSite())
+                {
+                    return false;
+                }
+                break;
+
+            case BinaryLogRecordType::Entry:
+                return ReadEntry(entry);
+
+            default:
+                THROW_IP_EXCEPTION("Unknown binary log record type ", (uint32_t)recordType, " at offset ", (uint64_t)(m_position - 1));
+        }
+    }
+}
+
+bool BinaryLogReader::ReadSite()
+{
+    uint32_t id = 0;
+    uint32_t line = 0;
+    IP::String file;
+    IP::String message;
+    uint8_t keyCount = 0;
+
+    if (!ReadValue(id) || !ReadValue(line) || !ReadString(file) || !ReadString(message) || !ReadValue(keyCount))
+    {
+        return false;
+    }
+
+    IP::Vector<IP::String> keys(keyCount);
+    for (auto& key : keys)
+    {
+        if (!ReadString(key))
+        {
+            return false;
+        }
+    }
+
+    auto site = m_sitesById.find(id);
+    if (site == m_sitesById.end())
+    {
+        m_sites.emplace_back();
+        site = m_sitesById.emplace(id, &m_sites.back()).first;
+    }
+
+    DecodedSite& decodedSite = *site->second;
+    decodedSite.m_file = std::move(file);
+    decodedSite.m_message = std::move(message);
+    decodedSite.m_keys = std::move(keys);
+    decodedSite.m_site.m_file = decodedSite.m_file.c_str();
+    decodedSite.m_site.m_line = line;
+    decodedSite.m_site.m_message = decodedSite.m_message.c_str();
+    decodedSite.m_site.m_id = id;
+
+    return true;
+}
+
+bool BinaryLogReader::ReadEntry(LogEntry& entry)
+{
+    int64_t time = 0;
+    uint8_t level = 0;
+    uint8_t channel = 0;
+    uint32_t siteId = 0;
+
+    if (!ReadValue(time) || !ReadValue(level) || !ReadValue(channel) || !ReadValue(siteId))
+    {
+        return false;
+    }
+
+    // the names are looked up by indexing, so a corrupt or newer file mustn't get past here
+    if (level > static_cast<uint8_t>(LogLevel::None))
+    {
+        THROW_IP_EXCEPTION("Unknown binary log level ", (uint32_t)level);
+    }
+
+    if (channel >= static_cast<uint8_t>(LogChannel::Count))
+    {
+        THROW_IP_EXCEPTION("Unknown binary log channel ", (uint32_t)channel);
+    }
+
+    IP::String text;
+    if (siteId == 0 && !ReadString(text))
+    {
+        return false;
+    }
+
+    auto timeSinceEpoch = std::chrono::duration_cast<IP::Time::SystemTimePoint::duration>(std::chrono::nanoseconds(time));
+    entry = LogEntry(static_cast<LogLevel>(level), std::move(text), IP::Time::SystemTimePoint(timeSinceEpoch));
+    entry.m_channel = static_cast<LogChannel>(channel);
+
+    if (siteId == 0)
+    {
+        return true;
+    }
+
+    auto site = m_sitesById.find(siteId);
+    if (site == m_sitesById.end())
+    {
+        THROW_IP_EXCEPTION("Binary log entry refers to undefined site ", siteId);
+    }
+
+    DecodedSite& decodedSite = *site->second;
+    entry.m_site = &decodedSite.m_site;
+
+    uint8_t fieldCount = 0;
+    if (!ReadValue(fieldCount))
+    {
+        return false;
+    }
+
+    entry.m_fields.resize(fieldCount);
+    for (uint8_t i = 0; i < fieldCount; ++i)
+    {
+        LogField& field = entry.m_fields[i];
+        field.m_key = i < decodedSite.m_keys.size() ? decodedSite.m_keys[i].c_str() : "";
+
+        uint8_t type = 0;
+        if (!ReadValue(type))
+        {
+            return false;
+        }
+
+        field.m_type = static_cast<LogFieldType>(type);
+
+        bool complete = false;
+        switch (field.m_type)
+        {
+            case LogFieldType::Int:
+                complete = ReadValue(field.m_int);
+                break;
+
+            case LogFieldType::UInt:
+                complete = ReadValue(field.m_uint);
+                break;
+
+            case LogFieldType::Double:
+                complete = ReadValue(field.m_double);
+                break;
+
+            case LogFieldType::Bool:
+            {
+                uint8_t value = 0;
+                complete = ReadValue(value);
+                field.m_bool = value != 0;
+                break;
+            }
+
+            case LogFieldType::String:
+                complete = ReadString(field.m_string);
+                break;
+
+            default:
+                THROW_IP_EXCEPTION("Unknown binary log field type ", (uint32_t)type);
+        }
+
+        if (!complete)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BinaryLogReader::ReadBytes(void* destination, size_t length)
+{
+    if (m_length - m_position < length)
+    {
+        m_position = m_length;
+        return false;
+    }
+
+    memcpy(destination, m_data + m_position, length);
+    m_position += length;
+
+    return true;
+}
+
+bool BinaryLogReader::ReadString(IP::String& value)
+{
+    uint32_t length = 0;
+    if (!ReadValue(length) || m_length - m_position < length)
+    {
+        m_position = m_length;
+        return false;
+    }
+
+    value.assign(m_data + m_position, length);
+    m_position += length;
+
+    return true;
+}
+
+} // namespace Logging
+} // namespace IP
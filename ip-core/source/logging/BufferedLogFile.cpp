@@ -0,0 +1,165 @@
+#include <ip/core/logging/BufferedLogFile.h>
+
+#include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/metrics/MetricsRegistry.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+BufferedLogFile::BufferedLogFile(const LogFlushPolicy& flushPolicy) :
+    m_flushPolicy(flushPolicy),
+    m_pendingOutput(),
+    m_pendingEntries(0),
+    m_oldestPendingTime(),
+    m_lastSyncTime(),
+    m_unsyncedOutput(false),
+    m_outputFile(),
+    m_outputFileBytes(0),
+    m_endsMidEntry(false),
+    m_unreportedLostEntries(0),
+    m_unreportedLostBytes(0),
+    m_lostMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_log_file_entries_lost_total", "Entries file loggers lost to failed opens or writes"))
+{
+    m_pendingOutput.reserve(m_flushPolicy.m_maxBufferedBytes);
+}
+
+BufferedLogFile::~BufferedLogFile()
+{
+    Close();
+}
+
+bool BufferedLogFile::Open(const std::experimental::filesystem::path& path)
+{
+    Close();
+
+    m_outputFileBytes = 0;
+    m_endsMidEntry = false;
+
+    return m_outputFile.Open(path);
+}
+
+void BufferedLogFile::Close()
+{
+    if (!m_outputFile.IsOpen())
+    {
+        return;
+    }
+
+    Flush();
+
+    m_outputFile.Close();
+    m_unsyncedOutput = false;
+}
+
+IP::String& BufferedLogFile::BeginEntry()
+{
+    if (m_pendingOutput.empty())
+    {
+        m_oldestPendingTime = IP::Time::GetCurrentSystemTime();
+    }
+
+    return m_pendingOutput;
+}
+
+void BufferedLogFile::EndEntry(LogLevel level)
+{
+    ++m_pendingEntries;
+
+    if (m_pendingOutput.size() >= m_flushPolicy.m_maxBufferedBytes || level >= m_flushPolicy.m_immediateFlushLevel)
+    {
+        WritePendingOutput();
+    }
+}
+
+void BufferedLogFile::Flush()
+{
+    WritePendingOutput();
+
+    if (m_unsyncedOutput && m_flushPolicy.m_syncInterval.count() > 0)
+    {
+        SyncData(IP::Time::GetCurrentSystemTime());
+    }
+}
+
+void BufferedLogFile::Service()
+{
+    auto currentTime = IP::Time::GetCurrentSystemTime();
+
+    if (!m_pendingOutput.empty() && currentTime - m_oldestPendingTime >= m_flushPolicy.m_maxBufferedTime)
+    {
+        WritePendingOutput();
+    }
+    else if (m_unsyncedOutput && m_flushPolicy.m_syncInterval.count() > 0 && currentTime - m_lastSyncTime >= m_flushPolicy.m_syncInterval)
+    {
+        // catch up on a sync that was deferred by the cadence limit even though nothing new has been written
+        SyncData(currentTime);
+    }
+}
+
+void BufferedLogFile::WritePendingOutput()
+{
+    if (m_pendingOutput.empty())
+    {
+        return;
+    }
+
+    // whatever part of a failed batch did get out still counts towards the size, so index offsets stay true
+    size_t writtenLength = 0;
+    bool written = m_outputFile.Write(m_pendingOutput.data(), m_pendingOutput.size(), &writtenLength);
+    m_outputFileBytes += writtenLength;
+    m_unsyncedOutput = m_unsyncedOutput || writtenLength > 0;
+    m_endsMidEntry = written ? false : m_endsMidEntry || writtenLength > 0;
+
+    if (!written)
+    {
+        m_unreportedLostEntries += m_pendingEntries;
+        m_unreportedLostBytes += m_pendingOutput.size() - writtenLength;
+        m_lostMetric.Increment(m_pendingEntries);
+    }
+
+    m_pendingOutput.clear();
+    m_pendingEntries = 0;
+
+    if (!written)
+    {
+        return;
+    }
+
+    if (m_flushPolicy.m_syncInterval.count() > 0)
+    {
+        auto currentTime = IP::Time::GetCurrentSystemTime();
+        if (currentTime - m_lastSyncTime >= m_flushPolicy.m_syncInterval)
+        {
+            SyncData(currentTime);
+        }
+    }
+}
+
+bool BufferedLogFile::TakeLossReport(IP::String& message)
+{
+    if (m_unreportedLostBytes == 0)
+    {
+        return false;
+    }
+
+    IP::OStringStream report;
+    report << "Log file write failed: lost " << m_unreportedLostEntries << " entries (" << m_unreportedLostBytes << " bytes)";
+    message = report.str();
+
+    m_unreportedLostEntries = 0;
+    m_unreportedLostBytes = 0;
+
+    return true;
+}
+
+void BufferedLogFile::SyncData(IP::Time::SystemTimePoint currentTime)
+{
+    m_outputFile.SyncData();
+    m_lastSyncTime = currentTime;
+    m_unsyncedOutput = false;
+}
+
+} // namespace Logging
+} // namespace IP
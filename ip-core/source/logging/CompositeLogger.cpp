@@ -1,30 +1,165 @@
 #include <ip/core/logging/CompositeLogger.h>
 
 #include <ip/core/logging/LogEntry.h>
+#include <ip/core/logging/LogRecord.h>
+#include <ip/core/logging/LogTextPool.h>
+
+#include <algorithm>
+#include <string.h>
 
 namespace IP
 {
 namespace Logging
 {
 
+static IP::Vector<CompositeLoggerSink> BuildUnfilteredSinks(IP::Vector<IP::UniquePtr<ILogger>>&& loggers)
+{
+    IP::Vector<CompositeLoggerSink> sinks;
+    sinks.reserve(loggers.size());
+
+    for (auto& logger : loggers)
+    {
+        sinks.push_back({ std::move(logger), LogLevel::Trace });
+    }
+
+    return sinks;
+}
+
 CompositeLogger::CompositeLogger(IP::Vector<IP::UniquePtr<ILogger>>&& loggers) :
-    m_loggers(std::move(loggers))
+    CompositeLogger(BuildUnfilteredSinks(std::move(loggers)))
+{
+}
+
+CompositeLogger::CompositeLogger(IP::Vector<CompositeLoggerSink>&& sinks) :
+    m_sinks(),
+    m_renderers()
 {
+    m_sinks.reserve(sinks.size());
+
+    for (auto& sink : sinks)
+    {
+        int32_t rendererIndex = -1;
+
+        const ILogLineFormatter* formatter = sink.m_logger->GetFormatter();
+        if (formatter != nullptr)
+        {
+            for (size_t i = 0; i < m_renderers.size(); ++i)
+            {
+                if (!strcmp(m_renderers[i]->m_formatter->GetFormatSignature(), formatter->GetFormatSignature()))
+                {
+                    rendererIndex = static_cast<int32_t>(i);
+                    break;
+                }
+            }
+
+            if (rendererIndex < 0)
+            {
+                rendererIndex = static_cast<int32_t>(m_renderers.size());
+                m_renderers.push_back(IP::MakeUnique<Renderer>(MEMORY_TAG));
+                m_renderers.back()->m_formatter = formatter->Clone();
+            }
+        }
+
+        m_sinks.push_back({ std::move(sink), rendererIndex });
+    }
+
+    IP::Vector<uint32_t> rendererUseCounts(m_renderers.size());
+    for (size_t level = 0; level < LEVEL_COUNT; ++level)
+    {
+        LevelPlan& plan = m_levelPlans[level];
+        plan.m_acceptingSinkCount = 0;
+        plan.m_lastAcceptingSink = 0;
+        std::fill(rendererUseCounts.begin(), rendererUseCounts.end(), 0);
+
+        for (size_t i = 0; i < m_sinks.size(); ++i)
+        {
+            if (static_cast<LogLevel>(level) < m_sinks[i].m_sink.m_minimumLevel)
+            {
+                continue;
+            }
+
+            ++plan.m_acceptingSinkCount;
+            plan.m_lastAcceptingSink = i;
+
+            if (m_sinks[i].m_rendererIndex >= 0)
+            {
+                ++rendererUseCounts[m_sinks[i].m_rendererIndex];
+            }
+        }
+
+        // a format wanted by only one sink is left to that sink
+        for (size_t i = 0; i < m_renderers.size(); ++i)
+        {
+            if (rendererUseCounts[i] > 1)
+            {
+                plan.m_sharedRenderers.push_back(i);
+            }
+        }
+    }
 }
 
 CompositeLogger::~CompositeLogger()
 {
-    m_loggers.clear();
+    m_sinks.clear();
 }
 
 void CompositeLogger::Log(LogEntry&& entry)
 {
-    for (const auto& logger : m_loggers)
+    const LevelPlan& plan = m_levelPlans[std::min(static_cast<size_t>(entry.m_level), LEVEL_COUNT - 1)];
+
+    if (plan.m_acceptingSinkCount == 0)
+    {
+        return;
+    }
+
+    // a single sink can have the entry itself and format it as usual
+    if (plan.m_acceptingSinkCount == 1)
+    {
+        m_sinks[plan.m_lastAcceptingSink].m_sink.m_logger->Log(std::move(entry));
+        return;
+    }
+
+    auto record = IP::MakeShared<LogRecord>(MEMORY_TAG, std::move(entry));
+
+    for (size_t rendererIndex : plan.m_sharedRenderers)
+    {
+        Renderer& renderer = *m_renderers[rendererIndex];
+
+        IP::String line = AcquireLogText();
+        {
+            std::lock_guard<std::mutex> lock(renderer.m_mutex);
+            renderer.m_formatter->FormatLogLine(line, record->GetEntry());
+        }
+
+        record->AddRendering(renderer.m_formatter->GetFormatSignature(), std::move(line));
+    }
+
+    LogRecordPtr sharedRecord = std::move(record);
+
+    for (auto& sink : m_sinks)
+    {
+        if (sharedRecord->GetEntry().m_level >= sink.m_sink.m_minimumLevel)
+        {
+            sink.m_sink.m_logger->LogShared(sharedRecord);
+        }
+    }
+}
+
+void CompositeLogger::Flush()
+{
+    for (const auto& sink : m_sinks)
+    {
+        sink.m_sink.m_logger->Flush();
+    }
+}
+
+void CompositeLogger::Service()
+{
+    for (const auto& sink : m_sinks)
     {
-        LogEntry entryCopy = entry;
-        logger->Log(std::move(entryCopy));
+        sink.m_sink.m_logger->Service();
     }
 }
 
 } // namespace Logging
-} // namespace IP
\ No newline at end of file
+} // namespace IP
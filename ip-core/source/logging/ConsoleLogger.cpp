@@ -1,33 +1,138 @@
 #include <ip/core/logging/ConsoleLogger.h>
 
-#include <iostream>
-
 #include <ip/core/logging/ILogLineFormatter.h>
-#include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/logging/LogEntry.h>
 
 namespace IP
 {
 namespace Logging
 {
 
+static const char NEWLINE = '\n';
+
 ConsoleLogger::ConsoleLogger(IP::UniquePtr<ILogLineFormatter>&& formatter) :
-    m_formatter(std::move(formatter))
+    ConsoleLogger(std::move(formatter), LogFlushPolicy())
+{
+}
+
+ConsoleLogger::ConsoleLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const LogFlushPolicy& flushPolicy) :
+    m_formatter(std::move(formatter)),
+    m_flushPolicy(flushPolicy),
+    m_isTerminal(IP::FileUtils::IsStandardOutputTerminal()),
+    m_serviced(false),
+    m_lines(),
+    m_lineCount(0),
+    m_sharedRecords(),
+    m_pendingLines(),
+    m_writeBuffers(),
+    m_pendingBytes(0),
+    m_oldestPendingTime()
 {
 }
 
 ConsoleLogger::~ConsoleLogger()
 {
+    WritePendingOutput();
+
     m_formatter = nullptr;
 }
 
 void ConsoleLogger::Log(LogEntry&& entry)
 {
-    IP::StringStream ss;
-    m_formatter->FormatLogLine(ss, std::move(entry));
+    if (m_lineCount == m_lines.size())
+    {
+        m_lines.emplace_back();
+    }
+
+    size_t lineIndex = m_lineCount++;
+    IP::String& line = m_lines[lineIndex];
+    line.clear();
+    m_formatter->FormatLogLine(line, entry);
+    line.push_back(NEWLINE);
+
+    AddPendingLine(entry, { nullptr, lineIndex }, line.size());
+}
+
+void ConsoleLogger::LogShared(const LogRecordPtr& record)
+{
+    const IP::String* renderedLine = record->FindRendering(m_formatter->GetFormatSignature());
+    if (renderedLine == nullptr)
+    {
+        LogEntry entry = record->GetEntry();
+        Log(std::move(entry));
+        return;
+    }
+
+    m_sharedRecords.push_back(record);
+    AddPendingLine(record->GetEntry(), { renderedLine, 0 }, renderedLine->size() + 1);
+}
 
-    std::cout << ss.str() << std::endl;
+void ConsoleLogger::Flush()
+{
+    WritePendingOutput();
+}
+
+void ConsoleLogger::Service()
+{
+    m_serviced = true;
+
+    if (m_pendingLines.empty())
+    {
+        return;
+    }
+
+    if (m_isTerminal || IP::Time::GetCurrentSystemTime() - m_oldestPendingTime >= m_flushPolicy.m_maxBufferedTime)
+    {
+        WritePendingOutput();
+    }
+}
+
+void ConsoleLogger::AddPendingLine(const LogEntry& entry, const PendingLine& line, size_t length)
+{
+    if (m_pendingLines.empty())
+    {
+        m_oldestPendingTime = IP::Time::GetCurrentSystemTime();
+    }
+
+    m_pendingLines.push_back(line);
+    m_pendingBytes += length;
+
+    // an interactive terminal with nothing batching gets every line as it's logged
+    if ((m_isTerminal && !m_serviced) || m_pendingBytes >= m_flushPolicy.m_maxBufferedBytes || entry.m_level >= m_flushPolicy.m_immediateFlushLevel)
+    {
+        WritePendingOutput();
+    }
+}
+
+void ConsoleLogger::WritePendingOutput()
+{
+    if (m_pendingLines.empty())
+    {
+        return;
+    }
+
+    m_writeBuffers.clear();
+    for (const auto& pendingLine : m_pendingLines)
+    {
+        if (pendingLine.m_sharedLine != nullptr)
+        {
+            m_writeBuffers.push_back({ pendingLine.m_sharedLine->data(), pendingLine.m_sharedLine->size() });
+            m_writeBuffers.push_back({ &NEWLINE, 1 });
+        }
+        else
+        {
+            const IP::String& line = m_lines[pendingLine.m_lineIndex];
+            m_writeBuffers.push_back({ line.data(), line.size() });
+        }
+    }
+
+    IP::FileUtils::WriteStandardOutput(m_writeBuffers.data(), m_writeBuffers.size());
+
+    m_pendingLines.clear();
+    m_sharedRecords.clear();
+    m_lineCount = 0;
+    m_pendingBytes = 0;
 }
 
 } // namespace Logging
 } // namespace IP
-
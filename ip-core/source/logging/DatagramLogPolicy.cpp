@@ -0,0 +1,20 @@
+#include <ip/core/logging/DatagramLogPolicy.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+DatagramLogPolicy::DatagramLogPolicy() :
+    m_batchSize(64),
+    m_maxDatagramSize(8 * 1024),
+    m_maxPendingDatagrams(4096),
+    m_dropPolicy(DatagramDropPolicy::DropUnsent),
+    m_retryTimeout(2),
+    m_reconnectInterval(1000),
+    m_dropReportInterval(1000)
+{
+}
+
+} // namespace Logging
+} // namespace IP
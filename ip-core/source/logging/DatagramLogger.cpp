@@ -0,0 +1,336 @@
+#include <ip/core/logging/DatagramLogger.h>
+
+#include <ip/core/logging/BinaryLogFormat.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/memory/stl/StringStream.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace IP
+{
+namespace Logging
+{
+
+// type, time, level, channel and site id ahead of a binary entry's text
+static const size_t BINARY_ENTRY_HEADER_SIZE = sizeof(uint8_t) + sizeof(int64_t) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t);
+
+template<typename T>
+static void AppendValue(IP::String& buffer, T value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+DatagramLogger::DatagramLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* socketPath) :
+    DatagramLogger(std::move(formatter), socketPath, LogFlushPolicy(), DatagramLogPolicy())
+{
+}
+
+DatagramLogger::DatagramLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* socketPath, const LogFlushPolicy& flushPolicy, const DatagramLogPolicy& datagramPolicy) :
+    m_formatter(std::move(formatter)),
+    m_flushPolicy(flushPolicy),
+    m_datagramPolicy(datagramPolicy),
+    m_lineBuffer(),
+    m_socketPath(socketPath),
+    m_socket(),
+    m_lastConnectTime(),
+    m_pendingData(),
+    m_datagramEnds(),
+    m_firstPending(0),
+    m_heldBackCount(0),
+    m_oldestPendingTime(),
+    m_sendBuffers(),
+    m_droppedCount(0),
+    m_unreportedDrops(0),
+    m_reportBuffer(),
+    m_lastDropReportTime()
+{
+    m_datagramPolicy.m_batchSize = std::max<size_t>(m_datagramPolicy.m_batchSize, 1);
+    m_datagramPolicy.m_maxPendingDatagrams = std::max(m_datagramPolicy.m_maxPendingDatagrams, m_datagramPolicy.m_batchSize);
+    m_datagramPolicy.m_maxDatagramSize = std::max(m_datagramPolicy.m_maxDatagramSize, BINARY_ENTRY_HEADER_SIZE + 1);
+
+    m_datagramEnds.reserve(m_datagramPolicy.m_batchSize * 2);
+    m_sendBuffers.reserve(m_datagramPolicy.m_batchSize * 2);
+
+    Connect(IP::Time::GetCurrentSystemTime());
+}
+
+DatagramLogger::~DatagramLogger()
+{
+    Flush();
+
+    if (m_socket.IsOpen())
+    {
+        SendDropReport(IP::Time::GetCurrentSystemTime(), true);
+    }
+}
+
+void DatagramLogger::Log(LogEntry&& entry)
+{
+    WriteEntry(entry, nullptr);
+}
+
+void DatagramLogger::LogShared(const LogRecordPtr& record)
+{
+    const IP::String* renderedLine = m_formatter ? record->FindRendering(m_formatter->GetFormatSignature()) : nullptr;
+
+    WriteEntry(record->GetEntry(), renderedLine);
+}
+
+void DatagramLogger::Flush()
+{
+    SendPendingDatagrams();
+}
+
+void DatagramLogger::Service()
+{
+    auto currentTime = IP::Time::GetCurrentSystemTime();
+
+    bool pendingDue = GetPendingCount() > 0 && currentTime - m_oldestPendingTime >= m_flushPolicy.m_maxBufferedTime;
+    bool reportDue = m_unreportedDrops > 0 && currentTime - m_lastDropReportTime >= m_datagramPolicy.m_dropReportInterval;
+
+    if (pendingDue || reportDue)
+    {
+        SendPendingDatagrams();
+    }
+}
+
+void DatagramLogger::WriteEntry(const LogEntry& entry, const IP::String* renderedLine)
+{
+    auto currentTime = IP::Time::GetCurrentSystemTime();
+
+    // with nobody listening there's no point formatting anything
+    if (!m_socket.IsOpen() && !Connect(currentTime))
+    {
+        ++m_droppedCount;
+        ++m_unreportedDrops;
+        return;
+    }
+
+    if (GetPendingCount() == 0)
+    {
+        m_oldestPendingTime = currentTime;
+    }
+
+    AppendDatagram(m_pendingData, entry, renderedLine);
+    m_datagramEnds.push_back(m_pendingData.size());
+
+    if (GetPendingCount() > m_datagramPolicy.m_maxPendingDatagrams)
+    {
+        DropPendingDatagrams(GetPendingCount() - m_datagramPolicy.m_maxPendingDatagrams);
+    }
+
+    // entries held back from the last batch don't count towards the next one, so a backlogged collector is retried
+    // once per batch rather than once per entry
+    size_t firstNew = m_firstPending + m_heldBackCount;
+    size_t newCount = m_datagramEnds.size() - firstNew;
+    size_t newBytes = m_pendingData.size() - GetPendingOffset(firstNew);
+
+    if (newCount >= m_datagramPolicy.m_batchSize || newBytes >= m_flushPolicy.m_maxBufferedBytes || entry.m_level >= m_flushPolicy.m_immediateFlushLevel)
+    {
+        SendPendingDatagrams();
+    }
+}
+
+void DatagramLogger::AppendDatagram(IP::String& buffer, const LogEntry& entry, const IP::String* renderedLine)
+{
+    if (!m_formatter)
+    {
+        EncodeBinaryEntry(buffer, entry);
+        return;
+    }
+
+    size_t start = buffer.size();
+
+    if (renderedLine != nullptr)
+    {
+        buffer.append(*renderedLine);
+    }
+    else
+    {
+        m_formatter->FormatLogLine(buffer, entry);
+    }
+
+    if (buffer.size() - start > m_datagramPolicy.m_maxDatagramSize)
+    {
+        buffer.resize(start + m_datagramPolicy.m_maxDatagramSize);
+    }
+}
+
+void DatagramLogger::EncodeBinaryEntry(IP::String& buffer, const LogEntry& entry)
+{
+    m_lineBuffer.clear();
+    AppendLogMessage(m_lineBuffer, entry);
+
+    size_t textLength = std::min(m_lineBuffer.size(), m_datagramPolicy.m_maxDatagramSize - BINARY_ENTRY_HEADER_SIZE);
+    int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.m_time.time_since_epoch()).count();
+
+    AppendValue(buffer, static_cast<uint8_t>(BinaryLogRecordType::Entry));
+    AppendValue(buffer, time);
+    AppendValue(buffer, static_cast<uint8_t>(entry.m_level));
+    AppendValue(buffer, static_cast<uint8_t>(entry.m_channel));
+    AppendValue(buffer, static_cast<uint32_t>(0));
+    AppendValue(buffer, static_cast<uint32_t>(textLength));
+    buffer.append(m_lineBuffer.data(), textLength);
+}
+
+bool DatagramLogger::Connect(IP::Time::SystemTimePoint currentTime)
+{
+    if (m_lastConnectTime != IP::Time::SystemTimePoint() && currentTime - m_lastConnectTime < m_datagramPolicy.m_reconnectInterval)
+    {
+        return false;
+    }
+
+    m_lastConnectTime = currentTime;
+
+    return m_socket.Connect(m_socketPath.c_str());
+}
+
+void DatagramLogger::SendPendingDatagrams()
+{
+    if (GetPendingCount() == 0 && m_unreportedDrops == 0)
+    {
+        return;
+    }
+
+    auto currentTime = IP::Time::GetCurrentSystemTime();
+
+    if (!m_socket.IsOpen() && !Connect(currentTime))
+    {
+        DropPendingDatagrams(GetPendingCount());
+        return;
+    }
+
+    SendDropReport(currentTime, false);
+
+    if (GetPendingCount() == 0)
+    {
+        return;
+    }
+
+    m_sendBuffers.clear();
+
+    size_t start = GetPendingOffset(m_firstPending);
+    for (size_t i = m_firstPending; i < m_datagramEnds.size(); ++i)
+    {
+        m_sendBuffers.push_back({ m_pendingData.data() + start, m_datagramEnds[i] - start });
+        start = m_datagramEnds[i];
+    }
+
+    size_t sent = 0;
+    size_t tooLargeCount = 0;
+    auto retryDeadline = IP::Time::GetCurrentMonotonicTime() + m_datagramPolicy.m_retryTimeout;
+
+    while (sent < m_sendBuffers.size())
+    {
+        size_t sentCount = 0;
+        IP::System::DatagramSendStatus status = m_socket.Send(m_sendBuffers.data() + sent, m_sendBuffers.size() - sent, sentCount);
+        sent += sentCount;
+
+        if (status == IP::System::DatagramSendStatus::Disconnected)
+        {
+            // the collector went away; reconnect later rather than holding on to anything
+            m_socket.Close();
+            m_lastConnectTime = currentTime;
+            break;
+        }
+
+        if (status == IP::System::DatagramSendStatus::TooLarge)
+        {
+            // only that datagram is dropped; the socket is fine
+            ++sent;
+            ++tooLargeCount;
+        }
+
+        if (status == IP::System::DatagramSendStatus::WouldBlock)
+        {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(retryDeadline - IP::Time::GetCurrentMonotonicTime());
+            if (remaining.count() <= 0 || !m_socket.WaitUntilWritable(remaining))
+            {
+                break;
+            }
+        }
+    }
+
+    m_firstPending += sent;
+    m_heldBackCount = 0;
+    m_droppedCount += tooLargeCount;
+    m_unreportedDrops += tooLargeCount;
+
+    if (GetPendingCount() > 0 && (!m_socket.IsOpen() || m_datagramPolicy.m_dropPolicy == DatagramDropPolicy::DropUnsent))
+    {
+        DropPendingDatagrams(GetPendingCount());
+    }
+
+    m_heldBackCount = GetPendingCount();
+    CompactPendingDatagrams();
+
+    if (GetPendingCount() > 0)
+    {
+        m_oldestPendingTime = currentTime;
+    }
+}
+
+void DatagramLogger::DropPendingDatagrams(size_t count)
+{
+    m_firstPending += count;
+    m_heldBackCount -= std::min(m_heldBackCount, count);
+    m_droppedCount += count;
+    m_unreportedDrops += count;
+
+    CompactPendingDatagrams();
+}
+
+void DatagramLogger::CompactPendingDatagrams()
+{
+    if (m_firstPending == m_datagramEnds.size())
+    {
+        m_pendingData.clear();
+        m_datagramEnds.clear();
+        m_firstPending = 0;
+        return;
+    }
+
+    // only once the sent or dropped prefix is half the queue, which keeps dropping one at a time amortized constant
+    if (m_firstPending == 0 || m_firstPending * 2 < m_datagramEnds.size())
+    {
+        return;
+    }
+
+    size_t removedBytes = GetPendingOffset(m_firstPending);
+    m_pendingData.erase(0, removedBytes);
+    m_datagramEnds.erase(m_datagramEnds.begin(), m_datagramEnds.begin() + m_firstPending);
+    m_firstPending = 0;
+
+    for (auto& end : m_datagramEnds)
+    {
+        end -= removedBytes;
+    }
+}
+
+// sent ahead of the batch, since at the back it would be the first thing dropped again
+void DatagramLogger::SendDropReport(IP::Time::SystemTimePoint currentTime, bool force)
+{
+    if (m_unreportedDrops == 0 || (!force && currentTime - m_lastDropReportTime < m_datagramPolicy.m_dropReportInterval))
+    {
+        return;
+    }
+
+    IP::OStringStream message;
+    message << "Log collector overflow: dropped " << m_unreportedDrops << " entries";
+
+    m_reportBuffer.clear();
+    AppendDatagram(m_reportBuffer, LogEntry(LogLevel::Warn, message.str(), currentTime), nullptr);
+
+    IP::System::DatagramBuffer report = { m_reportBuffer.data(), m_reportBuffer.size() };
+    size_t sentCount = 0;
+    if (m_socket.Send(&report, 1, sentCount) == IP::System::DatagramSendStatus::Sent || force)
+    {
+        m_unreportedDrops = 0;
+    }
+
+    m_lastDropReportTime = currentTime;
+}
+
+} // namespace Logging
+} // namespace IP
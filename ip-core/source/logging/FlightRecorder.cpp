@@ -0,0 +1,249 @@
+#include <ip/core/logging/FlightRecorder.h>
+
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/utils/SystemUtils.h>
+
+#include <algorithm>
+#include <ctime>
+#include <string.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+static const size_t MAX_DUMP_PATH_LENGTH = 1024;
+static const int64_t SECONDS_PER_DAY = 24 * 60 * 60;
+static const int64_t MILLISECONDS_PER_HOUR = 60 * 60 * 1000;
+
+std::atomic<LogLevel> g_flightRecorderCaptureLevel(LogLevel::None);
+
+static std::atomic<FlightRecorder*> s_flightRecorder(nullptr);
+static char s_dumpPath[MAX_DUMP_PATH_LENGTH] = {};
+
+static int64_t ComputeUtcOffsetSeconds(std::time_t time)
+{
+    std::tm localTime;
+    std::tm utcTime;
+#if defined(_WIN32)
+    localtime_s(&localTime, &time);
+    gmtime_s(&utcTime, &time);
+#else
+    localtime_r(&time, &localTime);
+    gmtime_r(&time, &utcTime);
+#endif
+
+    // the two are at most a day apart, which may cross the end of a year
+    int64_t dayDifference = localTime.tm_year == utcTime.tm_year ? localTime.tm_yday - utcTime.tm_yday : (localTime.tm_year > utcTime.tm_year ? 1 : -1);
+
+    return ((dayDifference * 24 + localTime.tm_hour - utcTime.tm_hour) * 60 + localTime.tm_min - utcTime.tm_min) * 60 + localTime.tm_sec - utcTime.tm_sec;
+}
+
+// the fixed-width helpers below stand in for the usual formatting, none of which is async-signal-safe
+static char* AppendText(char* output, const char* outputEnd, const char* text, size_t length)
+{
+    length = std::min<size_t>(length, outputEnd - output);
+    memcpy(output, text, length);
+    return output + length;
+}
+
+static char* AppendText(char* output, const char* outputEnd, const char* text)
+{
+    return AppendText(output, outputEnd, text, strlen(text));
+}
+
+static char* AppendDigits(char* output, const char* outputEnd, uint64_t value, uint32_t width)
+{
+    char digits[20];
+    for (uint32_t i = 0; i < width; ++i)
+    {
+        digits[width - 1 - i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+
+    return AppendText(output, outputEnd, digits, width);
+}
+
+FlightRecorder::FlightRecorder(size_t slotCount) :
+    m_slots(nullptr),
+    m_slotCount(std::max<size_t>(slotCount, 1)),
+    m_nextTicket(0),
+    m_utcOffsetHour(-1),
+    m_utcOffsetSeconds(0)
+{
+    m_slots = IP::MakeUniqueArray<Slot>(MEMORY_TAG, m_slotCount);
+
+    // touch every page now so recording never faults in fresh memory
+    for (size_t i = 0; i < m_slotCount; ++i)
+    {
+        Slot& slot = m_slots.get()[i];
+        slot.m_sequence.store(0, std::memory_order_relaxed);
+        slot.m_localTime = 0;
+        slot.m_level = 0;
+        slot.m_channel = 0;
+        slot.m_length = 0;
+        memset(slot.m_text, 0, sizeof(slot.m_text));
+    }
+}
+
+FlightRecorder::~FlightRecorder()
+{
+}
+
+void FlightRecorder::Record(const LogEntry& entry)
+{
+    uint64_t ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots.get()[ticket % m_slotCount];
+
+    slot.m_sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    int64_t time = std::chrono::duration_cast<std::chrono::milliseconds>(entry.m_time.time_since_epoch()).count();
+    int64_t hour = time / MILLISECONDS_PER_HOUR;
+    if (hour > m_utcOffsetHour.load(std::memory_order_relaxed))
+    {
+        // threads racing into a new hour store the same offset; a late entry from the hour before just uses it too
+        m_utcOffsetSeconds.store(ComputeUtcOffsetSeconds(static_cast<std::time_t>(time / 1000)), std::memory_order_relaxed);
+        m_utcOffsetHour.store(hour, std::memory_order_relaxed);
+    }
+
+    slot.m_localTime = time + m_utcOffsetSeconds.load(std::memory_order_relaxed) * 1000;
+    slot.m_level = static_cast<uint8_t>(entry.m_level);
+    slot.m_channel = static_cast<uint8_t>(entry.m_channel);
+
+    if (entry.m_site == nullptr)
+    {
+        slot.m_length = static_cast<uint16_t>(std::min(entry.m_text.size(), SLOT_TEXT_LENGTH));
+        memcpy(slot.m_text, entry.m_text.data(), slot.m_length);
+    }
+    else
+    {
+        // structured entries have to be rendered; the scratch buffer stops allocating once it has grown
+        static thread_local IP::String message;
+        message.clear();
+        AppendLogMessage(message, entry);
+
+        slot.m_length = static_cast<uint16_t>(std::min(message.size(), SLOT_TEXT_LENGTH));
+        memcpy(slot.m_text, message.data(), slot.m_length);
+    }
+
+    slot.m_sequence.store(ticket + 1, std::memory_order_release);
+}
+
+void FlightRecorder::Dump(IP::FileUtils::OutputFile& file, const char* reason) const
+{
+    char line[SLOT_TEXT_LENGTH + 64];
+    const char* lineEnd = line + sizeof(line);
+
+    char* output = AppendText(line, lineEnd, "==== flight recorder dump: ");
+    output = AppendText(output, lineEnd, reason);
+    output = AppendText(output, lineEnd, " ====\n");
+    file.Write(line, output - line);
+
+    uint64_t nextTicket = m_nextTicket.load(std::memory_order_acquire);
+    uint64_t firstTicket = nextTicket > m_slotCount ? nextTicket - m_slotCount : 0;
+
+    for (uint64_t ticket = firstTicket; ticket < nextTicket; ++ticket)
+    {
+        const Slot& slot = m_slots.get()[ticket % m_slotCount];
+        if (slot.m_sequence.load(std::memory_order_acquire) != ticket + 1)
+        {
+            continue;
+        }
+
+        uint64_t millisecondOfDay = static_cast<uint64_t>(((slot.m_localTime % (SECONDS_PER_DAY * 1000)) + SECONDS_PER_DAY * 1000) % (SECONDS_PER_DAY * 1000));
+
+        output = line;
+        output = AppendDigits(output, lineEnd, millisecondOfDay / 3600000, 2);
+        output = AppendText(output, lineEnd, ":");
+        output = AppendDigits(output, lineEnd, millisecondOfDay / 60000 % 60, 2);
+        output = AppendText(output, lineEnd, ":");
+        output = AppendDigits(output, lineEnd, millisecondOfDay / 1000 % 60, 2);
+        output = AppendText(output, lineEnd, ".");
+        output = AppendDigits(output, lineEnd, millisecondOfDay % 1000, 3);
+        output = AppendText(output, lineEnd, " [");
+        output = AppendText(output, lineEnd, GetLogLevelName(static_cast<LogLevel>(slot.m_level)));
+        output = AppendText(output, lineEnd, "] ");
+
+        if (static_cast<LogChannel>(slot.m_channel) != LogChannel::General)
+        {
+            output = AppendText(output, lineEnd, "[");
+            output = AppendText(output, lineEnd, GetLogChannelName(static_cast<LogChannel>(slot.m_channel)));
+            output = AppendText(output, lineEnd, "] ");
+        }
+
+        output = AppendText(output, lineEnd, slot.m_text, slot.m_length);
+
+        // a slot overwritten while it was being copied is skipped rather than dumped torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.m_sequence.load(std::memory_order_relaxed) != ticket + 1)
+        {
+            continue;
+        }
+
+        output = AppendText(output, lineEnd, "\n");
+        file.Write(line, output - line);
+    }
+}
+
+static void FatalErrorHandler(const char* description)
+{
+    DumpFlightRecorder(description);
+}
+
+void InstallFlightRecorder(FlightRecorder* recorder, LogLevel captureLevel, const std::experimental::filesystem::path& dumpDirectory)
+{
+    std::experimental::filesystem::path dumpPath(dumpDirectory);
+    dumpPath /= (IP::System::AppendProcessId("flight_recorder") + ".log").c_str();
+
+    strncpy(s_dumpPath, dumpPath.string().c_str(), MAX_DUMP_PATH_LENGTH - 1);
+
+    s_flightRecorder = recorder;
+    g_flightRecorderCaptureLevel = captureLevel;
+
+    IP::System::InstallFatalErrorHandler(FatalErrorHandler);
+}
+
+void UninstallFlightRecorder()
+{
+    g_flightRecorderCaptureLevel = LogLevel::None;
+    s_flightRecorder = nullptr;
+}
+
+void RecordFlightRecorderEntry(const LogEntry& entry)
+{
+    FlightRecorder* recorder = s_flightRecorder.load(std::memory_order_relaxed);
+    if (recorder != nullptr && IsFlightRecorderCapturing(entry.m_level))
+    {
+        recorder->Record(entry);
+    }
+}
+
+void DumpFlightRecorder(const char* reason)
+{
+    FlightRecorder* recorder = s_flightRecorder.load();
+    if (recorder == nullptr)
+    {
+        return;
+    }
+
+    IP::FileUtils::OutputFile file;
+    if (file.OpenForAppend(s_dumpPath))
+    {
+        recorder->Dump(file, reason);
+    }
+}
+
+FlightRecorderScope::FlightRecorderScope(size_t slotCount, LogLevel captureLevel, const std::experimental::filesystem::path& dumpDirectory) :
+    m_recorder(slotCount)
+{
+    InstallFlightRecorder(&m_recorder, captureLevel, dumpDirectory);
+}
+
+FlightRecorderScope::~FlightRecorderScope()
+{
+    UninstallFlightRecorder();
+}
+
+} // namespace Logging
+} // namespace IP
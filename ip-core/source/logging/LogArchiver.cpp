@@ -0,0 +1,403 @@
+#include <ip/core/logging/LogArchiver.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <ip/core/logging/LogFileUtils.h>
+#include <ip/core/memory/stl/Deque.h>
+#include <ip/core/memory/stl/Stream.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/SystemUtils.h>
+#include <ip/core/utils/TimeUtils.h>
+
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef IP_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+static const char* COMPRESSED_SUFFIX = ".gz";
+static const char* PARTIAL_SUFFIX = ".partial";
+static const size_t COMPRESSION_CHUNK_SIZE = 64 * 1024;
+
+LogArchivePolicy::LogArchivePolicy() :
+    m_compress(true),
+    m_maxAge(24),
+    m_maxTotalBytes(1024ULL * 1024ULL * 1024ULL),
+    m_maintenanceInterval(10)
+{
+}
+
+struct LogArchiverThreadData
+{
+    public:
+
+        LogArchiverThreadData(const std::experimental::filesystem::path& logDirectory, const IP::String& filenamePrefix, const LogArchivePolicy& policy) :
+            m_queueLock(),
+            m_pendingFiles(),
+            m_queueSignal(),
+            m_shutdown(false),
+            m_logDirectory(logDirectory),
+            m_archiveDirectory(BuildLogArchiveDirectoryName(logDirectory)),
+            m_filenamePrefix(filenamePrefix),
+            m_processId(static_cast<uint32_t>(strtoul(IP::System::GetProcessId().c_str(), nullptr, 10))),
+            m_policy(policy)
+        {}
+
+        ~LogArchiverThreadData() {}
+
+        LogArchiverThreadData(const LogArchiverThreadData& rhs) = delete;
+        LogArchiverThreadData(LogArchiverThreadData&& rhs) = delete;
+        LogArchiverThreadData& operator =(const LogArchiverThreadData& rhs) = delete;
+        LogArchiverThreadData& operator =(LogArchiverThreadData&& rhs) = delete;
+
+        std::mutex m_queueLock;
+        IP::Deque<std::experimental::filesystem::path> m_pendingFiles;
+        std::condition_variable m_queueSignal;
+        std::atomic<bool> m_shutdown;
+
+        const std::experimental::filesystem::path m_logDirectory;
+        const std::experimental::filesystem::path m_archiveDirectory;
+        const IP::String m_filenamePrefix;
+        const uint32_t m_processId;
+        const LogArchivePolicy m_policy;
+};
+
+static bool HasSuffix(const std::experimental::filesystem::path& path, const char* suffix)
+{
+    std::string filename = path.filename().string();
+    size_t suffixLength = strlen(suffix);
+
+    return filename.size() >= suffixLength && filename.compare(filename.size() - suffixLength, suffixLength, suffix) == 0;
+}
+
+static bool ShouldCompress(const LogArchivePolicy& policy)
+{
+#ifdef IP_USE_ZLIB
+    return policy.m_compress;
+#else
+    IP_UNREFERENCED_PARAM(policy);
+    return false;
+#endif // IP_USE_ZLIB
+}
+
+#ifdef IP_USE_ZLIB
+// Streams source through deflate into a gzip file at destination; gives up (returning false) on error or shutdown
+static bool CompressFile(const std::experimental::filesystem::path& source, const std::experimental::filesystem::path& destination, const std::atomic<bool>& shutdown)
+{
+    IP::IFStream input(source.c_str(), std::ios_base::in | std::ios_base::binary);
+    IP::OFStream output(destination.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!input.good() || !output.good())
+    {
+        return false;
+    }
+
+    z_stream stream = {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return false;
+    }
+
+    IP::Vector<char> inputChunk(COMPRESSION_CHUNK_SIZE);
+    IP::Vector<char> outputChunk(COMPRESSION_CHUNK_SIZE);
+
+    bool success = true;
+    int flush = Z_NO_FLUSH;
+    while (success && flush != Z_FINISH)
+    {
+        if (shutdown)
+        {
+            success = false;
+            break;
+        }
+
+        input.read(inputChunk.data(), inputChunk.size());
+        stream.next_in = reinterpret_cast<Bytef*>(inputChunk.data());
+        stream.avail_in = static_cast<uInt>(input.gcount());
+        flush = input.eof() ? Z_FINISH : Z_NO_FLUSH;
+
+        if (input.bad())
+        {
+            success = false;
+            break;
+        }
+
+        do
+        {
+            stream.next_out = reinterpret_cast<Bytef*>(outputChunk.data());
+            stream.avail_out = static_cast<uInt>(outputChunk.size());
+
+            if (deflate(&stream, flush) == Z_STREAM_ERROR)
+            {
+                success = false;
+                break;
+            }
+
+            output.write(outputChunk.data(), outputChunk.size() - stream.avail_out);
+        } while (stream.avail_out == 0);
+    }
+
+    deflateEnd(&stream);
+    output.close();
+
+    return success && !output.fail();
+}
+#endif // IP_USE_ZLIB
+
+static void ArchiveLogFile(const LogArchiverThreadData& data, const std::experimental::filesystem::path& logFile)
+{
+    std::error_code error;
+    if (!std::experimental::filesystem::exists(logFile, error))
+    {
+        return;
+    }
+
+    std::experimental::filesystem::path destination(data.m_archiveDirectory);
+    destination /= logFile.filename();
+
+#ifdef IP_USE_ZLIB
+    if (ShouldCompress(data.m_policy) && !HasSuffix(logFile, COMPRESSED_SUFFIX))
+    {
+        destination += COMPRESSED_SUFFIX;
+
+        // compress under a temporary name so an interrupted run never leaves a truncated archive behind
+        std::experimental::filesystem::path partialDestination(destination);
+        partialDestination += PARTIAL_SUFFIX;
+
+        if (CompressFile(logFile, partialDestination, data.m_shutdown))
+        {
+            std::experimental::filesystem::rename(partialDestination, destination, error);
+            if (!error)
+            {
+                std::experimental::filesystem::remove(logFile, error);
+            }
+        }
+        else
+        {
+            // leave the original in place; it gets picked up again on the next run
+            std::experimental::filesystem::remove(partialDestination, error);
+        }
+
+        return;
+    }
+#endif // IP_USE_ZLIB
+
+    if (logFile.parent_path() != data.m_archiveDirectory)
+    {
+        std::experimental::filesystem::rename(logFile, destination, error);
+    }
+}
+
+struct ArchivedFile
+{
+    std::experimental::filesystem::path m_path;
+    uint64_t m_size;
+    std::experimental::filesystem::file_time_type m_lastModifiedTime;
+};
+
+static void EnforceRetention(const LogArchiverThreadData& data)
+{
+    std::error_code error;
+    IP::Vector<ArchivedFile> files;
+
+    auto currentTime = std::experimental::filesystem::file_time_type::clock::now();
+    for (const auto& file : std::experimental::filesystem::directory_iterator(data.m_archiveDirectory, error))
+    {
+        if (!std::experimental::filesystem::is_regular_file(file.status()))
+        {
+            continue;
+        }
+
+        ArchivedFile archivedFile;
+        archivedFile.m_path = file.path();
+        archivedFile.m_lastModifiedTime = std::experimental::filesystem::last_write_time(archivedFile.m_path, error);
+        archivedFile.m_size = error ? 0 : std::experimental::filesystem::file_size(archivedFile.m_path, error);
+        if (error)
+        {
+            continue;
+        }
+
+        if (currentTime - archivedFile.m_lastModifiedTime > data.m_policy.m_maxAge)
+        {
+            std::experimental::filesystem::remove(archivedFile.m_path, error);
+            continue;
+        }
+
+        files.push_back(archivedFile);
+    }
+
+    if (data.m_policy.m_maxTotalBytes == 0)
+    {
+        return;
+    }
+
+    uint64_t totalBytes = 0;
+    for (const auto& file : files)
+    {
+        totalBytes += file.m_size;
+    }
+
+    std::sort(files.begin(), files.end(), [](const ArchivedFile& lhs, const ArchivedFile& rhs){ return lhs.m_lastModifiedTime < rhs.m_lastModifiedTime; });
+
+    for (const auto& file : files)
+    {
+        if (totalBytes <= data.m_policy.m_maxTotalBytes)
+        {
+            break;
+        }
+
+        std::experimental::filesystem::remove(file.m_path, error);
+        totalBytes -= file.m_size;
+    }
+}
+
+static void CompressArchivedLogFiles(const LogArchiverThreadData& data)
+{
+    if (!ShouldCompress(data.m_policy))
+    {
+        return;
+    }
+
+    // files moved into the archive by an earlier run (or by startup cleanup) that never got compressed
+    std::error_code error;
+    IP::Vector<std::experimental::filesystem::path> uncompressedFiles;
+    for (const auto& file : std::experimental::filesystem::directory_iterator(data.m_archiveDirectory, error))
+    {
+        const auto& path = file.path();
+        if (std::experimental::filesystem::is_regular_file(file.status()) && !HasSuffix(path, COMPRESSED_SUFFIX) && !HasSuffix(path, PARTIAL_SUFFIX))
+        {
+            uncompressedFiles.push_back(path);
+        }
+    }
+
+    for (const auto& path : uncompressedFiles)
+    {
+        if (data.m_shutdown)
+        {
+            return;
+        }
+
+        ArchiveLogFile(data, path);
+    }
+}
+
+static void ArchiveAbandonedLogFiles(const LogArchiverThreadData& data)
+{
+    // files with our prefix left behind by processes that have exited; files of this process, and of others still
+    // running and logging to the same directory, may be open and are left alone
+    std::error_code error;
+    IP::Vector<std::experimental::filesystem::path> abandonedFiles;
+    for (const auto& file : std::experimental::filesystem::directory_iterator(data.m_logDirectory, error))
+    {
+        const auto& path = file.path();
+        IP::String filename(path.filename().string().c_str());
+        uint32_t processId = 0;
+        if (!std::experimental::filesystem::is_regular_file(file.status()) ||
+            !ParseLogFileProcessId(filename, data.m_filenamePrefix, processId) ||
+            processId == data.m_processId ||
+            IP::System::IsProcessRunning(processId))
+        {
+            continue;
+        }
+
+        abandonedFiles.push_back(path);
+    }
+
+    for (const auto& path : abandonedFiles)
+    {
+        if (data.m_shutdown)
+        {
+            return;
+        }
+
+        ArchiveLogFile(data, path);
+    }
+}
+
+static void LogArchiverThreadFunction(const std::shared_ptr<LogArchiverThreadData>& data)
+{
+    std::shared_ptr<LogArchiverThreadData> threadData = data;
+
+    IP::System::LowerCurrentThreadPriority();
+
+    ArchiveAbandonedLogFiles(*threadData);
+    CompressArchivedLogFiles(*threadData);
+    EnforceRetention(*threadData);
+
+    while (true)
+    {
+        std::experimental::filesystem::path logFile;
+        bool hasFile = false;
+
+        {
+            std::unique_lock<std::mutex> lock(threadData->m_queueLock);
+            threadData->m_queueSignal.wait_for(lock, threadData->m_policy.m_maintenanceInterval, [&](){ return !threadData->m_pendingFiles.empty() || threadData->m_shutdown; });
+
+            // anything still queued at shutdown stays where it is and is archived at the next startup
+            if (threadData->m_shutdown)
+            {
+                break;
+            }
+
+            if (!threadData->m_pendingFiles.empty())
+            {
+                logFile = threadData->m_pendingFiles.front();
+                threadData->m_pendingFiles.pop_front();
+                hasFile = true;
+            }
+        }
+
+        if (hasFile)
+        {
+            ArchiveLogFile(*threadData, logFile);
+        }
+
+        EnforceRetention(*threadData);
+    }
+}
+
+LogArchiver::LogArchiver(const std::experimental::filesystem::path& logDirectory, const IP::String& filenamePrefix, const LogArchivePolicy& policy) :
+    m_threadData(IP::MakeShared<LogArchiverThreadData>(MEMORY_TAG, logDirectory, filenamePrefix, policy)),
+    m_backgroundThread(IP::MakeUnique<std::thread>(MEMORY_TAG, LogArchiverThreadFunction, m_threadData))
+{
+}
+
+LogArchiver::~LogArchiver()
+{
+    if (m_threadData)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_threadData->m_queueLock);
+            m_threadData->m_shutdown = true;
+        }
+
+        m_threadData->m_queueSignal.notify_one();
+    }
+
+    if (m_backgroundThread)
+    {
+        m_backgroundThread->join();
+    }
+}
+
+void LogArchiver::ArchiveFile(const std::experimental::filesystem::path& logFile)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_threadData->m_queueLock);
+        m_threadData->m_pendingFiles.push_back(logFile);
+    }
+
+    m_threadData->m_queueSignal.notify_one();
+}
+
+} // namespace Logging
+} // namespace IP
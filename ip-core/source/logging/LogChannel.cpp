@@ -0,0 +1,73 @@
+#include <ip/core/logging/LogChannel.h>
+
+#include <stddef.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+static_assert(static_cast<size_t>(LogChannel::Count) <= 8, "Log channel level masks are packed into 64 bits");
+static_assert(static_cast<size_t>(LogLevel::None) <= 8, "Log levels must fit in a channel's byte");
+
+static const char* s_logChannelNames[] = {
+    "General",
+    "Render",
+    "Vulkan",
+    "Memory",
+    "IO"
+};
+
+// levels at and above level, as the byte for one channel
+static constexpr uint64_t BuildChannelLevelMask(LogLevel level)
+{
+    return (0xFFULL << static_cast<uint32_t>(level)) & ((1ULL << static_cast<uint32_t>(LogLevel::None)) - 1);
+}
+
+static constexpr uint64_t BuildDefaultChannelLevelMasks()
+{
+    uint64_t masks = 0;
+    for (uint32_t channel = 0; channel < static_cast<uint32_t>(LogChannel::Count); ++channel)
+    {
+        masks |= BuildChannelLevelMask(LogLevel::Debug) << (channel * 8);
+    }
+
+    return masks;
+}
+
+std::atomic<uint64_t> g_logChannelLevelMasks(BuildDefaultChannelLevelMasks());
+
+const char* GetLogChannelName(LogChannel channel)
+{
+    return s_logChannelNames[static_cast<int>(channel)];
+}
+
+LogLevel GetLogChannelLevel(LogChannel channel)
+{
+    uint64_t channelMask = (g_logChannelLevelMasks.load() >> (static_cast<uint32_t>(channel) * 8)) & 0xFF;
+
+    for (uint32_t level = 0; level < static_cast<uint32_t>(LogLevel::None); ++level)
+    {
+        if (channelMask & (1ULL << level))
+        {
+            return static_cast<LogLevel>(level);
+        }
+    }
+
+    return LogLevel::None;
+}
+
+void SetLogChannelLevel(LogChannel channel, LogLevel level)
+{
+    uint32_t shift = static_cast<uint32_t>(channel) * 8;
+
+    uint64_t masks = g_logChannelLevelMasks.load();
+    uint64_t updatedMasks;
+    do
+    {
+        updatedMasks = (masks & ~(0xFFULL << shift)) | (BuildChannelLevelMask(level) << shift);
+    } while (!g_logChannelLevelMasks.compare_exchange_weak(masks, updatedMasks));
+}
+
+} // namespace Logging
+} // namespace IP
@@ -1,55 +1,113 @@
 #include <ip/core/logging/LogEntry.h>
 
+#include <ip/core/logging/LogTextPool.h>
+#include <ip/core/utils/SystemUtils.h>
+
 namespace IP
 {
 namespace Logging
 {
 
 LogEntry::LogEntry() :
+    m_level(LogLevel::None),
+    m_channel(LogChannel::General),
     m_levelName(""),
     m_text(""),
-    m_time()
+    m_time(),
+    m_threadId(IP::System::GetCurrentThreadId()),
+    m_site(nullptr),
+    m_fields()
 {
 }
 
-LogEntry::LogEntry(const char* levelName, IP::String&& text, IP::Time::SystemTimePoint time) :
-    m_levelName(levelName),
+LogEntry::LogEntry(LogLevel level, IP::String&& text, IP::Time::SystemTimePoint time) :
+    m_level(level),
+    m_channel(LogChannel::General),
+    m_levelName(GetLogLevelName(level)),
     m_text(std::move(text)),
-    m_time(time)
+    m_time(time),
+    m_threadId(IP::System::GetCurrentThreadId()),
+    m_site(nullptr),
+    m_fields()
 {
 }
 
 LogEntry::LogEntry(const LogEntry& entry) :
+    m_level(entry.m_level),
+    m_channel(entry.m_channel),
     m_levelName(entry.m_levelName),
     m_text(entry.m_text),
-    m_time(entry.m_time)
+    m_time(entry.m_time),
+    m_threadId(entry.m_threadId),
+    m_site(entry.m_site),
+    m_fields(entry.m_fields)
 {
 }
 
-LogEntry::LogEntry(LogEntry&& entry) :
+LogEntry::LogEntry(LogEntry&& entry) noexcept :
+    m_level(entry.m_level),
+    m_channel(entry.m_channel),
     m_levelName(entry.m_levelName),
     m_text(std::move(entry.m_text)),
-    m_time(entry.m_time)
+    m_time(entry.m_time),
+    m_threadId(entry.m_threadId),
+    m_site(entry.m_site),
+    m_fields(std::move(entry.m_fields))
 {
 }
 
+LogEntry::~LogEntry()
+{
+    ReleaseLogText(std::move(m_text));
+}
+
 LogEntry& LogEntry::operator =(const LogEntry& entry)
 {
+    m_level = entry.m_level;
+    m_channel = entry.m_channel;
     m_levelName = entry.m_levelName;
     m_text = entry.m_text;
     m_time = entry.m_time;
+    m_threadId = entry.m_threadId;
+    m_site = entry.m_site;
+    m_fields = entry.m_fields;
 
     return *this;
 }
 
-LogEntry& LogEntry::operator =(LogEntry&& entry)
+LogEntry& LogEntry::operator =(LogEntry&& entry) noexcept
 {
+    m_level = entry.m_level;
+    m_channel = entry.m_channel;
     m_levelName = entry.m_levelName;
+    ReleaseLogText(std::move(m_text));
     m_text = std::move(entry.m_text);
     m_time = entry.m_time;
+    m_threadId = entry.m_threadId;
+    m_site = entry.m_site;
+    m_fields = std::move(entry.m_fields);
 
     return *this;
 }
 
+void AppendLogMessage(IP::String& buffer, const LogEntry& entry)
+{
+    if (entry.m_site == nullptr)
+    {
+        buffer.append(entry.m_text);
+        return;
+    }
+
+    buffer.append(entry.m_site->m_message);
+
+    for (const auto& field : entry.m_fields)
+    {
+        buffer.push_back(' ');
+        buffer.append(field.m_key);
+        buffer.push_back('=');
+        AppendLogFieldValue(buffer, field);
+    }
+}
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <ip/core/logging/LogField.h>
+
+#include <ip/core/utils/StringUtils.h>
+
+#include <charconv>
+
+namespace IP
+{
+namespace Logging
+{
+
+LogField::LogField() :
+    m_key(""),
+    m_type(LogFieldType::Int),
+    m_int(0),
+    m_string()
+{
+}
+
+LogField::LogField(const char* key, bool value) :
+    m_key(key),
+    m_type(LogFieldType::Bool),
+    m_bool(value),
+    m_string()
+{
+}
+
+LogField::LogField(const char* key, const char* value) :
+    m_key(key),
+    m_type(LogFieldType::String),
+    m_uint(0),
+    m_string(value)
+{
+}
+
+LogField::LogField(const char* key, const IP::String& value) :
+    m_key(key),
+    m_type(LogFieldType::String),
+    m_uint(0),
+    m_string(value)
+{
+}
+
+LogField::LogField(const char* key, IP::String&& value) :
+    m_key(key),
+    m_type(LogFieldType::String),
+    m_uint(0),
+    m_string(std::move(value))
+{
+}
+
+void AppendLogFieldValue(IP::String& buffer, const LogField& field)
+{
+    char digits[32];
+    std::to_chars_result result = { digits, std::errc() };
+
+    switch (field.m_type)
+    {
+        case LogFieldType::Int:
+            result = std::to_chars(digits, digits + sizeof(digits), field.m_int);
+            break;
+
+        case LogFieldType::UInt:
+            result = std::to_chars(digits, digits + sizeof(digits), field.m_uint);
+            break;
+
+        case LogFieldType::Double:
+            result = std::to_chars(digits, digits + sizeof(digits), field.m_double);
+            break;
+
+        case LogFieldType::Bool:
+            buffer.append(field.m_bool ? "true" : "false");
+            return;
+
+        case LogFieldType::String:
+            buffer.append(field.m_string);
+            return;
+    }
+
+    buffer.append(digits, result.ptr);
+}
+
+} // namespace Logging
+} // namespace IP
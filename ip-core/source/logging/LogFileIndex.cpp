@@ -0,0 +1,222 @@
+#include <ip/core/logging/LogFileIndex.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+#include <type_traits>
+
+#include <ip/core/debug/IPException.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+static_assert(std::is_trivially_copyable<LogIndexBucket>::value, "LogIndexBucket is written to disk as-is");
+
+static int64_t ToIndexTime(IP::Time::SystemTimePoint time)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+std::experimental::filesystem::path BuildLogIndexFileName(const std::experimental::filesystem::path& logFile)
+{
+    std::experimental::filesystem::path indexFile(logFile);
+    indexFile += LOG_INDEX_FILE_EXTENSION;
+
+    return indexFile;
+}
+
+LogFileIndexWriter::LogFileIndexWriter() :
+    m_indexFile(),
+    m_bucket(),
+    m_entryLengths(),
+    m_entryLevels(),
+    m_bucketPeriod(0),
+    m_bucketOpen(false)
+{
+}
+
+LogFileIndexWriter::~LogFileIndexWriter()
+{
+    Close();
+}
+
+bool LogFileIndexWriter::Open(const std::experimental::filesystem::path& logFile)
+{
+    Close();
+
+    if (!m_indexFile.Open(BuildLogIndexFileName(logFile)))
+    {
+        return false;
+    }
+
+    return m_indexFile.Write(LOG_INDEX_MAGIC, sizeof(LOG_INDEX_MAGIC));
+}
+
+void LogFileIndexWriter::Close()
+{
+    if (m_bucketOpen)
+    {
+        WriteBucket();
+    }
+
+    m_indexFile.Close();
+}
+
+void LogFileIndexWriter::Abandon()
+{
+    m_bucketOpen = false;
+    m_indexFile.Close();
+}
+
+void LogFileIndexWriter::AddLine(IP::Time::SystemTimePoint time, LogLevel level, uint64_t startOffset, uint64_t endOffset)
+{
+    if (!m_indexFile.IsOpen())
+    {
+        return;
+    }
+
+    // buckets cover aligned periods so a query for whole seconds or minutes gets exactly their lines; a late entry
+    // from an earlier period stays in the current bucket, which widens its time range instead
+    int64_t indexTime = ToIndexTime(time);
+    int64_t period = indexTime / LOG_INDEX_BUCKET_DURATION.count();
+    if (m_bucketOpen && period > m_bucketPeriod)
+    {
+        WriteBucket();
+    }
+
+    if (!m_bucketOpen)
+    {
+        memset(&m_bucket, 0, sizeof(m_bucket));
+        m_entryLengths.clear();
+        m_entryLevels.clear();
+        m_bucketPeriod = period;
+        m_bucket.m_firstTime = indexTime;
+        m_bucket.m_lastTime = indexTime;
+        m_bucket.m_startOffset = startOffset;
+        m_bucketOpen = true;
+    }
+
+    m_bucket.m_firstTime = std::min(m_bucket.m_firstTime, indexTime);
+    m_bucket.m_lastTime = std::max(m_bucket.m_lastTime, indexTime);
+    m_bucket.m_endOffset = endOffset;
+    m_bucket.m_entryCount++;
+    m_entryLengths.push_back(static_cast<uint32_t>(endOffset - startOffset));
+    m_entryLevels.push_back(static_cast<uint8_t>(level));
+
+    size_t levelIndex = static_cast<size_t>(level);
+    if (levelIndex < LOG_INDEX_LEVEL_COUNT)
+    {
+        m_bucket.m_levelCounts[levelIndex]++;
+    }
+}
+
+void LogFileIndexWriter::WriteBucket()
+{
+    m_indexFile.Write(&m_bucket, sizeof(m_bucket));
+    m_indexFile.Write(m_entryLengths.data(), m_entryLengths.size() * sizeof(uint32_t));
+    m_indexFile.Write(m_entryLevels.data(), m_entryLevels.size() * sizeof(uint8_t));
+    m_bucketOpen = false;
+}
+
+LogIndex ReadLogIndex(const std::experimental::filesystem::path& indexFile)
+{
+    std::ifstream input(indexFile.c_str(), std::ios::binary);
+    if (!input)
+    {
+        THROW_IP_EXCEPTION("Unable to open log index ", indexFile.string().c_str());
+    }
+
+    char magic[sizeof(LOG_INDEX_MAGIC)] = {};
+    if (!input.read(magic, sizeof(magic)) || memcmp(magic, LOG_INDEX_MAGIC, sizeof(LOG_INDEX_MAGIC)))
+    {
+        THROW_IP_EXCEPTION("Not a log index: ", indexFile.string().c_str());
+    }
+
+    input.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(input.tellg());
+    input.seekg(sizeof(LOG_INDEX_MAGIC), std::ios::beg);
+
+    // a partially written trailing bucket is ignored, as is one whose entry count is more than the file could hold
+    LogIndex index;
+    LogIndexBucket bucket;
+    while (input.read(reinterpret_cast<char*>(&bucket), sizeof(bucket)))
+    {
+        uint64_t remainingBytes = fileSize - static_cast<uint64_t>(input.tellg());
+        if (bucket.m_entryCount > remainingBytes / (sizeof(uint32_t) + sizeof(uint8_t)))
+        {
+            break;
+        }
+
+        size_t firstEntry = index.m_entryLengths.size();
+        index.m_entryLengths.resize(firstEntry + bucket.m_entryCount);
+        index.m_entryLevels.resize(firstEntry + bucket.m_entryCount);
+
+        if (!input.read(reinterpret_cast<char*>(index.m_entryLengths.data() + firstEntry), bucket.m_entryCount * sizeof(uint32_t)) ||
+            !input.read(reinterpret_cast<char*>(index.m_entryLevels.data() + firstEntry), bucket.m_entryCount * sizeof(uint8_t)))
+        {
+            index.m_entryLengths.resize(firstEntry);
+            index.m_entryLevels.resize(firstEntry);
+            break;
+        }
+
+        index.m_buckets.push_back(bucket);
+    }
+
+    return index;
+}
+
+static void AddLogFileRange(IP::Vector<LogFileRange>& ranges, uint64_t startOffset, uint64_t endOffset)
+{
+    if (!ranges.empty() && ranges.back().m_endOffset == startOffset)
+    {
+        ranges.back().m_endOffset = endOffset;
+    }
+    else
+    {
+        ranges.push_back({ startOffset, endOffset });
+    }
+}
+
+IP::Vector<LogFileRange> FindLogIndexRanges(const LogIndex& index, int64_t fromTime, int64_t toTime, LogLevel minimumLevel)
+{
+    IP::Vector<LogFileRange> ranges;
+
+    size_t firstEntry = 0;
+    for (const auto& bucket : index.m_buckets)
+    {
+        size_t endEntry = firstEntry + bucket.m_entryCount;
+        bool inTime = bucket.m_lastTime >= fromTime && bucket.m_firstTime <= toTime;
+
+        // the level counts rule out most buckets without walking their entries
+        bool hasLevel = false;
+        for (size_t level = static_cast<size_t>(minimumLevel); level < LOG_INDEX_LEVEL_COUNT; ++level)
+        {
+            hasLevel = hasLevel || bucket.m_levelCounts[level] > 0;
+        }
+
+        if (inTime && hasLevel)
+        {
+            uint64_t offset = bucket.m_startOffset;
+            for (size_t entry = firstEntry; entry < endEntry; ++entry)
+            {
+                uint64_t endOffset = offset + index.m_entryLengths[entry];
+                uint8_t level = index.m_entryLevels[entry];
+                if (level < LOG_INDEX_LEVEL_COUNT && level >= static_cast<uint8_t>(minimumLevel))
+                {
+                    AddLogFileRange(ranges, offset, endOffset);
+                }
+
+                offset = endOffset;
+            }
+        }
+
+        firstEntry = endEntry;
+    }
+
+    return ranges;
+}
+
+} // namespace Logging
+} // namespace IP
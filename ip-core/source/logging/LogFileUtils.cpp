@@ -0,0 +1,155 @@
+#include <ip/core/logging/LogFileUtils.h>
+
+#include <ip/core/debug/IPException.h>
+#include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/utils/SystemUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+static const char* LOG_ARCHIVE_DIRECTORY = "archive";
+
+IP::Time::SystemTimePoint ComputeLogFileInterval(IP::Time::SystemTimePoint timePoint)
+{
+    return std::chrono::time_point_cast<std::chrono::hours>(timePoint);
+}
+
+std::experimental::filesystem::path BuildLogArchiveDirectoryName(const std::experimental::filesystem::path& directory)
+{
+    std::experimental::filesystem::path archivePath(directory);
+    archivePath.append(LOG_ARCHIVE_DIRECTORY);
+
+    return archivePath;
+}
+
+IP::String BuildProcessLogFilePrefix(const IP::String& filenamePrefix)
+{
+    return filenamePrefix + "_" + IP::System::GetProcessId() + "_";
+}
+
+bool ParseLogFileProcessId(const IP::String& filename, const IP::String& filenamePrefix, uint32_t& processId)
+{
+    size_t position = filenamePrefix.size();
+    if (filename.compare(0, position, filenamePrefix) != 0 || position >= filename.size() || filename[position] != '_')
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+    size_t digits = 0;
+    for (++position; position < filename.size() && filename[position] >= '0' && filename[position] <= '9'; ++position, ++digits)
+    {
+        value = value * 10 + static_cast<uint64_t>(filename[position] - '0');
+        if (value > UINT32_MAX)
+        {
+            return false;
+        }
+    }
+
+    if (digits == 0 || position >= filename.size() || filename[position] != '_')
+    {
+        return false;
+    }
+
+    processId = static_cast<uint32_t>(value);
+    return true;
+}
+
+std::experimental::filesystem::path BuildLogFileName(const std::experimental::filesystem::path& directory, const IP::String& filenamePrefix, IP::Time::SystemTimePoint logInterval, uint32_t sequence, const char* extension)
+{
+    IP::StringStream filename;
+    filename << BuildProcessLogFilePrefix(filenamePrefix);
+
+    filename << IP::Time::ConvertSystemTimeToFileSuffix(logInterval);
+    if (sequence > 0)
+    {
+        filename << "_" << sequence;
+    }
+
+    filename << extension;
+
+    std::experimental::filesystem::path fullPath(directory);
+    fullPath.append(filename.str());
+
+    return fullPath;
+}
+
+void InitializeLogDirectories(const std::experimental::filesystem::path& directory)
+{
+    // Create base directory if necessary
+    if (!std::experimental::filesystem::is_directory(directory))
+    {
+        if (!std::experimental::filesystem::exists(directory))
+        {
+            std::experimental::filesystem::create_directory(directory);
+        }
+        else
+        {
+            THROW_IP_EXCEPTION("Log directory exists and is not a directory: ", directory.c_str());
+        }
+    }
+
+    // Create archive directory if necessary
+    std::experimental::filesystem::path archivePath = BuildLogArchiveDirectoryName(directory);
+
+    if (!std::experimental::filesystem::is_directory(archivePath))
+    {
+        if (!std::experimental::filesystem::exists(archivePath))
+        {
+            std::experimental::filesystem::create_directory(archivePath);
+        }
+        else
+        {
+            THROW_IP_EXCEPTION("Log archive directory exists and is not a directory: ", archivePath.c_str());
+        }
+    }
+}
+
+LogFileRoller::LogFileRoller(const std::experimental::filesystem::path& directory, const IP::String& filenamePrefix, const LogRollPolicy& policy, const char* extension) :
+    m_directory(directory),
+    m_filenamePrefix(filenamePrefix),
+    m_policy(policy),
+    m_extension(extension),
+    m_hasFile(false),
+    m_interval(),
+    m_sequence(0)
+{
+}
+
+bool LogFileRoller::ShouldRoll(IP::Time::SystemTimePoint currentTime, uint64_t currentFileBytes) const
+{
+    if (!m_hasFile)
+    {
+        return true;
+    }
+
+    if (m_policy.m_maxFileBytes > 0 && currentFileBytes >= m_policy.m_maxFileBytes)
+    {
+        return true;
+    }
+
+    return m_policy.m_rollHourly && ComputeLogFileInterval(currentTime) != m_interval;
+}
+
+std::experimental::filesystem::path LogFileRoller::Roll(IP::Time::SystemTimePoint currentTime)
+{
+    IP::Time::SystemTimePoint interval = ComputeLogFileInterval(currentTime);
+    if (m_hasFile && interval == m_interval)
+    {
+        ++m_sequence;
+    }
+    else
+    {
+        m_sequence = 0;
+    }
+
+    m_hasFile = true;
+    m_interval = interval;
+
+    return BuildLogFileName(m_directory, m_filenamePrefix, m_interval, m_sequence, m_extension);
+}
+
+} // namespace Logging
+} // namespace IP
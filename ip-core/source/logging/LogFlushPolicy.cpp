@@ -0,0 +1,17 @@
+#include <ip/core/logging/LogFlushPolicy.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+LogFlushPolicy::LogFlushPolicy() :
+    m_maxBufferedBytes(64 * 1024),
+    m_maxBufferedTime(250),
+    m_immediateFlushLevel(LogLevel::Error),
+    m_syncInterval(0)
+{
+}
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,29 @@
+#include <ip/core/logging/LogQueuePolicy.h>
+
+#include <algorithm>
+
+namespace IP
+{
+namespace Logging
+{
+
+LogQueuePolicy::LogQueuePolicy() :
+    m_capacity(64 * 1024),
+    m_overflowPolicy(LogOverflowPolicy::DropNewest),
+    m_blockTimeout(10),
+    m_sampleLevel(LogLevel::Warn),
+    m_sampleInterval(16),
+    m_dropReportInterval(10000)
+{
+}
+
+LogQueuePolicy ClampLogQueuePolicy(const LogQueuePolicy& policy)
+{
+    LogQueuePolicy clamped = policy;
+    clamped.m_sampleInterval = std::max<uint32_t>(clamped.m_sampleInterval, 1);
+
+    return clamped;
+}
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,46 @@
+#include <ip/core/logging/LogRecord.h>
+
+#include <ip/core/logging/LogTextPool.h>
+
+#include <string.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+LogRecord::LogRecord(LogEntry&& entry) :
+    m_entry(std::move(entry)),
+    m_renderings()
+{
+}
+
+LogRecord::~LogRecord()
+{
+    // renderings come from the text pool, like entry text
+    for (auto& rendering : m_renderings)
+    {
+        ReleaseLogText(std::move(rendering.m_line));
+    }
+}
+
+void LogRecord::AddRendering(const char* formatSignature, IP::String&& line)
+{
+    m_renderings.push_back({ formatSignature, std::move(line) });
+}
+
+const IP::String* LogRecord::FindRendering(const char* formatSignature) const
+{
+    for (const auto& rendering : m_renderings)
+    {
+        if (!strcmp(rendering.m_formatSignature, formatSignature))
+        {
+            return &rendering.m_line;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace Logging
+} // namespace IP
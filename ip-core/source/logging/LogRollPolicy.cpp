@@ -0,0 +1,15 @@
+#include <ip/core/logging/LogRollPolicy.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+LogRollPolicy::LogRollPolicy() :
+    m_rollHourly(true),
+    m_maxFileBytes(0)
+{
+}
+
+} // namespace Logging
+} // namespace IP
@@ -18,5 +18,11 @@ LogScope::~LogScope()
     IP::Logging::Shutdown();
 }
 
+void LogScope::Replace(IP::UniquePtr<ILogger> &&logger)
+{
+    IP::Logging::SwapLogger(logger.get());
+    m_logger = std::move(logger);
+}
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include <ip/core/logging/LogSite.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+static std::atomic<uint32_t> s_nextLogSiteId(1);
+
+uint32_t GetLogSiteId(LogSite& site)
+{
+    uint32_t id = site.m_id.load(std::memory_order_acquire);
+    if (id != 0)
+    {
+        return id;
+    }
+
+    // racing threads may burn an id, which only leaves a gap
+    uint32_t newId = s_nextLogSiteId.fetch_add(1, std::memory_order_relaxed);
+    if (site.m_id.compare_exchange_strong(id, newId, std::memory_order_acq_rel))
+    {
+        return newId;
+    }
+
+    return id;
+}
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,107 @@
+#include <ip/core/logging/LogStream.h>
+
+#include <ip/core/logging/LogTextPool.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+LogStreamBuf::LogStreamBuf() :
+    std::streambuf(),
+    m_text(AcquireLogText())
+{
+}
+
+LogStreamBuf::~LogStreamBuf()
+{
+    ReleaseLogText(std::move(m_text));
+}
+
+IP::String LogStreamBuf::TakeText()
+{
+    IP::String text = std::move(m_text);
+    m_text = AcquireLogText();
+
+    return text;
+}
+
+void LogStreamBuf::Clear()
+{
+    m_text.clear();
+}
+
+LogStreamBuf::int_type LogStreamBuf::overflow(int_type character)
+{
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+    {
+        m_text.push_back(traits_type::to_char_type(character));
+    }
+
+    return traits_type::not_eof(character);
+}
+
+std::streamsize LogStreamBuf::xsputn(const char* text, std::streamsize length)
+{
+    m_text.append(text, static_cast<size_t>(length));
+
+    return length;
+}
+
+LogStream::LogStream() :
+    std::ostream(nullptr),
+    m_buffer()
+{
+    rdbuf(&m_buffer);
+}
+
+LogStream::~LogStream()
+{
+}
+
+void LogStream::Reset()
+{
+    m_buffer.Clear();
+    clear();
+    flags(std::ios_base::dec | std::ios_base::skipws);
+    precision(6);
+    width(0);
+    fill(' ');
+}
+
+static thread_local bool s_threadStreamInUse = false;
+
+static LogStream& GetThreadLogStream()
+{
+    static thread_local LogStream stream;
+
+    return stream;
+}
+
+LogStreamScope::LogStreamScope() :
+    m_nestedStream(),
+    m_stream(nullptr)
+{
+    if (s_threadStreamInUse)
+    {
+        m_nestedStream = IP::MakeUnique<LogStream>(MEMORY_TAG);
+        m_stream = m_nestedStream.get();
+        return;
+    }
+
+    s_threadStreamInUse = true;
+    m_stream = &GetThreadLogStream();
+    m_stream->Reset();
+}
+
+LogStreamScope::~LogStreamScope()
+{
+    // anything left untaken, e.g. because the streamed expression threw, is cleared by the next scope
+    if (!m_nestedStream)
+    {
+        s_threadStreamInUse = false;
+    }
+}
+
+} // namespace Logging
+} // namespace IP
@@ -2,44 +2,154 @@
 #include <ip/core/logging/LogSystem.h>
 
 #include <atomic>
+#include <mutex>
+#include <thread>
 
+#include <ip/core/logging/FlightRecorder.h>
 #include <ip/core/logging/ILogger.h>
+#include <ip/core/logging/LogChannel.h>
+#include <ip/core/logging/LogEntry.h>
 #include <ip/core/logging/LogLevel.h>
+#include <ip/core/logging/RateLimitedLogging.h>
 
 namespace IP
 {
 namespace Logging
 {
 
-static std::atomic<LogLevel> s_logLevel(LogLevel::Debug);
 static std::atomic<ILogger*> s_logger(nullptr);
 
+// The logger is reclaimed RCU style: readers announce themselves in a reader counter for the current epoch parity
+// before loading s_logger, and a swap flips the epoch twice, waiting each time for the counters of the previous parity
+// to drain.  Readers are spread over cache line sized stripes so concurrent Log calls don't contend on one counter.
+static const size_t READER_STRIPE_COUNT = 16;
+
+struct alignas(64) ReaderStripe
+{
+    std::atomic<uint32_t> m_count;
+};
+
+static ReaderStripe s_readers[2][READER_STRIPE_COUNT];
+static std::atomic<uint32_t> s_epoch(0);
+static std::atomic<uint32_t> s_nextReaderStripe(0);
+static std::mutex s_swapMutex;
+
+static size_t GetReaderStripe()
+{
+    static thread_local size_t stripe = s_nextReaderStripe.fetch_add(1, std::memory_order_relaxed) % READER_STRIPE_COUNT;
+
+    return stripe;
+}
+
+class LoggerReadGuard
+{
+    public:
+
+        LoggerReadGuard() :
+            m_counter(s_readers[s_epoch.load() & 1][GetReaderStripe()].m_count)
+        {
+            m_counter.fetch_add(1);
+        }
+
+        ~LoggerReadGuard()
+        {
+            m_counter.fetch_sub(1, std::memory_order_release);
+        }
+
+        // only valid for the lifetime of the guard
+        ILogger* GetLogger() const
+        {
+            return s_logger.load();
+        }
+
+    private:
+
+        std::atomic<uint32_t>& m_counter;
+};
+
+static void WaitForReaders(uint32_t parity)
+{
+    for (ReaderStripe& stripe : s_readers[parity])
+    {
+        while (stripe.m_count.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+ILogger* SwapLogger(ILogger* logger)
+{
+    std::lock_guard<std::mutex> lock(s_swapMutex);
+
+    ILogger* previous = s_logger.exchange(logger);
+
+    // a reader may have read the epoch before the previous swap's flips, so drain both parities
+    for (int flip = 0; flip < 2; ++flip)
+    {
+        uint32_t previousEpoch = s_epoch.fetch_add(1);
+        WaitForReaders(previousEpoch & 1);
+    }
+
+    return previous;
+}
+
 void Initialize(ILogger* logger)
 {
-    s_logger = logger;
+    SwapLogger(logger);
 }
 
 void Shutdown()
 {
-    s_logger = nullptr;
+    ReportRepeatedMessages();
+    SwapLogger(nullptr);
 }
 
 void Log(LogEntry&& entry)
 {
-    if (s_logger != nullptr)
+    RecordFlightRecorderEntry(entry);
+
+    if (!IsLogChannelEnabled(entry.m_channel, entry.m_level))
+    {
+        return;
+    }
+
+    bool fatal = entry.m_level == LogLevel::Fatal;
+
+    {
+        LoggerReadGuard guard;
+        ILogger* logger = guard.GetLogger();
+        if (logger != nullptr)
+        {
+            logger->Log(std::move(entry));
+        }
+    }
+
+    if (fatal)
+    {
+        Flush();
+        DumpFlightRecorder("fatal log entry");
+    }
+}
+
+void Flush()
+{
+    LoggerReadGuard guard;
+    ILogger* logger = guard.GetLogger();
+    if (logger != nullptr)
     {
-        s_logger.load()->Log(std::move(entry));
+        logger->Flush();
     }
 }
 
 LogLevel GetLogLevel()
 {
-    return s_logLevel.load();
+    return GetLogChannelLevel(LogChannel::General);
 }
 
 void SetLogLevel(LogLevel level)
 {
-    s_logLevel.store(level);
+    SetLogChannelLevel(LogChannel::General, level);
 }
 
 
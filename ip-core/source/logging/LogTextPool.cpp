@@ -0,0 +1,173 @@
+#include <ip/core/logging/LogTextPool.h>
+
+#include <mutex>
+
+#include <ip/core/memory/stl/Vector.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// every string handed out has at least this much room, so typical lines don't regrow while being formatted; smaller
+// strings are freed rather than pooled, since a warm thread handed one would have to grow it
+static const size_t MIN_POOLED_CAPACITY = 256;
+
+// strings larger than this are freed rather than pooled, so one huge entry doesn't pin its buffer forever
+static const size_t MAX_POOLED_CAPACITY = 4096;
+
+static const size_t THREAD_CACHE_SIZE = 32;
+static const size_t TRANSFER_BATCH_SIZE = THREAD_CACHE_SIZE / 2;
+// The depot keeps every string it's given rather than capping itself, since a cap below the number of entries a queue
+// can hold would run the pool dry on every backlog.  It stays bounded anyway: pooled strings only exist because that
+// many entries were once in flight at the same time.
+static const size_t INITIAL_DEPOT_RESERVE = 16384;
+
+class LogTextDepot
+{
+    public:
+
+        LogTextDepot() :
+            m_lock(),
+            m_strings()
+        {
+            m_strings.reserve(INITIAL_DEPOT_RESERVE);
+        }
+
+        // moves up to count strings into destination, returning how many were moved
+        size_t Take(IP::String* destination, size_t count)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            size_t taken = 0;
+            while (taken < count && !m_strings.empty())
+            {
+                destination[taken++] = std::move(m_strings.back());
+                m_strings.pop_back();
+            }
+
+            return taken;
+        }
+
+        void Give(IP::String* source, size_t count)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_strings.push_back(std::move(source[i]));
+            }
+        }
+
+    private:
+
+        std::mutex m_lock;
+        IP::Vector<IP::String> m_strings;
+};
+
+static LogTextDepot& GetLogTextDepot()
+{
+    static LogTextDepot depot;
+
+    return depot;
+}
+
+class LogTextThreadCache
+{
+    public:
+
+        LogTextThreadCache() :
+            m_count(0)
+        {
+            // make sure the depot outlives every thread's cache
+            GetLogTextDepot();
+        }
+
+        ~LogTextThreadCache()
+        {
+            GetLogTextDepot().Give(m_strings, m_count);
+            s_destroyed = true;
+        }
+
+        IP::String Acquire()
+        {
+            if (m_count == 0)
+            {
+                m_count = GetLogTextDepot().Take(m_strings, TRANSFER_BATCH_SIZE);
+                if (m_count == 0)
+                {
+                    return IP::String();
+                }
+            }
+
+            return std::move(m_strings[--m_count]);
+        }
+
+        void Release(IP::String&& text)
+        {
+            if (m_count == THREAD_CACHE_SIZE)
+            {
+                m_count -= TRANSFER_BATCH_SIZE;
+                GetLogTextDepot().Give(m_strings + m_count, TRANSFER_BATCH_SIZE);
+                for (size_t i = m_count; i < THREAD_CACHE_SIZE; ++i)
+                {
+                    IP::String().swap(m_strings[i]);
+                }
+            }
+
+            text.clear();
+            m_strings[m_count++] = std::move(text);
+        }
+
+        // entries can still be destroyed by other thread_local objects after the cache is gone
+        static thread_local bool s_destroyed;
+
+    private:
+
+        IP::String m_strings[THREAD_CACHE_SIZE];
+        size_t m_count;
+};
+
+thread_local bool LogTextThreadCache::s_destroyed = false;
+
+static LogTextThreadCache* GetLogTextThreadCache()
+{
+    if (LogTextThreadCache::s_destroyed)
+    {
+        return nullptr;
+    }
+
+    static thread_local LogTextThreadCache cache;
+
+    return &cache;
+}
+
+IP::String AcquireLogText()
+{
+    LogTextThreadCache* cache = GetLogTextThreadCache();
+    IP::String text = cache != nullptr ? cache->Acquire() : IP::String();
+    if (text.capacity() < MIN_POOLED_CAPACITY)
+    {
+        text.reserve(MIN_POOLED_CAPACITY);
+    }
+
+    return text;
+}
+
+void ReleaseLogText(IP::String&& text)
+{
+    size_t capacity = text.capacity();
+    if (capacity < MIN_POOLED_CAPACITY || capacity > MAX_POOLED_CAPACITY)
+    {
+        return;
+    }
+
+    LogTextThreadCache* cache = GetLogTextThreadCache();
+    if (cache != nullptr)
+    {
+        cache->Release(std::move(text));
+    }
+}
+
+} // namespace Logging
+} // namespace IP
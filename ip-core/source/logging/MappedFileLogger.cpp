@@ -0,0 +1,167 @@
+#include <ip/core/logging/MappedFileLogger.h>
+
+#include <ip/core/logging/LogEntry.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+static const size_t DEFAULT_WINDOW_SIZE = 1024 * 1024;
+static const uint64_t DEFAULT_PREALLOCATION_SIZE = 16 * 1024 * 1024;
+
+static uint64_t RoundUp(uint64_t value, uint64_t multiple)
+{
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+MappedFileLogger::MappedFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory) :
+    MappedFileLogger(std::move(formatter), filenamePrefix, directory, DEFAULT_WINDOW_SIZE, DEFAULT_PREALLOCATION_SIZE, LogRollPolicy(), LogArchivePolicy())
+{
+}
+
+MappedFileLogger::MappedFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, size_t windowSize, uint64_t preallocationSize, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy) :
+    m_formatter(std::move(formatter)),
+    m_lineBuffer(),
+    m_windowSize(static_cast<size_t>(RoundUp(std::max<size_t>(windowSize, 1), IP::FileUtils::MappedFile::GetMappingGranularity()))),
+    m_preallocationSize(0),
+    m_file(),
+    m_fileName(),
+    m_window(nullptr),
+    m_windowPosition(0),
+    m_usedLength(0),
+    m_roller(directory, filenamePrefix, rollPolicy),
+    m_archiver(nullptr)
+{
+    m_preallocationSize = RoundUp(std::max<uint64_t>(preallocationSize, m_windowSize), m_windowSize);
+
+    InitializeLogDirectories(directory);
+
+    m_archiver = IP::MakeUnique<LogArchiver>(MEMORY_TAG, directory, filenamePrefix, archivePolicy);
+}
+
+MappedFileLogger::~MappedFileLogger()
+{
+    CloseLogFile();
+}
+
+void MappedFileLogger::Log(LogEntry&& entry)
+{
+    WriteEntry(entry, nullptr);
+}
+
+void MappedFileLogger::LogShared(const LogRecordPtr& record)
+{
+    WriteEntry(record->GetEntry(), record->FindRendering(m_formatter->GetFormatSignature()));
+}
+
+void MappedFileLogger::WriteEntry(const LogEntry& entry, const IP::String* renderedLine)
+{
+    RollLogFile();
+
+    if (renderedLine != nullptr)
+    {
+        Append(renderedLine->data(), renderedLine->size());
+        Append("\n", 1);
+        return;
+    }
+
+    m_lineBuffer.clear();
+    m_formatter->FormatLogLine(m_lineBuffer, entry);
+    m_lineBuffer.push_back('\n');
+
+    Append(m_lineBuffer.data(), m_lineBuffer.size());
+}
+
+void MappedFileLogger::RollLogFile()
+{
+    IP::Time::SystemTimePoint currentTime = IP::Time::GetCurrentSystemTime();
+    if (!m_roller.ShouldRoll(currentTime, m_usedLength))
+    {
+        return;
+    }
+
+    if (m_file.IsOpen())
+    {
+        CloseLogFile();
+        m_archiver->ArchiveFile(m_fileName);
+    }
+
+    m_fileName = m_roller.Roll(currentTime);
+    m_file.Open(m_fileName, IP::FileUtils::MappedFileMode::ReadWrite);
+}
+
+void MappedFileLogger::CloseLogFile()
+{
+    if (!m_file.IsOpen())
+    {
+        return;
+    }
+
+    m_file.Unmap();
+    m_file.Resize(m_usedLength);
+    m_file.Close();
+
+    m_window = nullptr;
+    m_windowPosition = 0;
+    m_usedLength = 0;
+}
+
+void MappedFileLogger::Append(const char* data, size_t length)
+{
+    while (length > 0)
+    {
+        if (m_window == nullptr || m_windowPosition == m_windowSize)
+        {
+            if (!AdvanceWindow())
+            {
+                // out of space or mapping failed; there's nowhere sensible to report it so the rest of the line is lost
+                return;
+            }
+        }
+
+        size_t copyLength = std::min(length, m_windowSize - m_windowPosition);
+        memcpy(m_window + m_windowPosition, data, copyLength);
+
+        m_windowPosition += copyLength;
+        m_usedLength += copyLength;
+        data += copyLength;
+        length -= copyLength;
+    }
+}
+
+bool MappedFileLogger::AdvanceWindow()
+{
+    if (!m_file.IsOpen())
+    {
+        return false;
+    }
+
+    // only called at a window boundary, so everything written so far ends exactly where the next window starts
+    uint64_t nextOffset = m_usedLength;
+    m_window = nullptr;
+
+    if (nextOffset + m_windowSize > m_file.GetSize())
+    {
+        if (!m_file.Resize(m_file.GetSize() + m_preallocationSize))
+        {
+            return false;
+        }
+    }
+
+    m_window = m_file.Map(nextOffset, m_windowSize);
+    if (m_window == nullptr)
+    {
+        return false;
+    }
+
+    m_windowPosition = 0;
+
+    return true;
+}
+
+} // namespace Logging
+} // namespace IP
@@ -0,0 +1,140 @@
+#include <ip/core/logging/PatternLogLineFormatter.h>
+
+#include <ip/core/debug/IPException.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/utils/StringUtils.h>
+#include <ip/core/utils/SystemUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+PatternLogLineFormatter::PatternLogLineFormatter(const char* pattern) :
+    m_pattern(pattern),
+    m_signature(IP::String("pattern:") + pattern),
+    m_literals(),
+    m_operations(),
+    m_processId(IP::System::GetProcessId()),
+    m_timeFormatter()
+{
+    CompilePattern(pattern);
+}
+
+void PatternLogLineFormatter::CompilePattern(const char* pattern)
+{
+    const char* literalStart = pattern;
+    const char* position = pattern;
+
+    while (*position != '\0')
+    {
+        if (*position != '%')
+        {
+            ++position;
+            continue;
+        }
+
+        AddLiteral(literalStart, position - literalStart);
+
+        char field = position[1];
+        PatternOperationType type = PatternOperationType::Literal;
+        switch (field)
+        {
+            case 'T': type = PatternOperationType::TimeOfDay; break;
+            case 'e': type = PatternOperationType::Milliseconds; break;
+            case 'D': type = PatternOperationType::Date; break;
+            case 'l': type = PatternOperationType::Level; break;
+            case 'c': type = PatternOperationType::Channel; break;
+            case 't': type = PatternOperationType::ThreadId; break;
+            case 'P': type = PatternOperationType::ProcessId; break;
+            case 'v': type = PatternOperationType::Message; break;
+            case '%': AddLiteral("%", 1); break;
+            case '\0': THROW_IP_EXCEPTION("Log pattern ends in the middle of a field: ", pattern);
+            default: THROW_IP_EXCEPTION("Unknown log pattern field %", field, " in ", pattern);
+        }
+
+        if (type != PatternOperationType::Literal)
+        {
+            m_operations.push_back({ type, 0, 0 });
+        }
+
+        position += 2;
+        literalStart = position;
+    }
+
+    AddLiteral(literalStart, position - literalStart);
+}
+
+void PatternLogLineFormatter::AddLiteral(const char* text, size_t length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    // text between fields, including escaped '%'s, collapses into one append
+    if (!m_operations.empty() && m_operations.back().m_type == PatternOperationType::Literal)
+    {
+        m_operations.back().m_literalLength += static_cast<uint32_t>(length);
+    }
+    else
+    {
+        m_operations.push_back({ PatternOperationType::Literal, static_cast<uint32_t>(m_literals.size()), static_cast<uint32_t>(length) });
+    }
+
+    m_literals.append(text, length);
+}
+
+void PatternLogLineFormatter::FormatLogLine(IP::String& buffer, const LogEntry& entry) const
+{
+    const char* literals = m_literals.data();
+    for (const auto& operation : m_operations)
+    {
+        switch (operation.m_type)
+        {
+            case PatternOperationType::Literal:
+                buffer.append(literals + operation.m_literalOffset, operation.m_literalLength);
+                break;
+
+            case PatternOperationType::TimeOfDay:
+                m_timeFormatter.AppendClockTime(buffer, entry.m_time);
+                break;
+
+            case PatternOperationType::Date:
+                m_timeFormatter.AppendDate(buffer, entry.m_time);
+                break;
+
+            case PatternOperationType::Milliseconds:
+                IP::Time::CachedTimeOfDayFormatter::AppendMilliseconds(buffer, entry.m_time);
+                break;
+
+            case PatternOperationType::Level:
+                buffer.append(entry.m_levelName);
+                break;
+
+            case PatternOperationType::Channel:
+                buffer.append(GetLogChannelName(entry.m_channel));
+                break;
+
+            case PatternOperationType::ThreadId:
+                IP::StringUtils::AppendZeroPaddedInteger(buffer, entry.m_threadId, 0);
+                break;
+
+            case PatternOperationType::ProcessId:
+                buffer.append(m_processId);
+                break;
+
+            case PatternOperationType::Message:
+                AppendLogMessage(buffer, entry);
+                break;
+        }
+    }
+}
+
+IP::UniquePtr<ILogLineFormatter> PatternLogLineFormatter::Clone() const
+{
+    return IP::MakeUniqueUpcast<PatternLogLineFormatter, ILogLineFormatter>(MEMORY_TAG, m_pattern.c_str());
+}
+
+} // namespace Logging
+} // namespace IP
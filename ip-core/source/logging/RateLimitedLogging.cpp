@@ -0,0 +1,87 @@
+#include <ip/core/logging/RateLimitedLogging.h>
+
+#include <ip/core/utils/TimeUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+// how often a run of repeats that's still going is reported
+static const int64_t REPEAT_REPORT_INTERVAL_MS = 10000;
+
+static std::atomic<LogDedupSite*> s_dedupSites(nullptr);
+
+static int64_t GetCurrentTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(IP::Time::GetCurrentMonotonicTime().time_since_epoch()).count();
+}
+
+bool LogEveryMsSite::ShouldLog(int64_t intervalMs, uint64_t& suppressedCount)
+{
+    int64_t currentTime = GetCurrentTimeMs();
+    int64_t nextLogTime = m_nextLogTime.load(std::memory_order_relaxed);
+
+    // only the thread that wins the exchange logs; everyone else counts as suppressed
+    if (currentTime < nextLogTime || !m_nextLogTime.compare_exchange_strong(nextLogTime, currentTime + intervalMs, std::memory_order_relaxed))
+    {
+        m_suppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressedCount = m_suppressedCount.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogDedupSite::ShouldLog(LogLevel level, const IP::String& text, uint64_t& repeatCount)
+{
+    if (!m_registered.load(std::memory_order_acquire) && !m_registered.exchange(true, std::memory_order_acq_rel))
+    {
+        m_level = level;
+        m_nextSite = s_dedupSites.load(std::memory_order_relaxed);
+        while (!s_dedupSites.compare_exchange_weak(m_nextSite, this, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // FNV-1a; a collision only costs one message being counted as a repeat
+    uint64_t textHash = 14695981039346656037ULL;
+    for (char c : text)
+    {
+        textHash = (textHash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+
+    int64_t currentTime = GetCurrentTimeMs();
+    if (m_lastTextHash.exchange(textHash, std::memory_order_relaxed) == textHash)
+    {
+        m_repeatCount.fetch_add(1, std::memory_order_relaxed);
+
+        // only the thread that wins the exchange reports a run that's still going
+        int64_t nextReportTime = m_nextReportTime.load(std::memory_order_relaxed);
+        if (currentTime >= nextReportTime && m_nextReportTime.compare_exchange_strong(nextReportTime, currentTime + REPEAT_REPORT_INTERVAL_MS, std::memory_order_relaxed))
+        {
+            repeatCount = m_repeatCount.exchange(0, std::memory_order_relaxed);
+        }
+
+        return false;
+    }
+
+    m_nextReportTime.store(currentTime + REPEAT_REPORT_INTERVAL_MS, std::memory_order_relaxed);
+    repeatCount = m_repeatCount.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+void ReportRepeatedMessages()
+{
+    for (LogDedupSite* site = s_dedupSites.load(std::memory_order_acquire); site != nullptr; site = site->m_nextSite)
+    {
+        uint64_t repeatCount = site->m_repeatCount.exchange(0, std::memory_order_relaxed);
+        if (repeatCount > 0)
+        {
+            LOG(site->m_level, "Previous message repeated " << repeatCount << " times");
+        }
+    }
+}
+
+} // namespace Logging
+} // namespace IP
@@ -1,137 +1,117 @@
 #include <ip/core/logging/RollingFileLogger.h>
 
-#include <ip/core/debug/IPException.h>
-#include <ip/core/utils/FileUtils.h>
-#include <ip/core/utils/SystemUtils.h>
-
-#include <fstream>
-#include <string.h>
+#include <ip/core/logging/LogEntry.h>
 
 namespace IP
 {
 namespace Logging
 {
 
-static const char* LOG_ARCHIVE_DIRECTORY = "archive";
-static const char* LOG_FILE_SUFFIX = ".log";
-
 RollingFileLogger::RollingFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory) :
+    RollingFileLogger(std::move(formatter), filenamePrefix, directory, LogFlushPolicy())
+{
+}
+
+RollingFileLogger::RollingFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy) :
+    RollingFileLogger(std::move(formatter), filenamePrefix, directory, flushPolicy, LogRollPolicy(), LogArchivePolicy())
+{
+}
+
+RollingFileLogger::RollingFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy) :
     m_formatter(std::move(formatter)),
-    m_outputStream(nullptr),
-    m_outputLogInterval(),
-    m_logFileDirectory(directory),
-    m_filenamePrefix(filenamePrefix)
+    m_outputFile(flushPolicy),
+    m_outputFileName(),
+    m_index(),
+    m_roller(directory, filenamePrefix, rollPolicy),
+    m_archiver(nullptr)
 {
-    InitializeAndCleanDirectories();
+    InitializeLogDirectories(directory);
+
+    m_archiver = IP::MakeUnique<LogArchiver>(MEMORY_TAG, directory, filenamePrefix, archivePolicy);
 }
 
 RollingFileLogger::~RollingFileLogger()
 {
-    if (m_outputStream)
-    {
-        m_outputStream->close();
-    }
+    m_outputFile.Close();
+    m_index.Close();
 }
 
 void RollingFileLogger::Log(LogEntry&& entry)
 {
-    RollLogFile();
-
-    IP::StringStream ss;
-    m_formatter->FormatLogLine(ss, std::move(entry));
+    WriteEntry(entry, nullptr);
+}
 
-    (*m_outputStream) << ss.str() << std::endl;
+void RollingFileLogger::LogShared(const LogRecordPtr& record)
+{
+    WriteEntry(record->GetEntry(), record->FindRendering(m_formatter->GetFormatSignature()));
 }
 
-void RollingFileLogger::RollLogFile()
+void RollingFileLogger::WriteEntry(const LogEntry& entry, const IP::String* renderedLine)
 {
-    IP::Time::SystemTimePoint currentLogInterval = std::chrono::time_point_cast<std::chrono::hours>(IP::Time::GetCurrentSystemTime());
-    if (currentLogInterval == m_outputLogInterval)
-    {
-        return;
-    }
+    RollLogFile();
 
-    if (m_outputStream)
+    // the lost lines are in the index, so it stops short of them
+    IP::String lossReport;
+    if (m_outputFile.TakeLossReport(lossReport))
     {
-        m_outputStream->close();
+        m_index.Abandon();
+        WriteEntry(LogEntry(LogLevel::Warn, std::move(lossReport), entry.m_time), nullptr);
     }
 
-    m_outputStream = IP::MakeUnique<IP::OFStream>(MEMORY_TAG, BuildLogFileName(currentLogInterval).c_str(), std::ios_base::out | std::ios_base::ate);
-    m_outputLogInterval = currentLogInterval;
-}
+    uint64_t lineStart = m_outputFile.GetSize();
+    IP::String& output = m_outputFile.BeginEntry();
 
-std::experimental::filesystem::path RollingFileLogger::BuildLogFileName(IP::Time::SystemTimePoint logInterval) const
-{
-    IP::StringStream filename;
-    filename << m_filenamePrefix << "_";
-    filename << IP::System::GetProcessId() << "_";
+    // a line torn by a failed write is ended before the next one starts
+    if (m_outputFile.EndsMidEntry() && output.empty())
+    {
+        output.push_back('\n');
+    }
 
-    filename << IP::Time::ConvertSystemTimeToFileSuffix(logInterval);
-    filename << LOG_FILE_SUFFIX;
+    if (renderedLine != nullptr)
+    {
+        output.append(*renderedLine);
+    }
+    else
+    {
+        m_formatter->FormatLogLine(output, entry);
+    }
+    output.push_back('\n');
 
-    std::experimental::filesystem::path fullPath(m_logFileDirectory);
-    fullPath.append(filename.str());
+    m_index.AddLine(entry.m_time, entry.m_level, lineStart, m_outputFile.GetSize());
 
-    return fullPath;
+    m_outputFile.EndEntry(entry.m_level);
 }
 
-void RollingFileLogger::InitializeAndCleanDirectories(void)
+void RollingFileLogger::Flush()
 {
-    // Create base directory if necessary
-    if (!std::experimental::filesystem::is_directory(m_logFileDirectory))
-    {
-        if (!std::experimental::filesystem::exists(m_logFileDirectory))
-        {
-            std::experimental::filesystem::create_directory(m_logFileDirectory);
-        }
-        else
-        {
-            THROW_IP_EXCEPTION("RollingFileLogger directory exists and is not a directory: ", m_logFileDirectory.c_str());
-        }
-    }
+    m_outputFile.Flush();
+}
 
-    // Create archive directory if necessary
-    std::experimental::filesystem::path archivePath(m_logFileDirectory);
-    archivePath.append(LOG_ARCHIVE_DIRECTORY);
+void RollingFileLogger::Service()
+{
+    m_outputFile.Service();
+}
 
-    if (!std::experimental::filesystem::is_directory(archivePath))
+void RollingFileLogger::RollLogFile()
+{
+    IP::Time::SystemTimePoint currentTime = IP::Time::GetCurrentSystemTime();
+    if (!m_roller.ShouldRoll(currentTime, m_outputFile.GetSize()))
     {
-        if (!std::experimental::filesystem::exists(archivePath))
-        {
-            std::experimental::filesystem::create_directory(archivePath);
-        }
-        else
-        {
-            THROW_IP_EXCEPTION("RollingFileLogger archive directory exists and is not a directory: ", archivePath.c_str());
-        }
+        return;
     }
 
-    // Enumerate all files matching the prefix
-    for (const auto& file : std::experimental::filesystem::directory_iterator(m_logFileDirectory))
+    // closing writes out everything buffered so far, which belongs to the previous file
+    if (m_outputFile.IsOpen())
     {
-        const auto& path = file.path();
-        IP::String filename(path.filename().string().c_str());
-        if (strncmp(filename.c_str(), m_filenamePrefix.c_str(), m_filenamePrefix.size()))
-        {
-            continue;
-        }
-
-        std::experimental::filesystem::path newPath(archivePath);
-        newPath.append(filename);
-
-        std::experimental::filesystem::rename(file, newPath);
+        m_outputFile.Close();
+        m_index.Close();
+        m_archiver->ArchiveFile(m_outputFileName);
+        m_archiver->ArchiveFile(BuildLogIndexFileName(m_outputFileName));
     }
 
-    auto currentTime = IP::Time::GetCurrentSystemTime();
-    for (const auto& file : std::experimental::filesystem::directory_iterator(archivePath))
-    {
-        auto lastModifiedTime = std::experimental::filesystem::last_write_time(file);
-        auto timeDifference = currentTime - lastModifiedTime;
-        if (std::chrono::duration_cast< std::chrono::seconds >(timeDifference) > std::chrono::duration_cast< std::chrono::seconds >(std::chrono::hours(24)))
-        {
-            std::experimental::filesystem::remove(file);
-        }
-    }
+    m_outputFileName = m_roller.Roll(currentTime);
+    m_outputFile.Open(m_outputFileName);
+    m_index.Open(m_outputFileName);
 }
 
 } // namespace Logging
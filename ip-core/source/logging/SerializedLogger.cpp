@@ -22,5 +22,26 @@ void SerializedLogger::Log(LogEntry&& entry)
     m_logger->Log(std::move(entry));
 }
 
+void SerializedLogger::LogShared(const LogRecordPtr& record)
+{
+    std::lock_guard<std::mutex> lock(m_loggerLock);
+
+    m_logger->LogShared(record);
+}
+
+void SerializedLogger::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_loggerLock);
+
+    m_logger->Flush();
+}
+
+void SerializedLogger::Service()
+{
+    std::lock_guard<std::mutex> lock(m_loggerLock);
+
+    m_logger->Service();
+}
+
 } // namespace Logging
 } // namespace IP
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include <ip/core/logging/SharedMemoryLogger.h>
+
+#include <algorithm>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ip/core/debug/IPException.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/utils/SystemUtils.h>
+
+namespace IP
+{
+namespace Logging
+{
+
+SharedMemoryLogger::SharedMemoryLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* name) :
+    SharedMemoryLogger(std::move(formatter), name, DEFAULT_SLOT_COUNT, DEFAULT_SLOT_SIZE)
+{
+}
+
+SharedMemoryLogger::SharedMemoryLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, const char* name, uint32_t slotCount, uint32_t slotSize) :
+    m_formatter(std::move(formatter)),
+    m_lineBuffer(),
+    m_memory(),
+    m_header(nullptr)
+{
+    // slots stay 8 byte aligned for their atomic sequence
+    slotSize = std::max<uint32_t>((slotSize + 7) & ~7u, sizeof(SharedMemoryLogSlot) + 8);
+
+    if (slotCount == 0 || !m_memory.Create(name, GetSharedMemoryLogSize(slotCount, slotSize)))
+    {
+        THROW_IP_EXCEPTION("Unable to create shared memory log ", name);
+    }
+
+    // the segment starts zeroed, so every slot reads as empty
+    m_header = new (m_memory.GetData()) SharedMemoryLogHeader();
+    m_header->m_slotCount = slotCount;
+    m_header->m_slotSize = slotSize;
+    m_header->m_nextSequence.store(0, std::memory_order_relaxed);
+    m_header->m_writerProcessId = static_cast<uint32_t>(atoi(IP::System::GetProcessId().c_str()));
+    m_header->m_writerOpen.store(1, std::memory_order_relaxed);
+
+    // readers check the magic last, after everything else is in place
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(m_header->m_magic, SHARED_MEMORY_LOG_MAGIC, sizeof(SHARED_MEMORY_LOG_MAGIC));
+}
+
+SharedMemoryLogger::~SharedMemoryLogger()
+{
+    m_header->m_writerOpen.store(0, std::memory_order_release);
+    m_formatter = nullptr;
+}
+
+void SharedMemoryLogger::Log(LogEntry&& entry)
+{
+    WriteEntry(entry, nullptr);
+}
+
+void SharedMemoryLogger::LogShared(const LogRecordPtr& record)
+{
+    WriteEntry(record->GetEntry(), record->FindRendering(m_formatter->GetFormatSignature()));
+}
+
+void SharedMemoryLogger::WriteEntry(const LogEntry& entry, const IP::String* renderedLine)
+{
+    if (renderedLine == nullptr)
+    {
+        m_lineBuffer.clear();
+        m_formatter->FormatLogLine(m_lineBuffer, entry);
+        renderedLine = &m_lineBuffer;
+    }
+
+    uint64_t sequence = m_header->m_nextSequence.load(std::memory_order_relaxed);
+    char* slotData = m_memory.GetData() + sizeof(SharedMemoryLogHeader) + (sequence % m_header->m_slotCount) * m_header->m_slotSize;
+    SharedMemoryLogSlot* slot = reinterpret_cast<SharedMemoryLogSlot*>(slotData);
+
+    slot->m_sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t textCapacity = std::min<size_t>(m_header->m_slotSize - sizeof(SharedMemoryLogSlot), UINT16_MAX);
+    slot->m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.m_time.time_since_epoch()).count();
+    slot->m_level = static_cast<uint8_t>(entry.m_level);
+    slot->m_channel = static_cast<uint8_t>(entry.m_channel);
+    slot->m_length = static_cast<uint16_t>(std::min(renderedLine->size(), textCapacity));
+    memcpy(slotData + sizeof(SharedMemoryLogSlot), renderedLine->data(), slot->m_length);
+
+    slot->m_sequence.store(sequence + 1, std::memory_order_release);
+    m_header->m_nextSequence.store(sequence + 1, std::memory_order_release);
+}
+
+SharedMemoryLogReader::SharedMemoryLogReader(const char* name) :
+    m_memory(),
+    m_header(nullptr),
+    m_nextSequence(0)
+{
+    if (!m_memory.Open(name))
+    {
+        THROW_IP_EXCEPTION("No shared memory log named ", name);
+    }
+
+    m_header = reinterpret_cast<const SharedMemoryLogHeader*>(m_memory.GetData());
+    if (m_memory.GetSize() < sizeof(SharedMemoryLogHeader) || memcmp(m_header->m_magic, SHARED_MEMORY_LOG_MAGIC, sizeof(SHARED_MEMORY_LOG_MAGIC)))
+    {
+        THROW_IP_EXCEPTION("Not a shared memory log: ", name);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_memory.GetSize() < GetSharedMemoryLogSize(m_header->m_slotCount, m_header->m_slotSize))
+    {
+        THROW_IP_EXCEPTION("Shared memory log is truncated: ", name);
+    }
+
+    m_nextSequence = GetOldestSequence();
+}
+
+void SharedMemoryLogReader::SeekToEnd()
+{
+    m_nextSequence = m_header->m_nextSequence.load(std::memory_order_acquire);
+}
+
+bool SharedMemoryLogReader::ReadNext(IP::String& line, LogLevel& level, uint64_t& lostCount)
+{
+    lostCount = 0;
+
+    while (true)
+    {
+        if (m_nextSequence >= m_header->m_nextSequence.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        const SharedMemoryLogSlot& slot = GetSlot(m_nextSequence);
+        uint64_t before = slot.m_sequence.load(std::memory_order_acquire);
+
+        if (before == m_nextSequence + 1)
+        {
+            uint16_t length = std::min<uint16_t>(slot.m_length, static_cast<uint16_t>(m_header->m_slotSize - sizeof(SharedMemoryLogSlot)));
+            uint8_t slotLevel = slot.m_level;
+            line.assign(reinterpret_cast<const char*>(&slot + 1), length);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.m_sequence.load(std::memory_order_relaxed) == before)
+            {
+                level = static_cast<LogLevel>(slotLevel);
+                ++m_nextSequence;
+                return true;
+            }
+        }
+
+        // the writer lapped us: skip ahead to the oldest entry that's still intact
+        uint64_t oldest = GetOldestSequence();
+        if (oldest > m_nextSequence)
+        {
+            lostCount += oldest - m_nextSequence;
+            m_nextSequence = oldest;
+        }
+        else
+        {
+            // torn by a write of this very slot, which only happens once it's being reused
+            ++lostCount;
+            ++m_nextSequence;
+        }
+    }
+}
+
+bool SharedMemoryLogReader::IsWriterOpen() const
+{
+    return m_header->m_writerOpen.load(std::memory_order_acquire) != 0;
+}
+
+uint32_t SharedMemoryLogReader::GetWriterProcessId() const
+{
+    return m_header->m_writerProcessId;
+}
+
+const SharedMemoryLogSlot& SharedMemoryLogReader::GetSlot(uint64_t sequence) const
+{
+    const char* slotData = m_memory.GetData() + sizeof(SharedMemoryLogHeader) + (sequence % m_header->m_slotCount) * m_header->m_slotSize;
+
+    return *reinterpret_cast<const SharedMemoryLogSlot*>(slotData);
+}
+
+uint64_t SharedMemoryLogReader::GetOldestSequence() const
+{
+    uint64_t next = m_header->m_nextSequence.load(std::memory_order_acquire);
+
+    // leave a slot of headroom for the one the writer may be filling right now
+    return next > m_header->m_slotCount - 1 ? next - (m_header->m_slotCount - 1) : 0;
+}
+
+} // namespace Logging
+} // namespace IP
@@ -7,9 +7,36 @@ namespace IP
 namespace Logging
 {
 
-void StandardLogLineFormatter::FormatLogLine(IP::StringStream& ss, LogEntry&& entry) const
+StandardLogLineFormatter::StandardLogLineFormatter() :
+    m_timeOfDayFormatter()
 {
-    ss << IP::Time::FormatTimeOfDay(entry.m_time) << " [" << entry.m_levelName << "] " << entry.m_text;
+}
+
+void StandardLogLineFormatter::FormatLogLine(IP::String& buffer, const LogEntry& entry) const
+{
+    m_timeOfDayFormatter.AppendTimeOfDay(buffer, entry.m_time);
+    buffer.append(" [");
+    buffer.append(entry.m_levelName);
+    buffer.append("] ");
+
+    if (entry.m_channel != LogChannel::General)
+    {
+        buffer.push_back('[');
+        buffer.append(GetLogChannelName(entry.m_channel));
+        buffer.append("] ");
+    }
+
+    AppendLogMessage(buffer, entry);
+}
+
+const char* StandardLogLineFormatter::GetFormatSignature() const
+{
+    return "standard";
+}
+
+IP::UniquePtr<ILogLineFormatter> StandardLogLineFormatter::Clone() const
+{
+    return IP::MakeUniqueUpcast<StandardLogLineFormatter, ILogLineFormatter>(MEMORY_TAG);
 }
 
 } // namespace Logging
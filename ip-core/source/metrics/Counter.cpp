@@ -0,0 +1,30 @@
+#include <ip/core/metrics/Counter.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+std::atomic<uint32_t> g_nextMetricsStripe(0);
+
+Counter::Counter()
+{
+    for (auto& stripe : m_stripes)
+    {
+        stripe.m_value.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Counter::GetValue() const
+{
+    uint64_t value = 0;
+    for (const auto& stripe : m_stripes)
+    {
+        value += stripe.m_value.load(std::memory_order_relaxed);
+    }
+
+    return value;
+}
+
+} // namespace Metrics
+} // namespace IP
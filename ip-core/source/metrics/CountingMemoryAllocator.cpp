@@ -0,0 +1,38 @@
+#include <ip/core/metrics/CountingMemoryAllocator.h>
+
+#include <stdlib.h>
+
+#include <ip/core/metrics/MetricsRegistry.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+CountingMemoryAllocator::CountingMemoryAllocator(MetricsRegistry& registry) :
+    m_allocations(registry.GetCounter("ip_memory_allocations_total", "Allocations made through IP::Malloc")),
+    m_frees(registry.GetCounter("ip_memory_frees_total", "Allocations released through IP::Free")),
+    m_allocatedBytes(registry.GetCounter("ip_memory_allocated_bytes_total", "Bytes allocated through IP::Malloc"))
+{
+}
+
+void* CountingMemoryAllocator::Allocate(const char*, size_t memory_size)
+{
+    m_allocations.Increment();
+    m_allocatedBytes.Increment(memory_size);
+
+    return malloc(memory_size);
+}
+
+void CountingMemoryAllocator::Free(void* memory)
+{
+    if (memory != nullptr)
+    {
+        m_frees.Increment();
+    }
+
+    free(memory);
+}
+
+} // namespace Metrics
+} // namespace IP
@@ -0,0 +1,163 @@
+#include <ip/core/metrics/Histogram.h>
+
+#include <algorithm>
+#include <math.h>
+
+#include <ip/core/debug/IPException.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace IP
+{
+namespace Metrics
+{
+
+static uint32_t GetHighestSetBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+static size_t GetHistogramBucketCount(uint32_t precisionBits)
+{
+    size_t subBucketCount = size_t(1) << precisionBits;
+
+    return subBucketCount + (64 - precisionBits) * (subBucketCount / 2);
+}
+
+size_t GetHistogramBucketIndex(uint32_t precisionBits, uint64_t value)
+{
+    size_t subBucketCount = size_t(1) << precisionBits;
+    if (value < subBucketCount)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    // the top precisionBits bits select a bucket within the value's power of two
+    uint32_t shift = GetHighestSetBit(value) - (precisionBits - 1);
+    size_t halfCount = subBucketCount / 2;
+
+    return subBucketCount + (shift - 1) * halfCount + (static_cast<size_t>(value >> shift) - halfCount);
+}
+
+uint64_t GetHistogramBucketLowerBound(uint32_t precisionBits, size_t bucketIndex)
+{
+    size_t subBucketCount = size_t(1) << precisionBits;
+    if (bucketIndex < subBucketCount)
+    {
+        return bucketIndex;
+    }
+
+    size_t halfCount = subBucketCount / 2;
+    size_t shift = (bucketIndex - subBucketCount) / halfCount + 1;
+    uint64_t top = halfCount + (bucketIndex - subBucketCount) % halfCount;
+
+    return top << shift;
+}
+
+uint64_t GetHistogramBucketUpperBound(uint32_t precisionBits, size_t bucketIndex)
+{
+    size_t subBucketCount = size_t(1) << precisionBits;
+    if (bucketIndex < subBucketCount)
+    {
+        return bucketIndex;
+    }
+
+    size_t shift = (bucketIndex - subBucketCount) / (subBucketCount / 2) + 1;
+
+    return GetHistogramBucketLowerBound(precisionBits, bucketIndex) + ((uint64_t(1) << shift) - 1);
+}
+
+Histogram::Histogram(uint32_t precisionBits) :
+    m_precisionBits(precisionBits),
+    m_bucketCounts(),
+    m_count(0),
+    m_sum(0),
+    m_min(UINT64_MAX),
+    m_max(0)
+{
+    if (precisionBits < 1 || precisionBits > 16)
+    {
+        THROW_IP_EXCEPTION("Histogram precision must be between 1 and 16 bits");
+    }
+
+    m_bucketCounts = IP::Vector<std::atomic<uint64_t>>(GetHistogramBucketCount(precisionBits));
+}
+
+void Histogram::Record(uint64_t value)
+{
+    m_bucketCounts[GetHistogramBucketIndex(m_precisionBits, value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    // only contended while the extremes are still moving
+    uint64_t min = m_min.load(std::memory_order_relaxed);
+    while (value < min && !m_min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+    {
+    }
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+HistogramSnapshot Histogram::GetSnapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.m_precisionBits = m_precisionBits;
+    snapshot.m_bucketCounts.reserve(m_bucketCounts.size());
+
+    // the count is the sum of what was actually copied, so percentile ranks stay within the buckets
+    uint64_t count = 0;
+    for (const auto& bucketCount : m_bucketCounts)
+    {
+        snapshot.m_bucketCounts.push_back(bucketCount.load(std::memory_order_relaxed));
+        count += snapshot.m_bucketCounts.back();
+    }
+
+    snapshot.m_count = count;
+    snapshot.m_sum = m_sum.load(std::memory_order_relaxed);
+    snapshot.m_min = count > 0 ? m_min.load(std::memory_order_relaxed) : 0;
+    snapshot.m_max = m_max.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+uint64_t GetHistogramPercentile(const HistogramSnapshot& snapshot, double percentile)
+{
+    if (snapshot.m_count == 0)
+    {
+        return 0;
+    }
+
+    double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(ceil(clamped / 100.0 * static_cast<double>(snapshot.m_count))), 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < snapshot.m_bucketCounts.size(); ++i)
+    {
+        seen += snapshot.m_bucketCounts[i];
+        if (seen >= rank)
+        {
+            return std::min(GetHistogramBucketUpperBound(snapshot.m_precisionBits, i), snapshot.m_max);
+        }
+    }
+
+    return snapshot.m_max;
+}
+
+double GetHistogramMean(const HistogramSnapshot& snapshot)
+{
+    return snapshot.m_count > 0 ? static_cast<double>(snapshot.m_sum) / static_cast<double>(snapshot.m_count) : 0.0;
+}
+
+} // namespace Metrics
+} // namespace IP
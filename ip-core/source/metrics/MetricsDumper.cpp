@@ -0,0 +1,75 @@
+#include <ip/core/metrics/MetricsDumper.h>
+
+#include <ip/core/metrics/MetricsRegistry.h>
+#include <ip/core/utils/OutputFile.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+static const char* const PARTIAL_SUFFIX = ".partial";
+
+MetricsDumper::MetricsDumper(MetricsRegistry& registry, const std::experimental::filesystem::path& path, std::chrono::milliseconds interval) :
+    m_registry(registry),
+    m_path(path),
+    m_partialPath(path),
+    m_interval(interval),
+    m_buffer(),
+    m_stopLock(),
+    m_stopSignal(),
+    m_stopping(false),
+    m_thread()
+{
+    m_partialPath += PARTIAL_SUFFIX;
+    m_thread = IP::MakeUnique<std::thread>(MEMORY_TAG, &MetricsDumper::Run, this);
+}
+
+MetricsDumper::~MetricsDumper()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_stopLock);
+        m_stopping = true;
+    }
+    m_stopSignal.notify_one();
+
+    m_thread->join();
+}
+
+void MetricsDumper::Run()
+{
+    bool stopping = false;
+
+    while (!stopping)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_stopLock);
+            m_stopSignal.wait_for(lock, m_interval, [&](){ return m_stopping; });
+            stopping = m_stopping;
+        }
+
+        Dump();
+    }
+}
+
+bool MetricsDumper::Dump()
+{
+    m_buffer.clear();
+    m_registry.AppendPrometheusText(m_buffer);
+
+    {
+        IP::FileUtils::OutputFile file;
+        if (!file.Open(m_partialPath) || !file.Write(m_buffer.data(), m_buffer.size()))
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::experimental::filesystem::rename(m_partialPath, m_path, error);
+
+    return !error;
+}
+
+} // namespace Metrics
+} // namespace IP
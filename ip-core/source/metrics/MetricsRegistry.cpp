@@ -0,0 +1,222 @@
+#include <ip/core/metrics/MetricsRegistry.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <ip/core/debug/IPException.h>
+
+namespace IP
+{
+namespace Metrics
+{
+
+static const double SUMMARY_QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+
+static bool IsValidMetricName(const char* name)
+{
+    if (name == nullptr || *name == 0)
+    {
+        return false;
+    }
+
+    for (const char* c = name; *c != 0; ++c)
+    {
+        bool letter = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || *c == '_' || *c == ':';
+        bool digit = *c >= '0' && *c <= '9';
+        if (!letter && !(digit && c != name))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static const char* GetMetricTypeName(MetricType type)
+{
+    switch (type)
+    {
+        case MetricType::Counter: return "counter";
+        case MetricType::Gauge: return "gauge";
+        case MetricType::Histogram: return "summary";
+        default: return "untyped";
+    }
+}
+
+static void AppendHeader(IP::String& buffer, const IP::String& name, const IP::String& help, const char* typeName)
+{
+    buffer.append("# HELP ");
+    buffer.append(name);
+    buffer.push_back(' ');
+
+    for (char c : help)
+    {
+        switch (c)
+        {
+            case '\\': buffer.append("\\\\"); break;
+            case '\n': buffer.append("\\n"); break;
+            default: buffer.push_back(c); break;
+        }
+    }
+
+    buffer.append("\n# TYPE ");
+    buffer.append(name);
+    buffer.push_back(' ');
+    buffer.append(typeName);
+    buffer.push_back('\n');
+}
+
+static void AppendSample(IP::String& buffer, const IP::String& name, const char* suffix, const char* labels, const char* value)
+{
+    buffer.append(name);
+    buffer.append(suffix);
+    buffer.append(labels);
+    buffer.push_back(' ');
+    buffer.append(value);
+    buffer.push_back('\n');
+}
+
+static void AppendHistogram(IP::String& buffer, const IP::String& name, const IP::String& help, const Histogram& histogram)
+{
+    HistogramSnapshot snapshot = histogram.GetSnapshot();
+    char labels[32];
+    char value[32];
+
+    AppendHeader(buffer, name, help, GetMetricTypeName(MetricType::Histogram));
+
+    for (double quantile : SUMMARY_QUANTILES)
+    {
+        snprintf(labels, sizeof(labels), "{quantile=\"%g\"}", quantile);
+        snprintf(value, sizeof(value), "%" PRIu64, GetHistogramPercentile(snapshot, quantile * 100.0));
+        AppendSample(buffer, name, "", labels, value);
+    }
+
+    snprintf(value, sizeof(value), "%" PRIu64, snapshot.m_sum);
+    AppendSample(buffer, name, "_sum", "", value);
+
+    snprintf(value, sizeof(value), "%" PRIu64, snapshot.m_count);
+    AppendSample(buffer, name, "_count", "", value);
+
+    AppendHeader(buffer, name + "_max", help, GetMetricTypeName(MetricType::Gauge));
+    snprintf(value, sizeof(value), "%" PRIu64, snapshot.m_max);
+    AppendSample(buffer, name, "_max", "", value);
+}
+
+MetricsRegistry::MetricsRegistry() :
+    m_lock(),
+    m_metrics()
+{
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+}
+
+MetricsRegistry::Metric* MetricsRegistry::FindMetric(const char* name, MetricType type)
+{
+    if (!IsValidMetricName(name))
+    {
+        THROW_IP_EXCEPTION("Invalid metric name: ", name == nullptr ? "(null)" : name);
+    }
+
+    auto found = m_metrics.find(IP::String(name));
+    if (found == m_metrics.end())
+    {
+        return nullptr;
+    }
+
+    if (found->second.m_type != type)
+    {
+        THROW_IP_EXCEPTION("Metric ", name, " is already registered as a ", GetMetricTypeName(found->second.m_type));
+    }
+
+    return &found->second;
+}
+
+MetricsRegistry::Metric& MetricsRegistry::AddMetric(const char* name, const char* help, Metric&& metric)
+{
+    metric.m_help = help != nullptr ? help : "";
+
+    return m_metrics.emplace(IP::String(name), std::move(metric)).first->second;
+}
+
+Counter& MetricsRegistry::GetCounter(const char* name, const char* help)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    Metric* metric = FindMetric(name, MetricType::Counter);
+    if (metric == nullptr)
+    {
+        metric = &AddMetric(name, help, { MetricType::Counter, IP::String(), IP::MakeUnique<Counter>(MEMORY_TAG), nullptr, nullptr });
+    }
+
+    return *metric->m_counter;
+}
+
+Gauge& MetricsRegistry::GetGauge(const char* name, const char* help)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    Metric* metric = FindMetric(name, MetricType::Gauge);
+    if (metric == nullptr)
+    {
+        metric = &AddMetric(name, help, { MetricType::Gauge, IP::String(), nullptr, IP::MakeUnique<Gauge>(MEMORY_TAG), nullptr });
+    }
+
+    return *metric->m_gauge;
+}
+
+Histogram& MetricsRegistry::GetHistogram(const char* name, const char* help, uint32_t precisionBits)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    Metric* metric = FindMetric(name, MetricType::Histogram);
+    if (metric == nullptr)
+    {
+        metric = &AddMetric(name, help, { MetricType::Histogram, IP::String(), nullptr, nullptr, IP::MakeUnique<Histogram>(MEMORY_TAG, precisionBits) });
+    }
+
+    return *metric->m_histogram;
+}
+
+void MetricsRegistry::AppendPrometheusText(IP::String& buffer) const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    char value[32];
+
+    for (const auto& entry : m_metrics)
+    {
+        const IP::String& name = entry.first;
+        const Metric& metric = entry.second;
+
+        switch (metric.m_type)
+        {
+            case MetricType::Counter:
+                AppendHeader(buffer, name, metric.m_help, GetMetricTypeName(metric.m_type));
+                snprintf(value, sizeof(value), "%" PRIu64, metric.m_counter->GetValue());
+                AppendSample(buffer, name, "", "", value);
+                break;
+
+            case MetricType::Gauge:
+                AppendHeader(buffer, name, metric.m_help, GetMetricTypeName(metric.m_type));
+                snprintf(value, sizeof(value), "%.17g", metric.m_gauge->GetValue());
+                AppendSample(buffer, name, "", "", value);
+                break;
+
+            case MetricType::Histogram:
+                AppendHistogram(buffer, name, metric.m_help, *metric.m_histogram);
+                break;
+        }
+    }
+}
+
+MetricsRegistry& GetMetricsRegistry()
+{
+    static MetricsRegistry registry;
+
+    return registry;
+}
+
+} // namespace Metrics
+} // namespace IP
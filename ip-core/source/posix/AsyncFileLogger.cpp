@@ -0,0 +1,894 @@
+#include <ip/core/logging/AsyncFileLogger.h>
+
+#include <ip/core/debug/IPException.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/metrics/MetricsRegistry.h>
+
+#include <algorithm>
+#include <climits>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// io_uring needs both the kernel header and the system call numbers; without either the synchronous writer is used
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define IP_ASYNC_FILE_LOGGER_IO_URING
+#endif
+#endif
+#endif
+
+namespace IP
+{
+namespace Logging
+{
+
+static const size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+static const uint32_t DEFAULT_BUFFER_COUNT = 8;
+
+// how often a log file that failed to open is tried again
+static const std::chrono::seconds OPEN_RETRY_INTERVAL(1);
+
+// completion tag for linked fsyncs; buffer writes are tagged with their buffer index
+static const uint64_t SYNC_USER_DATA = ~0ULL;
+
+#if defined(IP_ASYNC_FILE_LOGGER_IO_URING)
+
+// Minimal io_uring plumbing over the raw system calls: one submission/completion ring pair with the logger's buffers
+// registered as fixed buffers.
+struct AsyncFileRing
+{
+    AsyncFileRing() :
+        m_fd(-1),
+        m_sqRing(nullptr),
+        m_sqRingSize(0),
+        m_cqRing(nullptr),
+        m_cqRingSize(0),
+        m_sqes(nullptr),
+        m_sqesSize(0),
+        m_sqHead(nullptr),
+        m_sqTail(nullptr),
+        m_sqMask(nullptr),
+        m_sqArray(nullptr),
+        m_cqHead(nullptr),
+        m_cqTail(nullptr),
+        m_cqMask(nullptr),
+        m_cqes(nullptr),
+        m_pendingSubmissions(0)
+    {}
+
+    ~AsyncFileRing()
+    {
+        if (m_sqes != nullptr)
+        {
+            munmap(m_sqes, m_sqesSize);
+        }
+
+        if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+        {
+            munmap(m_cqRing, m_cqRingSize);
+        }
+
+        if (m_sqRing != nullptr)
+        {
+            munmap(m_sqRing, m_sqRingSize);
+        }
+
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+    }
+
+    bool Initialize(uint32_t entries, IP::Vector<struct iovec>& registeredBuffers)
+    {
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0)
+        {
+            return false;
+        }
+
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+        bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMapping)
+        {
+            m_sqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+            m_cqRingSize = m_sqRingSize;
+        }
+
+        void* sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED)
+        {
+            return false;
+        }
+        m_sqRing = static_cast<char*>(sqRing);
+
+        if (singleMapping)
+        {
+            m_cqRing = m_sqRing;
+        }
+        else
+        {
+            void* cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED)
+            {
+                return false;
+            }
+            m_cqRing = static_cast<char*>(cqRing);
+        }
+
+        m_sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+        {
+            return false;
+        }
+        m_sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+        m_sqHead = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.head);
+        m_sqTail = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.tail);
+        m_sqMask = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.array);
+        m_cqHead = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.head);
+        m_cqTail = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.tail);
+        m_cqMask = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<struct io_uring_cqe*>(m_cqRing + params.cq_off.cqes);
+
+        int registerResult = static_cast<int>(syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, registeredBuffers.data(), static_cast<unsigned>(registeredBuffers.size())));
+
+        return registerResult == 0;
+    }
+
+    struct io_uring_sqe* GetSubmissionEntry()
+    {
+        uint32_t head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        uint32_t tail = *m_sqTail + m_pendingSubmissions;
+        if (tail - head > *m_sqMask)
+        {
+            return nullptr;
+        }
+
+        uint32_t index = tail & *m_sqMask;
+        m_sqArray[index] = index;
+        ++m_pendingSubmissions;
+
+        struct io_uring_sqe* sqe = &m_sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+
+        return sqe;
+    }
+
+    // Publishes everything prepared since the last call; only waits if waitForCompletion is set.  Returns 0, or the
+    // errno of a failed io_uring_enter, in which case entries the kernel didn't take are pulled back out of the ring
+    // and their user data appended to unsubmitted.
+    int Submit(bool waitForCompletion, IP::Vector<uint64_t>& unsubmitted)
+    {
+        if (m_pendingSubmissions > 0)
+        {
+            __atomic_store_n(m_sqTail, *m_sqTail + m_pendingSubmissions, __ATOMIC_RELEASE);
+            m_pendingSubmissions = 0;
+        }
+
+        // includes entries an earlier call left behind
+        uint32_t toSubmit = *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        if (toSubmit == 0 && !waitForCompletion)
+        {
+            return 0;
+        }
+
+        uint32_t flags = waitForCompletion ? IORING_ENTER_GETEVENTS : 0;
+        while (syscall(__NR_io_uring_enter, m_fd, toSubmit, waitForCompletion ? 1 : 0, flags, nullptr, 0) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            int error = errno;
+
+            // the kernel only reads the submission ring inside io_uring_enter, so what it hasn't consumed can be taken back
+            uint32_t head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+            for (uint32_t i = head; i != *m_sqTail; ++i)
+            {
+                unsubmitted.push_back(m_sqes[m_sqArray[i & *m_sqMask]].user_data);
+            }
+            __atomic_store_n(m_sqTail, head, __ATOMIC_RELEASE);
+
+            return error;
+        }
+
+        return 0;
+    }
+
+    template <typename Fn>
+    void ForEachCompletion(Fn completionFunction)
+    {
+        uint32_t head = *m_cqHead;
+        uint32_t tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+        while (head != tail)
+        {
+            const struct io_uring_cqe& cqe = m_cqes[head & *m_cqMask];
+            completionFunction(cqe.user_data, cqe.res);
+            ++head;
+        }
+
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    int m_fd;
+
+    char* m_sqRing;
+    size_t m_sqRingSize;
+    char* m_cqRing;
+    size_t m_cqRingSize;
+    struct io_uring_sqe* m_sqes;
+    size_t m_sqesSize;
+
+    uint32_t* m_sqHead;
+    uint32_t* m_sqTail;
+    uint32_t* m_sqMask;
+    uint32_t* m_sqArray;
+    uint32_t* m_cqHead;
+    uint32_t* m_cqTail;
+    uint32_t* m_cqMask;
+    struct io_uring_cqe* m_cqes;
+
+    uint32_t m_pendingSubmissions;
+};
+
+#else
+
+struct AsyncFileRing
+{
+};
+
+#endif // IP_ASYNC_FILE_LOGGER_IO_URING
+
+AsyncFileLogger::AsyncFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory) :
+    AsyncFileLogger(std::move(formatter), filenamePrefix, directory, LogFlushPolicy(), DEFAULT_BUFFER_SIZE, DEFAULT_BUFFER_COUNT, LogRollPolicy(), LogArchivePolicy())
+{
+}
+
+AsyncFileLogger::AsyncFileLogger(IP::UniquePtr<ILogLineFormatter>&& formatter, IP::String filenamePrefix, const std::experimental::filesystem::path& directory, const LogFlushPolicy& flushPolicy, size_t bufferSize, uint32_t bufferCount, const LogRollPolicy& rollPolicy, const LogArchivePolicy& archivePolicy) :
+    m_formatter(std::move(formatter)),
+    m_flushPolicy(flushPolicy),
+    m_lineBuffer(),
+    m_bufferSize(std::max<size_t>(bufferSize, 1)),
+    m_bufferMemory(),
+    m_buffers(),
+    m_currentBuffer(-1),
+    m_currentBufferStartTime(),
+    m_stagedOutput(),
+    m_ring(nullptr),
+    m_ringFailed(false),
+    m_unsubmitted(),
+    m_lastSyncTime(),
+    m_fd(-1),
+    m_fileName(),
+    m_fileOffset(0),
+    m_lastOpenTime(),
+    m_droppedEntries(0),
+    m_retiredFiles(),
+    m_roller(directory, filenamePrefix, rollPolicy),
+    m_archiver(nullptr),
+    m_writeErrorMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_log_write_errors_total", "Log file writes that failed, and the data with them")),
+    m_lostMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_log_file_entries_lost_total", "Entries file loggers lost to failed opens or writes"))
+{
+    bufferCount = std::max<uint32_t>(bufferCount, 1);
+
+    m_bufferMemory.resize(m_bufferSize * bufferCount);
+    m_buffers.resize(bufferCount);
+
+    IP::Vector<struct iovec> registeredBuffers(bufferCount);
+    for (uint32_t i = 0; i < bufferCount; ++i)
+    {
+        m_buffers[i] = { m_bufferMemory.data() + i * m_bufferSize, 0, 0, -1, 0, WriteBufferState::Free };
+
+        registeredBuffers[i].iov_base = m_buffers[i].m_data;
+        registeredBuffers[i].iov_len = m_bufferSize;
+    }
+
+#if defined(IP_ASYNC_FILE_LOGGER_IO_URING)
+    // room for every buffer's write plus a linked fsync
+    m_ring = IP::MakeUnique<AsyncFileRing>(MEMORY_TAG);
+    if (!m_ring->Initialize(bufferCount * 2, registeredBuffers))
+    {
+        m_ring = nullptr;
+    }
+#endif
+
+    InitializeLogDirectories(directory);
+
+    m_archiver = IP::MakeUnique<LogArchiver>(MEMORY_TAG, directory, filenamePrefix, archivePolicy);
+
+    RollLogFile();
+    if (m_fd < 0)
+    {
+        THROW_IP_EXCEPTION("Unable to open log file ", m_fileName.string().c_str(), ": ", strerror(errno));
+    }
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    // the only place this logger waits on the disk
+    while (true)
+    {
+        bool inFlight = std::any_of(m_buffers.cbegin(), m_buffers.cend(), [](const WriteBuffer& buffer){ return buffer.m_state == WriteBufferState::InFlight; });
+        bool ready = std::any_of(m_buffers.cbegin(), m_buffers.cend(), [](const WriteBuffer& buffer){ return buffer.m_state == WriteBufferState::Ready; });
+        if (!inFlight && !ready && m_currentBuffer < 0 && m_stagedOutput.empty())
+        {
+            break;
+        }
+
+        ReapCompletions(inFlight);
+        DrainStagedOutput();
+        SubmitCurrentBuffer();
+        WriteReadyBuffers();
+    }
+
+    CloseRetiredFiles();
+
+    // the active file stays in place, like RollingFileLogger's
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+
+    m_ring = nullptr;
+}
+
+void AsyncFileLogger::Log(LogEntry&& entry)
+{
+    WriteEntry(entry, nullptr);
+}
+
+void AsyncFileLogger::LogShared(const LogRecordPtr& record)
+{
+    WriteEntry(record->GetEntry(), record->FindRendering(m_formatter->GetFormatSignature()));
+}
+
+void AsyncFileLogger::WriteEntry(const LogEntry& entry, const IP::String* renderedLine)
+{
+    RollLogFile();
+
+    if (m_fd < 0)
+    {
+        IP::Time::SystemTimePoint currentTime = IP::Time::GetCurrentSystemTime();
+        if (currentTime - m_lastOpenTime < OPEN_RETRY_INTERVAL || !OpenLogFile(currentTime))
+        {
+            ++m_droppedEntries;
+            m_lostMetric.Increment();
+            return;
+        }
+    }
+
+    if (m_droppedEntries > 0)
+    {
+        IP::OStringStream message;
+        message << "Log file open failed: dropped " << m_droppedEntries << " entries";
+        m_droppedEntries = 0;
+
+        WriteEntry(LogEntry(LogLevel::Warn, message.str(), entry.m_time), nullptr);
+    }
+
+    if (renderedLine != nullptr)
+    {
+        Append(renderedLine->data(), renderedLine->size());
+        Append("\n", 1);
+    }
+    else
+    {
+        m_lineBuffer.clear();
+        m_formatter->FormatLogLine(m_lineBuffer, entry);
+        m_lineBuffer.push_back('\n');
+
+        Append(m_lineBuffer.data(), m_lineBuffer.size());
+    }
+
+    if (entry.m_level >= m_flushPolicy.m_immediateFlushLevel)
+    {
+        SubmitCurrentBuffer();
+        WriteReadyBuffers();
+    }
+}
+
+void AsyncFileLogger::Flush()
+{
+    ReapCompletions(false);
+    DrainStagedOutput();
+    SubmitCurrentBuffer();
+    WriteReadyBuffers();
+}
+
+void AsyncFileLogger::Service()
+{
+    ReapCompletions(false);
+    DrainStagedOutput();
+
+    if (m_currentBuffer >= 0 && IP::Time::GetCurrentSystemTime() - m_currentBufferStartTime >= m_flushPolicy.m_maxBufferedTime)
+    {
+        SubmitCurrentBuffer();
+    }
+
+    WriteReadyBuffers();
+    CloseRetiredFiles();
+}
+
+void AsyncFileLogger::RollLogFile()
+{
+    // bytes handed to the file so far plus whatever is still waiting in the current buffer or staging
+    uint64_t currentFileBytes = m_fileOffset + m_stagedOutput.size() + (m_currentBuffer >= 0 ? m_buffers[m_currentBuffer].m_length : 0);
+
+    IP::Time::SystemTimePoint currentTime = IP::Time::GetCurrentSystemTime();
+    if (!m_roller.ShouldRoll(currentTime, currentFileBytes))
+    {
+        return;
+    }
+
+    SubmitCurrentBuffer();
+    WriteReadyBuffers();
+
+    if (m_fd >= 0)
+    {
+        if (!m_stagedOutput.empty())
+        {
+            // staged lines belong to the old file; this only happens if the disk is stalled right at a roll
+            if (pwrite(m_fd, m_stagedOutput.data(), m_stagedOutput.size(), static_cast<off_t>(m_fileOffset)) != static_cast<ssize_t>(m_stagedOutput.size()))
+            {
+                m_writeErrorMetric.Increment();
+            }
+            m_stagedOutput.clear();
+        }
+
+        // in-flight writes still reference the old descriptor, so it's closed (and archived) once they complete
+        m_retiredFiles.push_back({ m_fd, m_fileName });
+    }
+
+    m_fileName = m_roller.Roll(currentTime);
+    OpenLogFile(currentTime);
+}
+
+bool AsyncFileLogger::OpenLogFile(IP::Time::SystemTimePoint currentTime)
+{
+    m_lastOpenTime = currentTime;
+    m_fd = open(m_fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    m_fileOffset = 0;
+
+    return m_fd >= 0;
+}
+
+void AsyncFileLogger::Append(const char* data, size_t length)
+{
+    if (!m_stagedOutput.empty())
+    {
+        // preserve ordering behind lines that are already waiting for a buffer
+        m_stagedOutput.append(data, length);
+        return;
+    }
+
+    while (length > 0)
+    {
+        if (m_currentBuffer < 0 && !AcquireBuffer())
+        {
+            m_stagedOutput.append(data, length);
+            return;
+        }
+
+        WriteBuffer& buffer = m_buffers[m_currentBuffer];
+        size_t copyLength = std::min(length, m_bufferSize - buffer.m_length);
+        memcpy(buffer.m_data + buffer.m_length, data, copyLength);
+
+        buffer.m_length += copyLength;
+        data += copyLength;
+        length -= copyLength;
+
+        if (buffer.m_length == m_bufferSize || buffer.m_length >= m_flushPolicy.m_maxBufferedBytes)
+        {
+            SubmitCurrentBuffer();
+        }
+    }
+}
+
+bool AsyncFileLogger::AcquireBuffer()
+{
+    auto findFree = [this]() { return std::find_if(m_buffers.begin(), m_buffers.end(), [](const WriteBuffer& buffer){ return buffer.m_state == WriteBufferState::Free; }); };
+
+    auto iter = findFree();
+    if (iter == m_buffers.end())
+    {
+        ReapCompletions(false);
+        WriteReadyBuffers();
+        iter = findFree();
+    }
+
+    if (iter == m_buffers.end())
+    {
+        return false;
+    }
+
+    iter->m_length = 0;
+    iter->m_written = 0;
+    iter->m_state = WriteBufferState::Filling;
+
+    m_currentBuffer = static_cast<int32_t>(iter - m_buffers.begin());
+    m_currentBufferStartTime = IP::Time::GetCurrentSystemTime();
+
+    return true;
+}
+
+void AsyncFileLogger::SubmitCurrentBuffer()
+{
+    if (m_currentBuffer < 0)
+    {
+        return;
+    }
+
+    uint32_t bufferIndex = static_cast<uint32_t>(m_currentBuffer);
+    WriteBuffer& buffer = m_buffers[bufferIndex];
+    m_currentBuffer = -1;
+
+    if (buffer.m_length == 0 || m_fd < 0)
+    {
+        buffer.m_state = WriteBufferState::Free;
+        return;
+    }
+
+    buffer.m_fd = m_fd;
+    buffer.m_fileOffset = m_fileOffset;
+    m_fileOffset += buffer.m_length;
+
+    buffer.m_state = WriteBufferState::Ready;
+    if (IsUsingIoUring() && QueueWrite(bufferIndex, ShouldSync()))
+    {
+        buffer.m_state = WriteBufferState::InFlight;
+        SubmitToRing(false);
+    }
+}
+
+void AsyncFileLogger::DrainStagedOutput()
+{
+    if (m_stagedOutput.empty())
+    {
+        return;
+    }
+
+    IP::String stagedOutput;
+    stagedOutput.swap(m_stagedOutput);
+
+    size_t consumed = 0;
+    while (consumed < stagedOutput.size())
+    {
+        if (m_currentBuffer < 0 && !AcquireBuffer())
+        {
+            break;
+        }
+
+        WriteBuffer& buffer = m_buffers[m_currentBuffer];
+        size_t copyLength = std::min(stagedOutput.size() - consumed, m_bufferSize - buffer.m_length);
+        memcpy(buffer.m_data + buffer.m_length, stagedOutput.data() + consumed, copyLength);
+
+        buffer.m_length += copyLength;
+        consumed += copyLength;
+
+        if (buffer.m_length == m_bufferSize)
+        {
+            SubmitCurrentBuffer();
+        }
+    }
+
+    m_stagedOutput.assign(stagedOutput, consumed, IP::String::npos);
+}
+
+bool AsyncFileLogger::ShouldSync()
+{
+    if (m_flushPolicy.m_syncInterval.count() <= 0)
+    {
+        return false;
+    }
+
+    auto currentTime = IP::Time::GetCurrentSystemTime();
+    if (currentTime - m_lastSyncTime < m_flushPolicy.m_syncInterval)
+    {
+        return false;
+    }
+
+    m_lastSyncTime = currentTime;
+    return true;
+}
+
+bool AsyncFileLogger::QueueWrite(uint32_t bufferIndex, bool sync)
+{
+#if defined(IP_ASYNC_FILE_LOGGER_IO_URING)
+    WriteBuffer& buffer = m_buffers[bufferIndex];
+
+    struct io_uring_sqe* writeEntry = m_ring->GetSubmissionEntry();
+    if (writeEntry == nullptr)
+    {
+        return false;
+    }
+
+    writeEntry->opcode = IORING_OP_WRITE_FIXED;
+    writeEntry->fd = buffer.m_fd;
+    writeEntry->addr = reinterpret_cast<uint64_t>(buffer.m_data + buffer.m_written);
+    writeEntry->len = static_cast<uint32_t>(buffer.m_length - buffer.m_written);
+    writeEntry->off = buffer.m_fileOffset + buffer.m_written;
+    writeEntry->buf_index = static_cast<uint16_t>(bufferIndex);
+    writeEntry->user_data = bufferIndex;
+
+    if (sync)
+    {
+        struct io_uring_sqe* syncEntry = m_ring->GetSubmissionEntry();
+        if (syncEntry != nullptr)
+        {
+            writeEntry->flags |= IOSQE_IO_LINK;
+
+            syncEntry->opcode = IORING_OP_FSYNC;
+            syncEntry->fd = buffer.m_fd;
+            syncEntry->fsync_flags = IORING_FSYNC_DATASYNC;
+            syncEntry->user_data = SYNC_USER_DATA;
+        }
+    }
+
+    return true;
+#else
+    IP_UNREFERENCED_PARAM(bufferIndex);
+    IP_UNREFERENCED_PARAM(sync);
+
+    return false;
+#endif // IP_ASYNC_FILE_LOGGER_IO_URING
+}
+
+bool AsyncFileLogger::SubmitToRing(bool wait)
+{
+#if defined(IP_ASYNC_FILE_LOGGER_IO_URING)
+    m_unsubmitted.clear();
+
+    int error = m_ring->Submit(wait, m_unsubmitted);
+    if (error == 0)
+    {
+        return true;
+    }
+
+    // writes the kernel never took go back to Ready, for the ring to retry or, once it has failed, for pwritev
+    for (uint64_t userData : m_unsubmitted)
+    {
+        if (userData < m_buffers.size())
+        {
+            m_buffers[static_cast<size_t>(userData)].m_state = WriteBufferState::Ready;
+        }
+    }
+
+    if (error != EAGAIN && error != EBUSY)
+    {
+        m_ringFailed = true;
+    }
+
+    return false;
+#else
+    IP_UNREFERENCED_PARAM(wait);
+
+    return false;
+#endif // IP_ASYNC_FILE_LOGGER_IO_URING
+}
+
+void AsyncFileLogger::ReapCompletions(bool wait)
+{
+#if defined(IP_ASYNC_FILE_LOGGER_IO_URING)
+    if (!m_ring)
+    {
+        return;
+    }
+
+    if (wait && !SubmitToRing(true) && m_ringFailed)
+    {
+        // Nothing can be waited on through a failed ring, and only the destructor waits, so whatever is still in
+        // flight is written again synchronously.  The buffers and offsets are unchanged, so a write the kernel does
+        // finish puts down the same bytes.
+        for (auto& buffer : m_buffers)
+        {
+            if (buffer.m_state == WriteBufferState::InFlight)
+            {
+                buffer.m_state = WriteBufferState::Ready;
+            }
+        }
+    }
+
+    bool resubmit = false;
+    m_ring->ForEachCompletion([&](uint64_t userData, int32_t result)
+    {
+        if (userData == SYNC_USER_DATA || userData >= m_buffers.size())
+        {
+            return;
+        }
+
+        WriteBuffer& buffer = m_buffers[static_cast<size_t>(userData)];
+        if (buffer.m_state != WriteBufferState::InFlight)
+        {
+            // already handed to pwritev after the ring failed
+            return;
+        }
+
+        if (result > 0)
+        {
+            buffer.m_written += static_cast<size_t>(result);
+        }
+
+        if ((result > 0 && buffer.m_written < buffer.m_length) || result == -EAGAIN || result == -EINTR)
+        {
+            // short or interrupted write; push the remainder back through the ring
+            buffer.m_state = WriteBufferState::Ready;
+            resubmit = true;
+            return;
+        }
+
+        if (result <= 0)
+        {
+            // a logger has nowhere to log its own failures, so they're counted and the buffer's lines are lost
+            m_writeErrorMetric.Increment();
+        }
+
+        buffer.m_state = WriteBufferState::Free;
+    });
+
+    if (resubmit)
+    {
+        WriteReadyBuffers();
+    }
+#else
+    IP_UNREFERENCED_PARAM(wait);
+#endif // IP_ASYNC_FILE_LOGGER_IO_URING
+}
+
+void AsyncFileLogger::WriteReadyBuffers()
+{
+    if (IsUsingIoUring())
+    {
+        // with a ring, Ready buffers are ones that couldn't get a submission entry, or need the rest of a short write
+        bool queued = false;
+        for (uint32_t i = 0; i < m_buffers.size(); ++i)
+        {
+            if (m_buffers[i].m_state == WriteBufferState::Ready && QueueWrite(i, false))
+            {
+                m_buffers[i].m_state = WriteBufferState::InFlight;
+                queued = true;
+            }
+        }
+
+        if (!queued || SubmitToRing(false) || !m_ringFailed)
+        {
+            return;
+        }
+
+        // the ring just failed; what it gave back is written below
+    }
+
+    // Fallback: write every ready buffer, coalescing runs that are contiguous in the same file into one pwritev.  A
+    // buffer may have been partly written through the ring before it failed; the rest starts at m_written.
+    IP::Vector<uint32_t> ready;
+    for (uint32_t i = 0; i < m_buffers.size(); ++i)
+    {
+        if (m_buffers[i].m_state == WriteBufferState::Ready)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    std::sort(ready.begin(), ready.end(), [this](uint32_t lhs, uint32_t rhs){ return m_buffers[lhs].m_fileOffset < m_buffers[rhs].m_fileOffset || (m_buffers[lhs].m_fileOffset == m_buffers[rhs].m_fileOffset && m_buffers[lhs].m_fd < m_buffers[rhs].m_fd); });
+
+    bool wroteData = false;
+    size_t runStart = 0;
+    while (runStart < ready.size())
+    {
+        const WriteBuffer& first = m_buffers[ready[runStart]];
+
+        IP::Vector<struct iovec> vectors;
+        uint64_t runEnd = first.m_fileOffset;
+        size_t runLength = runStart;
+        while (runLength < ready.size() && vectors.size() < IOV_MAX)
+        {
+            const WriteBuffer& buffer = m_buffers[ready[runLength]];
+            if (buffer.m_fd != first.m_fd || buffer.m_fileOffset != runEnd)
+            {
+                break;
+            }
+
+            if (buffer.m_fileOffset + buffer.m_written != runEnd && !vectors.empty())
+            {
+                break;
+            }
+
+            struct iovec vector;
+            vector.iov_base = buffer.m_data + buffer.m_written;
+            vector.iov_len = buffer.m_length - buffer.m_written;
+            vectors.push_back(vector);
+
+            runEnd = buffer.m_fileOffset + buffer.m_length;
+            ++runLength;
+        }
+
+        // pwritev may write partially; advance through the vectors until everything is out or an error occurs
+        uint64_t offset = first.m_fileOffset + first.m_written;
+        size_t vectorIndex = 0;
+        while (vectorIndex < vectors.size())
+        {
+            ssize_t written = pwritev(first.m_fd, vectors.data() + vectorIndex, static_cast<int>(vectors.size() - vectorIndex), static_cast<off_t>(offset));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                m_writeErrorMetric.Increment();
+                break;
+            }
+
+            offset += static_cast<uint64_t>(written);
+            size_t remaining = static_cast<size_t>(written);
+            while (vectorIndex < vectors.size() && remaining >= vectors[vectorIndex].iov_len)
+            {
+                remaining -= vectors[vectorIndex].iov_len;
+                ++vectorIndex;
+            }
+
+            if (vectorIndex < vectors.size())
+            {
+                vectors[vectorIndex].iov_base = static_cast<char*>(vectors[vectorIndex].iov_base) + remaining;
+                vectors[vectorIndex].iov_len -= remaining;
+            }
+        }
+
+        for (size_t i = runStart; i < runLength; ++i)
+        {
+            m_buffers[ready[i]].m_state = WriteBufferState::Free;
+        }
+
+        wroteData = true;
+        runStart = runLength;
+    }
+
+    if (wroteData && m_fd >= 0 && ShouldSync())
+    {
+#if defined(__APPLE__)
+        fsync(m_fd);
+#else
+        fdatasync(m_fd);
+#endif
+    }
+}
+
+void AsyncFileLogger::CloseRetiredFiles()
+{
+    auto iter = std::remove_if(m_retiredFiles.begin(), m_retiredFiles.end(), [this](const RetiredFile& file)
+    {
+        bool inUse = std::any_of(m_buffers.cbegin(), m_buffers.cend(), [&file](const WriteBuffer& buffer){ return buffer.m_fd == file.m_fd && (buffer.m_state == WriteBufferState::InFlight || buffer.m_state == WriteBufferState::Ready); });
+        if (!inUse)
+        {
+            close(file.m_fd);
+            m_archiver->ArchiveFile(file.m_path);
+        }
+
+        return !inUse;
+    });
+
+    m_retiredFiles.erase(iter, m_retiredFiles.end());
+}
+
+} // namespace Logging
+} // namespace IP
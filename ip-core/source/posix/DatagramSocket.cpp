@@ -0,0 +1,262 @@
+#include <ip/core/utils/DatagramSocket.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace IP
+{
+namespace System
+{
+
+static const intptr_t INVALID_HANDLE = -1;
+
+// datagrams handed to the kernel per sendmmsg call
+static const size_t SEND_BATCH_SIZE = 64;
+
+// the largest datagram Receive accepts; anything longer is truncated
+static const size_t MAX_RECEIVE_SIZE = 64 * 1024;
+
+static bool BuildSocketAddress(const char* path, struct sockaddr_un& address)
+{
+    size_t length = strlen(path);
+
+    memset(&address, 0, sizeof(address));
+    if (length == 0 || length >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path, length);
+
+    return true;
+}
+
+static int OpenSocket()
+{
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    return fd;
+}
+
+static bool WaitForSocket(intptr_t handle, short events, std::chrono::milliseconds timeout)
+{
+    struct pollfd descriptor;
+    descriptor.fd = static_cast<int>(handle);
+    descriptor.events = events;
+    descriptor.revents = 0;
+
+    int result;
+    do
+    {
+        result = poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    }
+    while (result < 0 && errno == EINTR);
+
+    return result > 0 && (descriptor.revents & events) != 0;
+}
+
+static DatagramSendStatus GetSendErrorStatus(int error)
+{
+    if (error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS)
+    {
+        return DatagramSendStatus::WouldBlock;
+    }
+
+    return error == EMSGSIZE ? DatagramSendStatus::TooLarge : DatagramSendStatus::Disconnected;
+}
+
+DatagramSocket::DatagramSocket() :
+    m_handle(INVALID_HANDLE),
+    m_boundPath()
+{
+}
+
+DatagramSocket::~DatagramSocket()
+{
+    Close();
+}
+
+bool DatagramSocket::Connect(const char* path)
+{
+    Close();
+
+    struct sockaddr_un address;
+    if (!BuildSocketAddress(path, address))
+    {
+        return false;
+    }
+
+    int fd = OpenSocket();
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (connect(fd, reinterpret_cast<const struct sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    m_handle = fd;
+
+    return true;
+}
+
+bool DatagramSocket::Bind(const char* path)
+{
+    Close();
+
+    struct sockaddr_un address;
+    if (!BuildSocketAddress(path, address))
+    {
+        return false;
+    }
+
+    int fd = OpenSocket();
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    unlink(path);
+    if (bind(fd, reinterpret_cast<const struct sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    m_handle = fd;
+    m_boundPath = path;
+
+    return true;
+}
+
+void DatagramSocket::Close()
+{
+    if (m_handle != INVALID_HANDLE)
+    {
+        close(static_cast<int>(m_handle));
+        m_handle = INVALID_HANDLE;
+    }
+
+    if (!m_boundPath.empty())
+    {
+        unlink(m_boundPath.c_str());
+        m_boundPath.clear();
+    }
+}
+
+DatagramSendStatus DatagramSocket::Send(const DatagramBuffer* datagrams, size_t count, size_t& sentCount)
+{
+    sentCount = 0;
+
+    if (m_handle == INVALID_HANDLE)
+    {
+        return DatagramSendStatus::Disconnected;
+    }
+
+    int fd = static_cast<int>(m_handle);
+
+#if defined(__linux__)
+    struct iovec vectors[SEND_BATCH_SIZE];
+    struct mmsghdr messages[SEND_BATCH_SIZE];
+
+    while (sentCount < count)
+    {
+        size_t batchCount = std::min(count - sentCount, SEND_BATCH_SIZE);
+        for (size_t i = 0; i < batchCount; ++i)
+        {
+            const DatagramBuffer& datagram = datagrams[sentCount + i];
+            vectors[i].iov_base = const_cast<char*>(datagram.m_data);
+            vectors[i].iov_len = datagram.m_length;
+
+            memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int sent = sendmmsg(fd, messages, static_cast<unsigned int>(batchCount), MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return GetSendErrorStatus(errno);
+        }
+
+        sentCount += static_cast<size_t>(sent);
+    }
+#else
+    while (sentCount < count)
+    {
+        const DatagramBuffer& datagram = datagrams[sentCount];
+        if (send(fd, datagram.m_data, datagram.m_length, 0) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return GetSendErrorStatus(errno);
+        }
+
+        ++sentCount;
+    }
+#endif
+
+    return DatagramSendStatus::Sent;
+}
+
+bool DatagramSocket::WaitUntilWritable(std::chrono::milliseconds timeout)
+{
+    return m_handle != INVALID_HANDLE && WaitForSocket(m_handle, POLLOUT, timeout);
+}
+
+bool DatagramSocket::Receive(IP::String& datagram, std::chrono::milliseconds timeout)
+{
+    if (m_handle == INVALID_HANDLE || !WaitForSocket(m_handle, POLLIN, timeout))
+    {
+        return false;
+    }
+
+    datagram.resize(MAX_RECEIVE_SIZE);
+
+    ssize_t length;
+    do
+    {
+        length = recv(static_cast<int>(m_handle), &datagram[0], datagram.size(), 0);
+    }
+    while (length < 0 && errno == EINTR);
+
+    if (length < 0)
+    {
+        datagram.clear();
+        return false;
+    }
+
+    datagram.resize(static_cast<size_t>(length));
+
+    return true;
+}
+
+} // namespace System
+} // namespace IP
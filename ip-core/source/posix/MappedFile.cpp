@@ -0,0 +1,154 @@
+#include <ip/core/utils/MappedFile.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+static const intptr_t INVALID_HANDLE = -1;
+
+MappedFile::MappedFile() :
+    m_handle(INVALID_HANDLE),
+    m_mode(MappedFileMode::ReadOnly),
+    m_size(0),
+    m_view(nullptr),
+    m_viewLength(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::experimental::filesystem::path& path, MappedFileMode mode)
+{
+    Close();
+
+    int flags = (mode == MappedFileMode::ReadWrite) ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY;
+    int fd = open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStats;
+    if (fstat(fd, &fileStats) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    m_handle = fd;
+    m_mode = mode;
+    m_size = static_cast<uint64_t>(fileStats.st_size);
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    Unmap();
+
+    if (m_handle != INVALID_HANDLE)
+    {
+        close(static_cast<int>(m_handle));
+        m_handle = INVALID_HANDLE;
+    }
+
+    m_size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_handle != INVALID_HANDLE;
+}
+
+uint64_t MappedFile::GetSize() const
+{
+    return m_size;
+}
+
+bool MappedFile::Resize(uint64_t size)
+{
+    if (m_handle == INVALID_HANDLE || m_mode != MappedFileMode::ReadWrite)
+    {
+        return false;
+    }
+
+    Unmap();
+
+    int fd = static_cast<int>(m_handle);
+    bool resized = false;
+
+#if defined(__linux__)
+    if (size > m_size)
+    {
+        // allocate real blocks so writes through the view can't fail with SIGBUS on a full disk; if they can't be
+        // allocated the resize fails rather than falling back to a sparse file that would
+        resized = posix_fallocate(fd, static_cast<off_t>(m_size), static_cast<off_t>(size - m_size)) == 0;
+    }
+    else
+    {
+        resized = ftruncate(fd, static_cast<off_t>(size)) == 0;
+    }
+#else
+    resized = ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+
+    if (resized)
+    {
+        m_size = size;
+    }
+
+    return resized;
+}
+
+char* MappedFile::Map(uint64_t offset, size_t length)
+{
+    Unmap();
+
+    if (m_handle == INVALID_HANDLE || length == 0 || offset % GetMappingGranularity() != 0)
+    {
+        return nullptr;
+    }
+
+    int protection = (m_mode == MappedFileMode::ReadWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* view = mmap(nullptr, length, protection, MAP_SHARED, static_cast<int>(m_handle), static_cast<off_t>(offset));
+    if (view == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    m_view = view;
+    m_viewLength = length;
+
+    return static_cast<char*>(m_view);
+}
+
+void MappedFile::Unmap()
+{
+    if (m_view != nullptr)
+    {
+        munmap(m_view, m_viewLength);
+        m_view = nullptr;
+        m_viewLength = 0;
+    }
+}
+
+size_t MappedFile::GetMappingGranularity()
+{
+    static const size_t granularity = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    return granularity;
+}
+
+} // namespace FileUtils
+} // namespace IP
@@ -0,0 +1,120 @@
+#include <ip/core/utils/OutputFile.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+static const intptr_t INVALID_HANDLE = -1;
+
+OutputFile::OutputFile() :
+    m_handle(INVALID_HANDLE)
+{
+}
+
+OutputFile::~OutputFile()
+{
+    Close();
+}
+
+bool OutputFile::Open(const std::experimental::filesystem::path& path)
+{
+    Close();
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    m_handle = fd;
+    return true;
+}
+
+bool OutputFile::OpenForAppend(const char* path)
+{
+    Close();
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    m_handle = fd;
+    return true;
+}
+
+void OutputFile::Close()
+{
+    if (m_handle != INVALID_HANDLE)
+    {
+        close(static_cast<int>(m_handle));
+        m_handle = INVALID_HANDLE;
+    }
+}
+
+bool OutputFile::IsOpen() const
+{
+    return m_handle != INVALID_HANDLE;
+}
+
+bool OutputFile::Write(const void* data, size_t length, size_t* writtenLength)
+{
+    if (writtenLength != nullptr)
+    {
+        *writtenLength = 0;
+    }
+
+    if (m_handle == INVALID_HANDLE)
+    {
+        return false;
+    }
+
+    const char* remaining = static_cast<const char*>(data);
+    while (length > 0)
+    {
+        ssize_t written = write(static_cast<int>(m_handle), remaining, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        remaining += written;
+        length -= static_cast<size_t>(written);
+        if (writtenLength != nullptr)
+        {
+            *writtenLength += static_cast<size_t>(written);
+        }
+    }
+
+    return true;
+}
+
+bool OutputFile::SyncData()
+{
+    if (m_handle == INVALID_HANDLE)
+    {
+        return false;
+    }
+
+#if defined(__APPLE__)
+    return fsync(static_cast<int>(m_handle)) == 0;
+#else
+    return fdatasync(static_cast<int>(m_handle)) == 0;
+#endif
+}
+
+} // namespace FileUtils
+} // namespace IP
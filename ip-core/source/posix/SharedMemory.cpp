@@ -0,0 +1,190 @@
+#include <ip/core/utils/SharedMemory.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace IP
+{
+namespace System
+{
+
+static const intptr_t INVALID_HANDLE = -1;
+
+// creating gives up if a segment left behind under the name keeps being replaced by other creators
+static const uint32_t MAX_CREATE_ATTEMPTS = 4;
+
+// shm_open wants names of the form "/name"
+static IP::String BuildSharedMemoryName(const char* name)
+{
+    return name[0] == '/' ? IP::String(name) : IP::String("/") + name;
+}
+
+SharedMemory::SharedMemory() :
+    m_handle(INVALID_HANDLE),
+    m_name(),
+    m_isOwner(false),
+    m_data(nullptr),
+    m_size(0)
+{
+}
+
+SharedMemory::~SharedMemory()
+{
+    Close();
+}
+
+// whether the name still refers to the segment open on fd
+static bool IsNamedSegment(const IP::String& name, int fd)
+{
+    int namedFd = shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (namedFd < 0)
+    {
+        return false;
+    }
+
+    struct stat segmentStats;
+    struct stat namedStats;
+    bool same = fstat(fd, &segmentStats) == 0 && fstat(namedFd, &namedStats) == 0 && segmentStats.st_dev == namedStats.st_dev && segmentStats.st_ino == namedStats.st_ino;
+    close(namedFd);
+
+    return same;
+}
+
+// Removes the segment under the name if its creator has exited; returns false if it's still in use.  The lock is held
+// until the name is gone, and the name is checked against the locked segment, so a live segment is never removed.
+static bool RemoveAbandonedSegment(const IP::String& name)
+{
+    int existingFd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (existingFd < 0)
+    {
+        return errno == ENOENT;
+    }
+
+    bool abandoned = flock(existingFd, LOCK_EX | LOCK_NB) == 0;
+    if (abandoned && IsNamedSegment(name, existingFd))
+    {
+        shm_unlink(name.c_str());
+    }
+
+    close(existingFd);
+
+    return abandoned;
+}
+
+bool SharedMemory::Create(const char* name, size_t size)
+{
+    Close();
+
+    m_name = BuildSharedMemoryName(name);
+
+    // The creator holds an exclusive lock on the segment while it's open, so a segment whose lock can be taken was left
+    // behind by a creator that exited and can be replaced; one that's still locked is in use and keeps its name.  Until
+    // the new segment is locked another creator can take it for abandoned and replace it, so once locked it has to
+    // still be the one under the name.
+    int fd = -1;
+    for (uint32_t attempt = 0; fd < 0 && attempt < MAX_CREATE_ATTEMPTS; ++attempt)
+    {
+        fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd < 0 && (errno != EEXIST || !RemoveAbandonedSegment(m_name)))
+        {
+            return false;
+        }
+    }
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || !IsNamedSegment(m_name, fd))
+    {
+        close(fd);
+        return false;
+    }
+
+    m_handle = fd;
+    m_isOwner = true;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+
+    return true;
+}
+
+bool SharedMemory::Open(const char* name)
+{
+    Close();
+
+    m_name = BuildSharedMemoryName(name);
+
+    int fd = shm_open(m_name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    m_handle = fd;
+
+    struct stat segmentStats;
+    if (fstat(fd, &segmentStats) != 0 || segmentStats.st_size <= 0)
+    {
+        Close();
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(segmentStats.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+
+    return true;
+}
+
+void SharedMemory::Close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    if (m_handle != INVALID_HANDLE)
+    {
+        close(static_cast<int>(m_handle));
+        m_handle = INVALID_HANDLE;
+    }
+
+    if (m_isOwner)
+    {
+        shm_unlink(m_name.c_str());
+        m_isOwner = false;
+    }
+}
+
+} // namespace System
+} // namespace IP
@@ -0,0 +1,78 @@
+#include <ip/core/utils/StandardOutput.h>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+#ifdef IOV_MAX
+static const size_t MAX_WRITE_BUFFERS = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+static const size_t MAX_WRITE_BUFFERS = 16;
+#endif
+
+bool IsStandardOutputTerminal()
+{
+    return isatty(STDOUT_FILENO) != 0;
+}
+
+bool WriteStandardOutput(const OutputBuffer* buffers, size_t count)
+{
+    struct iovec vectors[MAX_WRITE_BUFFERS];
+
+    while (count > 0)
+    {
+        size_t vectorCount = std::min(count, MAX_WRITE_BUFFERS);
+        for (size_t i = 0; i < vectorCount; ++i)
+        {
+            vectors[i].iov_base = const_cast<void*>(buffers[i].m_data);
+            vectors[i].iov_len = buffers[i].m_length;
+        }
+
+        // retry until this group is fully written, skipping past whatever a partial write covered
+        struct iovec* remaining = vectors;
+        size_t remainingCount = vectorCount;
+        while (remainingCount > 0)
+        {
+            ssize_t written = writev(STDOUT_FILENO, remaining, static_cast<int>(remainingCount));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            size_t writtenBytes = static_cast<size_t>(written);
+            while (remainingCount > 0 && writtenBytes >= remaining->iov_len)
+            {
+                writtenBytes -= remaining->iov_len;
+                ++remaining;
+                --remainingCount;
+            }
+
+            if (remainingCount > 0)
+            {
+                remaining->iov_base = static_cast<char*>(remaining->iov_base) + writtenBytes;
+                remaining->iov_len -= writtenBytes;
+            }
+        }
+
+        buffers += vectorCount;
+        count -= vectorCount;
+    }
+
+    return true;
+}
+
+} // namespace FileUtils
+} // namespace IP
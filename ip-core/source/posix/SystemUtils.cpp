@@ -2,9 +2,17 @@
 
 #include <ip/core/memory/stl/StringStream.h>
 
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
 namespace IP
 {
 namespace System
@@ -21,5 +29,85 @@ IP::String GetProcessId()
     return ss.str();
 }
 
+bool IsProcessRunning(uint32_t processId)
+{
+    // signal 0 only checks that the process exists; EPERM means it does but belongs to someone else
+    return kill(static_cast<pid_t>(processId), 0) == 0 || errno == EPERM;
+}
+
+uint32_t GetCurrentThreadId()
+{
+#if defined(__linux__)
+    static thread_local uint32_t threadId = static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+    static thread_local uint32_t threadId = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pthread_self()));
+#endif
+
+    return threadId;
+}
+
+void LowerCurrentThreadPriority()
+{
+#if defined(__linux__)
+    // on Linux nice values and I/O priorities apply per thread when addressed by thread id
+    pid_t threadId = static_cast<pid_t>(syscall(SYS_gettid));
+    setpriority(PRIO_PROCESS, static_cast<id_t>(threadId), 19);
+
+    static const int IOPRIO_CLASS_IDLE = 3;
+    static const int IOPRIO_CLASS_SHIFT = 13;
+    static const int IOPRIO_WHO_PROCESS = 1;
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, threadId, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+#endif
+}
+
+static FatalErrorHandler s_fatalErrorHandler = nullptr;
+
+static const struct
+{
+    int m_signal;
+    const char* m_description;
+} s_fatalSignals[] = {
+    { SIGSEGV, "SIGSEGV" },
+    { SIGBUS, "SIGBUS" },
+    { SIGFPE, "SIGFPE" },
+    { SIGILL, "SIGILL" },
+    { SIGABRT, "SIGABRT" }
+};
+
+static void FatalSignalHandler(int signalNumber)
+{
+    const char* description = "fatal signal";
+    for (const auto& fatalSignal : s_fatalSignals)
+    {
+        if (fatalSignal.m_signal == signalNumber)
+        {
+            description = fatalSignal.m_description;
+        }
+    }
+
+    if (s_fatalErrorHandler != nullptr)
+    {
+        s_fatalErrorHandler(description);
+    }
+
+    // SA_RESETHAND restored the default action, so this terminates (and dumps core) as it would have
+    raise(signalNumber);
+}
+
+void InstallFatalErrorHandler(FatalErrorHandler handler)
+{
+    s_fatalErrorHandler = handler;
+
+    struct sigaction action = {};
+    action.sa_handler = FatalSignalHandler;
+    action.sa_flags = SA_RESETHAND | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+
+    for (const auto& fatalSignal : s_fatalSignals)
+    {
+        sigaction(fatalSignal.m_signal, &action, nullptr);
+    }
+}
+
 }
 }
\ No newline at end of file
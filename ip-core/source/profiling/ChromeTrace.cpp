@@ -0,0 +1,128 @@
+#include <ip/core/profiling/ChromeTrace.h>
+
+#include <algorithm>
+#include <stdio.h>
+
+#include <ip/core/utils/OutputFile.h>
+#include <ip/core/utils/StringUtils.h>
+#include <ip/core/utils/SystemUtils.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+static void AppendJsonString(IP::String& buffer, const char* value)
+{
+    buffer.push_back('"');
+
+    for (const char* c = value; *c != 0; ++c)
+    {
+        switch (*c)
+        {
+            case '"': buffer.append("\\\""); break;
+            case '\\': buffer.append("\\\\"); break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    char escape[8];
+                    snprintf(escape, sizeof(escape), "\\u%04x", *c);
+                    buffer.append(escape);
+                }
+                else
+                {
+                    buffer.push_back(*c);
+                }
+                break;
+        }
+    }
+
+    buffer.push_back('"');
+}
+
+static void AppendMicroseconds(IP::String& buffer, const ProfileCapture& capture, uint64_t baseTimestamp, uint64_t timestamp)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "%.3f", GetProfileNanoseconds(capture, baseTimestamp, timestamp) / 1000.0);
+    buffer.append(text);
+}
+
+static uint64_t FindEarliestTimestamp(const ProfileCapture& capture)
+{
+    uint64_t earliest = UINT64_MAX;
+
+    for (const auto& thread : capture.m_threads)
+    {
+        if (!thread.m_events.empty())
+        {
+            earliest = std::min(earliest, thread.m_events.front().m_startTimestamp);
+        }
+    }
+
+    if (!capture.m_frameTimestamps.empty())
+    {
+        earliest = std::min(earliest, capture.m_frameTimestamps.front());
+    }
+
+    return earliest == UINT64_MAX ? 0 : earliest;
+}
+
+void AppendChromeTrace(IP::String& buffer, const ProfileCapture& capture)
+{
+    IP::String processId = IP::System::GetProcessId();
+    uint64_t baseTimestamp = FindEarliestTimestamp(capture);
+
+    buffer.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    const char* separator = "\n";
+    for (const auto& thread : capture.m_threads)
+    {
+        IP::String threadId;
+        IP::StringUtils::AppendZeroPaddedInteger(threadId, thread.m_threadId, 0);
+
+        IP::String threadName = thread.m_threadName.empty() ? IP::String("Thread ") + threadId : thread.m_threadName;
+
+        buffer.append(separator);
+        separator = ",\n";
+        buffer.append("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + processId + ",\"tid\":" + threadId + ",\"args\":{\"name\":");
+        AppendJsonString(buffer, threadName.c_str());
+        buffer.append("}}");
+
+        for (const auto& event : thread.m_events)
+        {
+            buffer.append(",\n{\"ph\":\"X\",\"name\":");
+            AppendJsonString(buffer, event.m_name);
+            buffer.append(",\"pid\":" + processId + ",\"tid\":" + threadId + ",\"ts\":");
+            AppendMicroseconds(buffer, capture, baseTimestamp, event.m_startTimestamp);
+            buffer.append(",\"dur\":");
+            AppendMicroseconds(buffer, capture, event.m_startTimestamp, event.m_endTimestamp);
+            buffer.push_back('}');
+        }
+    }
+
+    for (size_t frame = 0; frame < capture.m_frameTimestamps.size(); ++frame)
+    {
+        buffer.append(separator);
+        separator = ",\n";
+        buffer.append("{\"ph\":\"i\",\"s\":\"g\",\"name\":\"Frame ");
+        IP::StringUtils::AppendZeroPaddedInteger(buffer, frame, 0);
+        buffer.append("\",\"pid\":" + processId + ",\"tid\":0,\"ts\":");
+        AppendMicroseconds(buffer, capture, baseTimestamp, capture.m_frameTimestamps[frame]);
+        buffer.push_back('}');
+    }
+
+    buffer.append("\n]}\n");
+}
+
+bool WriteChromeTrace(const ProfileCapture& capture, const std::experimental::filesystem::path& path)
+{
+    IP::String trace;
+    AppendChromeTrace(trace, capture);
+
+    IP::FileUtils::OutputFile file;
+
+    return file.Open(path) && file.Write(trace.data(), trace.size());
+}
+
+} // namespace Profiling
+} // namespace IP
@@ -0,0 +1,162 @@
+#include <ip/core/profiling/ProfileReport.h>
+
+#include <algorithm>
+#include <stdio.h>
+
+#include <ip/core/memory/stl/Map.h>
+#include <ip/core/memory/stl/UnorderedMap.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+struct ScopeTotals
+{
+    ScopeTotals() :
+        m_calls(0),
+        m_totalNanoseconds(0),
+        m_selfNanoseconds(0),
+        m_frameTotalNanoseconds()
+    {}
+
+    uint64_t m_calls;
+    int64_t m_totalNanoseconds;
+    int64_t m_selfNanoseconds;
+    IP::Vector<int64_t> m_frameTotalNanoseconds;
+};
+
+// the time spent in each event's direct children; the events are in the order they started, each with its depth
+static void SumChildTimes(const ProfileCapture& capture, const IP::Vector<ProfileEvent>& events, IP::Vector<int64_t>& childNanoseconds)
+{
+    childNanoseconds.assign(events.size(), 0);
+
+    // the latest event seen at each depth
+    IP::Vector<size_t> openEvents;
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const ProfileEvent& event = events[i];
+
+        if (openEvents.size() <= event.m_depth)
+        {
+            openEvents.resize(event.m_depth + 1, SIZE_MAX);
+        }
+        openEvents[event.m_depth] = i;
+
+        if (event.m_depth == 0 || openEvents[event.m_depth - 1] == SIZE_MAX)
+        {
+            continue;
+        }
+
+        // the parent may have been left out of the capture, still open
+        const ProfileEvent& parent = events[openEvents[event.m_depth - 1]];
+        if (parent.m_startTimestamp <= event.m_startTimestamp && parent.m_endTimestamp >= event.m_endTimestamp)
+        {
+            childNanoseconds[openEvents[event.m_depth - 1]] += static_cast<int64_t>(GetProfileNanoseconds(capture, event.m_startTimestamp, event.m_endTimestamp));
+        }
+    }
+}
+
+ProfileFrameReport BuildProfileFrameReport(const ProfileCapture& capture)
+{
+    ProfileFrameReport report;
+    report.m_frameCount = 0;
+    report.m_averageFrameTime = IP::Time::MonotonicDuration::zero();
+    report.m_maxFrameTime = IP::Time::MonotonicDuration::zero();
+
+    const IP::Vector<uint64_t>& frames = capture.m_frameTimestamps;
+    if (frames.size() < 2)
+    {
+        return report;
+    }
+
+    size_t frameCount = frames.size() - 1;
+    report.m_frameCount = frameCount;
+    report.m_averageFrameTime = IP::Time::ConvertNanosecondsToDuration(GetProfileNanoseconds(capture, frames.front(), frames.back()) / frameCount);
+
+    for (size_t frame = 0; frame < frameCount; ++frame)
+    {
+        report.m_maxFrameTime = std::max(report.m_maxFrameTime, IP::Time::ConvertNanosecondsToDuration(GetProfileNanoseconds(capture, frames[frame], frames[frame + 1])));
+    }
+
+    // names are compared by content, since the same literal can live at several addresses
+    IP::Map<IP::String, ScopeTotals> totalsByName;
+    IP::UnorderedMap<const char*, ScopeTotals*> totalsByPointer;
+    IP::Vector<int64_t> childNanoseconds;
+
+    for (const auto& thread : capture.m_threads)
+    {
+        SumChildTimes(capture, thread.m_events, childNanoseconds);
+
+        for (size_t i = 0; i < thread.m_events.size(); ++i)
+        {
+            const ProfileEvent& event = thread.m_events[i];
+
+            auto nextFrame = std::upper_bound(frames.begin(), frames.end(), event.m_startTimestamp);
+            if (nextFrame == frames.begin() || nextFrame == frames.end())
+            {
+                continue;
+            }
+
+            size_t frame = static_cast<size_t>(nextFrame - frames.begin()) - 1;
+
+            ScopeTotals*& totals = totalsByPointer[event.m_name];
+            if (totals == nullptr)
+            {
+                totals = &totalsByName[IP::String(event.m_name)];
+                totals->m_frameTotalNanoseconds.resize(frameCount, 0);
+            }
+
+            int64_t nanoseconds = static_cast<int64_t>(GetProfileNanoseconds(capture, event.m_startTimestamp, event.m_endTimestamp));
+
+            ++totals->m_calls;
+            totals->m_totalNanoseconds += nanoseconds;
+            totals->m_selfNanoseconds += nanoseconds - childNanoseconds[i];
+            totals->m_frameTotalNanoseconds[frame] += nanoseconds;
+        }
+    }
+
+    for (const auto& entry : totalsByName)
+    {
+        const ScopeTotals& totals = entry.second;
+
+        ProfileScopeStatistics statistics;
+        statistics.m_name = entry.first;
+        statistics.m_callsPerFrame = static_cast<double>(totals.m_calls) / frameCount;
+        statistics.m_totalTime = IP::Time::ConvertNanosecondsToDuration(static_cast<double>(totals.m_totalNanoseconds) / frameCount);
+        statistics.m_selfTime = IP::Time::ConvertNanosecondsToDuration(static_cast<double>(totals.m_selfNanoseconds) / frameCount);
+        statistics.m_maxFrameTotalTime = IP::Time::ConvertNanosecondsToDuration(static_cast<double>(*std::max_element(totals.m_frameTotalNanoseconds.begin(), totals.m_frameTotalNanoseconds.end())));
+
+        report.m_scopes.push_back(std::move(statistics));
+    }
+
+    std::sort(report.m_scopes.begin(), report.m_scopes.end(), [](const ProfileScopeStatistics& lhs, const ProfileScopeStatistics& rhs) { return lhs.m_totalTime > rhs.m_totalTime; });
+
+    return report;
+}
+
+void FormatProfileFrameReport(IP::String& buffer, const ProfileFrameReport& report)
+{
+    char line[256];
+
+    snprintf(line, sizeof(line), "%zu frames, average %.3f ms, worst %.3f ms\n", report.m_frameCount, IP::Time::ConvertDurationToMilliseconds(report.m_averageFrameTime), IP::Time::ConvertDurationToMilliseconds(report.m_maxFrameTime));
+    buffer.append(line);
+
+    snprintf(line, sizeof(line), "%-40s %12s %10s %10s %10s\n", "scope", "calls/frame", "total ms", "self ms", "max ms");
+    buffer.append(line);
+
+    for (const auto& scope : report.m_scopes)
+    {
+        snprintf(line, sizeof(line), "%-40.40s %12.2f %10.3f %10.3f %10.3f\n",
+            scope.m_name.c_str(),
+            scope.m_callsPerFrame,
+            IP::Time::ConvertDurationToMilliseconds(scope.m_totalTime),
+            IP::Time::ConvertDurationToMilliseconds(scope.m_selfTime),
+            IP::Time::ConvertDurationToMilliseconds(scope.m_maxFrameTotalTime));
+        buffer.append(line);
+    }
+}
+
+} // namespace Profiling
+} // namespace IP
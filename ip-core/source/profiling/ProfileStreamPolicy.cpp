@@ -0,0 +1,15 @@
+#include <ip/core/profiling/ProfileStreamPolicy.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+ProfileStreamPolicy::ProfileStreamPolicy() :
+    m_threadBufferCapacity(64 * 1024),
+    m_flushInterval(10)
+{
+}
+
+} // namespace Profiling
+} // namespace IP
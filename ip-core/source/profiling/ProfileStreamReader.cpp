@@ -0,0 +1,251 @@
+#include <ip/core/profiling/ProfileStreamFormat.h>
+
+#include <algorithm>
+#include <string.h>
+
+#include <ip/core/memory/stl/UnorderedMap.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+static const size_t NO_EVENT = SIZE_MAX;
+
+// A thread's scopes are added to its capture as they begin, so they stay in the order they were entered, and filled in
+// as they end
+struct StreamThreadState
+{
+    size_t m_captureIndex;
+
+    // per depth, the capture event of the scope open at that depth
+    IP::Vector<size_t> m_openEvents;
+};
+
+class ProfileStreamDecoder
+{
+    public:
+
+        ProfileStreamDecoder(const char* data, size_t length, ProfileCapture& capture) :
+            m_data(data),
+            m_length(length),
+            m_position(0),
+            m_capture(capture),
+            m_names(),
+            m_threads()
+        {
+        }
+
+        bool Decode()
+        {
+            if (m_length < sizeof(PROFILE_STREAM_MAGIC) || memcmp(m_data, PROFILE_STREAM_MAGIC, sizeof(PROFILE_STREAM_MAGIC)) != 0)
+            {
+                return false;
+            }
+
+            m_position = sizeof(PROFILE_STREAM_MAGIC);
+
+            while (ReadRecord())
+            {
+            }
+
+            RemoveOpenEvents();
+
+            return true;
+        }
+
+    private:
+
+        bool ReadRecord()
+        {
+            ProfileStreamRecordType type;
+            if (!ReadValue(type))
+            {
+                return false;
+            }
+
+            switch (type)
+            {
+                case ProfileStreamRecordType::Calibration:
+                    return ReadValue(m_capture.m_nanosecondsPerTick);
+
+                case ProfileStreamRecordType::Thread:
+                    return ReadThread();
+
+                case ProfileStreamRecordType::Name:
+                    return ReadName();
+
+                case ProfileStreamRecordType::Events:
+                    return ReadEvents();
+
+                case ProfileStreamRecordType::Dropped:
+                {
+                    uint16_t threadIndex = 0;
+                    uint64_t droppedEvents = 0;
+                    if (!ReadValue(threadIndex) || !ReadValue(droppedEvents))
+                    {
+                        return false;
+                    }
+
+                    GetThreadCapture(threadIndex).m_droppedEvents += droppedEvents;
+                    return true;
+                }
+
+                default:
+                    return false;
+            }
+        }
+
+        bool ReadThread()
+        {
+            uint16_t threadIndex = 0;
+            uint32_t threadId = 0;
+            IP::String name;
+            if (!ReadValue(threadIndex) || !ReadValue(threadId) || !ReadString(name))
+            {
+                return false;
+            }
+
+            ProfileThreadCapture& thread = GetThreadCapture(threadIndex);
+            thread.m_threadId = threadId;
+            thread.m_threadName = name;
+
+            return true;
+        }
+
+        bool ReadName()
+        {
+            uint32_t nameId = 0;
+            IP::String name;
+            if (!ReadValue(nameId) || !ReadString(name))
+            {
+                return false;
+            }
+
+            m_capture.m_names.push_back(name);
+            m_names[nameId] = m_capture.m_names.back().c_str();
+
+            return true;
+        }
+
+        bool ReadEvents()
+        {
+            uint32_t count = 0;
+            if (!ReadValue(count) || m_length - m_position < static_cast<size_t>(count) * sizeof(ProfileStreamEvent))
+            {
+                return false;
+            }
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                ProfileStreamEvent event;
+                ReadValue(event);
+                AddEvent(event);
+            }
+
+            return true;
+        }
+
+        void AddEvent(const ProfileStreamEvent& event)
+        {
+            if (event.m_type == ProfileStreamEventType::Frame)
+            {
+                m_capture.m_frameTimestamps.push_back(event.m_timestamp);
+                return;
+            }
+
+            GetThreadCapture(event.m_threadIndex);
+            StreamThreadState& state = m_threads[event.m_threadIndex];
+            ProfileThreadCapture& thread = m_capture.m_threads[state.m_captureIndex];
+
+            if (state.m_openEvents.size() <= event.m_depth)
+            {
+                state.m_openEvents.resize(event.m_depth + 1, NO_EVENT);
+            }
+
+            if (event.m_type == ProfileStreamEventType::Begin)
+            {
+                auto name = m_names.find(event.m_nameId);
+
+                // a begin replaces one at the same depth whose end was dropped
+                state.m_openEvents[event.m_depth] = thread.m_events.size();
+                thread.m_events.push_back({ name != m_names.end() ? name->second : "", event.m_timestamp, 0, event.m_depth });
+            }
+            else if (event.m_type == ProfileStreamEventType::End && state.m_openEvents[event.m_depth] != NO_EVENT)
+            {
+                thread.m_events[state.m_openEvents[event.m_depth]].m_endTimestamp = event.m_timestamp;
+                state.m_openEvents[event.m_depth] = NO_EVENT;
+            }
+        }
+
+        ProfileThreadCapture& GetThreadCapture(uint16_t threadIndex)
+        {
+            auto found = m_threads.find(threadIndex);
+            if (found == m_threads.end())
+            {
+                found = m_threads.emplace(threadIndex, StreamThreadState{ m_capture.m_threads.size(), IP::Vector<size_t>() }).first;
+                m_capture.m_threads.emplace_back();
+            }
+
+            return m_capture.m_threads[found->second.m_captureIndex];
+        }
+
+        // scopes that never ended
+        void RemoveOpenEvents()
+        {
+            for (auto& thread : m_capture.m_threads)
+            {
+                auto& events = thread.m_events;
+                events.erase(std::remove_if(events.begin(), events.end(), [](const ProfileEvent& event) { return event.m_endTimestamp == 0; }), events.end());
+            }
+        }
+
+        bool ReadBytes(void* destination, size_t length)
+        {
+            if (m_length - m_position < length)
+            {
+                return false;
+            }
+
+            memcpy(destination, m_data + m_position, length);
+            m_position += length;
+
+            return true;
+        }
+
+        bool ReadString(IP::String& value)
+        {
+            uint32_t length = 0;
+            if (!ReadValue(length) || m_length - m_position < length)
+            {
+                return false;
+            }
+
+            value.assign(m_data + m_position, length);
+            m_position += length;
+
+            return true;
+        }
+
+        template<typename T>
+        bool ReadValue(T& value) { return ReadBytes(&value, sizeof(value)); }
+
+        const char* m_data;
+        size_t m_length;
+        size_t m_position;
+
+        ProfileCapture& m_capture;
+
+        IP::UnorderedMap<uint32_t, const char*> m_names;
+        IP::UnorderedMap<uint16_t, StreamThreadState> m_threads;
+};
+
+bool ReadProfileStream(const char* data, size_t length, ProfileCapture& capture)
+{
+    ProfileStreamDecoder decoder(data, length, capture);
+
+    return decoder.Decode();
+}
+
+} // namespace Profiling
+} // namespace IP
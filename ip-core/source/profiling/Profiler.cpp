@@ -0,0 +1,840 @@
+#include <ip/core/profiling/Profiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <ip/core/logging/LogSystem.h>
+#include <ip/core/memory/Memory.h>
+#include <ip/core/memory/stl/UnorderedMap.h>
+#include <ip/core/profiling/ProfileStreamFormat.h>
+#include <ip/core/utils/OutputFile.h>
+#include <ip/core/utils/SystemUtils.h>
+
+namespace IP
+{
+namespace Profiling
+{
+
+static const size_t EVENT_BLOCK_SIZE = 4096;
+
+// 1M scopes, 32MB, per thread per capture; scopes past that are counted and dropped
+static const size_t MAX_EVENT_BLOCKS = 256;
+
+struct ProfileEventRecord
+{
+    const char* m_name;
+    uint64_t m_startTimestamp;
+
+    // written by the owning thread while captures may be reading; zero until the scope ends
+    std::atomic<uint64_t> m_endTimestamp;
+    uint32_t m_depth;
+};
+
+struct ProfileEventBlock
+{
+    ProfileEventRecord m_records[EVENT_BLOCK_SIZE];
+};
+
+// An event waiting in a thread's stream buffer; the writer swaps the name for an id
+struct ProfileStreamRecord
+{
+    uint64_t m_timestamp;
+    const char* m_name;
+    ProfileStreamEventType m_type;
+    uint8_t m_depth;
+};
+
+static const size_t CACHE_LINE_SIZE = 64;
+
+// Single producer, single consumer ring: the owning thread writes, the stream writer reads.  The indices only ever
+// increase, and each lives on its own cache line so the two sides don't contend.
+class ProfileStreamRing
+{
+    public:
+
+        ProfileStreamRing(size_t capacity) :
+            m_records(capacity),
+            m_mask(capacity - 1),
+            m_cachedReadIndex(0),
+            m_writeIndex(0),
+            m_readIndex(0)
+        {
+        }
+
+        // owning thread only; false if the ring is full
+        bool Push(const ProfileStreamRecord& record)
+        {
+            size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+
+            if (writeIndex - m_cachedReadIndex == m_records.size())
+            {
+                m_cachedReadIndex = m_readIndex.load(std::memory_order_acquire);
+                if (writeIndex - m_cachedReadIndex == m_records.size())
+                {
+                    return false;
+                }
+            }
+
+            m_records[writeIndex & m_mask] = record;
+            m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // writer only; appends everything published so far
+        void Drain(IP::Vector<ProfileStreamRecord>& records)
+        {
+            size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+            size_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+            for (; readIndex != writeIndex; ++readIndex)
+            {
+                records.push_back(m_records[readIndex & m_mask]);
+            }
+
+            m_readIndex.store(readIndex, std::memory_order_release);
+        }
+
+    private:
+
+        IP::Vector<ProfileStreamRecord> m_records;
+        size_t m_mask;
+
+        // owning thread only
+        size_t m_cachedReadIndex;
+
+        char m_writePadding[CACHE_LINE_SIZE];
+        std::atomic<size_t> m_writeIndex;
+
+        char m_readPadding[CACHE_LINE_SIZE];
+        std::atomic<size_t> m_readIndex;
+};
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+// One per thread that has entered a scope.  Only the owning thread appends; captures copy out everything published so
+// far.  Blocks are kept, not freed, when a new capture starts, and the lock is only taken to add a block, to restart,
+// to rename and to capture.  A capture holds at most MAX_EVENT_BLOCKS blocks, so a long session can't grow without
+// bound; those should stream instead.
+class ProfileThreadBuffer
+{
+    public:
+
+        ProfileThreadBuffer() :
+            m_lock(),
+            m_threadId(IP::System::GetCurrentThreadId()),
+            m_threadName(),
+            m_generation(0),
+            m_blocks(),
+            m_eventCount(0),
+            m_droppedEvents(0),
+            m_streamRing(),
+            m_droppedStreamEvents(0),
+            m_depth(0),
+            m_threadExited(false)
+        {
+        }
+
+        ProfileEventRecord* Begin(const char* name, uint32_t generation)
+        {
+            if (generation != m_generation)
+            {
+                Restart(generation);
+            }
+
+            size_t eventCount = m_eventCount.load(std::memory_order_relaxed);
+            size_t blockIndex = eventCount / EVENT_BLOCK_SIZE;
+            if (blockIndex == MAX_EVENT_BLOCKS)
+            {
+                m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            if (blockIndex == m_blocks.size())
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_blocks.push_back(IP::MakeUnique<ProfileEventBlock>(MEMORY_TAG));
+            }
+
+            ProfileEventRecord* record = &m_blocks[blockIndex]->m_records[eventCount % EVENT_BLOCK_SIZE];
+            record->m_name = name;
+            record->m_depth = m_depth++;
+            record->m_endTimestamp.store(0, std::memory_order_relaxed);
+            record->m_startTimestamp = IP::Time::ReadTimestamp();
+
+            m_eventCount.store(eventCount + 1, std::memory_order_release);
+
+            return record;
+        }
+
+        void End(ProfileEventRecord* record, uint32_t generation)
+        {
+            uint64_t endTimestamp = IP::Time::ReadTimestamp();
+
+            --m_depth;
+            if (generation == m_generation)
+            {
+                record->m_endTimestamp.store(endTimestamp, std::memory_order_release);
+            }
+        }
+
+        // false if the event was dropped, since the writer hasn't kept up
+        bool StreamBegin(const char* name, uint32_t generation, size_t ringCapacity)
+        {
+            if (generation != m_generation || !m_streamRing)
+            {
+                RestartStream(generation, ringCapacity);
+            }
+
+            ProfileStreamRecord record = { IP::Time::ReadTimestamp(), name, ProfileStreamEventType::Begin, static_cast<uint8_t>(std::min<uint32_t>(m_depth, UINT8_MAX)) };
+            if (!PushStreamRecord(record))
+            {
+                return false;
+            }
+
+            ++m_depth;
+            return true;
+        }
+
+        void StreamEnd(uint32_t generation)
+        {
+            uint64_t endTimestamp = IP::Time::ReadTimestamp();
+
+            --m_depth;
+            if (generation == m_generation)
+            {
+                PushStreamRecord({ endTimestamp, nullptr, ProfileStreamEventType::End, static_cast<uint8_t>(std::min<uint32_t>(m_depth, UINT8_MAX)) });
+            }
+        }
+
+        void StreamFrame(uint32_t generation, size_t ringCapacity)
+        {
+            if (generation != m_generation || !m_streamRing)
+            {
+                RestartStream(generation, ringCapacity);
+            }
+
+            PushStreamRecord({ IP::Time::ReadTimestamp(), nullptr, ProfileStreamEventType::Frame, 0 });
+        }
+
+        // writer only; appends the events published so far and takes the count of those dropped since the last drain
+        void DrainStream(uint32_t generation, IP::Vector<ProfileStreamRecord>& records, uint64_t& droppedEvents, IP::String& threadName)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            droppedEvents = 0;
+            threadName = m_threadName;
+
+            if (generation != m_generation || !m_streamRing)
+            {
+                return;
+            }
+
+            m_streamRing->Drain(records);
+            droppedEvents = m_droppedStreamEvents.exchange(0, std::memory_order_relaxed);
+        }
+
+        uint32_t GetThreadId() const { return m_threadId; }
+
+        void SetThreadName(const char* name)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_threadName = name;
+        }
+
+        // appends the thread's completed events, if it has recorded any in the given capture
+        void Capture(uint32_t generation, ProfileCapture& capture)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            if (generation != m_generation)
+            {
+                return;
+            }
+
+            size_t eventCount = m_eventCount.load(std::memory_order_acquire);
+            if (eventCount == 0)
+            {
+                return;
+            }
+
+            capture.m_threads.emplace_back();
+            ProfileThreadCapture& thread = capture.m_threads.back();
+            thread.m_threadId = m_threadId;
+            thread.m_threadName = m_threadName;
+            thread.m_droppedEvents = m_droppedEvents.load(std::memory_order_relaxed);
+            thread.m_events.reserve(eventCount);
+
+            for (size_t i = 0; i < eventCount; ++i)
+            {
+                const ProfileEventRecord& record = m_blocks[i / EVENT_BLOCK_SIZE]->m_records[i % EVENT_BLOCK_SIZE];
+
+                uint64_t endTimestamp = record.m_endTimestamp.load(std::memory_order_acquire);
+                if (endTimestamp != 0)
+                {
+                    thread.m_events.push_back({ record.m_name, record.m_startTimestamp, endTimestamp, record.m_depth });
+                }
+            }
+        }
+
+        void MarkThreadExited() { m_threadExited.store(true, std::memory_order_relaxed); }
+        bool HasThreadExited() const { return m_threadExited.load(std::memory_order_relaxed); }
+
+    private:
+
+        void Restart(uint32_t generation)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_generation = generation;
+            m_eventCount.store(0, std::memory_order_relaxed);
+            m_droppedEvents.store(0, std::memory_order_relaxed);
+        }
+
+        // records left in the ring by an earlier stream are discarded along with it
+        void RestartStream(uint32_t generation, size_t ringCapacity)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_generation = generation;
+            m_eventCount.store(0, std::memory_order_relaxed);
+            m_streamRing = IP::MakeUnique<ProfileStreamRing>(MEMORY_TAG, ringCapacity);
+            m_droppedStreamEvents.store(0, std::memory_order_relaxed);
+        }
+
+        bool PushStreamRecord(const ProfileStreamRecord& record)
+        {
+            if (!m_streamRing->Push(record))
+            {
+                m_droppedStreamEvents.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            return true;
+        }
+
+        std::mutex m_lock;
+
+        uint32_t m_threadId;
+        IP::String m_threadName;
+
+        // the capture the buffer's events belong to
+        uint32_t m_generation;
+
+        // the vector is only resized by the owning thread, under the lock
+        IP::Vector<IP::UniquePtr<ProfileEventBlock>> m_blocks;
+        std::atomic<size_t> m_eventCount;
+
+        // scopes left out of the capture because the thread had used all its blocks
+        std::atomic<uint64_t> m_droppedEvents;
+
+        // only replaced by the owning thread, under the lock
+        IP::UniquePtr<ProfileStreamRing> m_streamRing;
+        std::atomic<uint64_t> m_droppedStreamEvents;
+
+        // owning thread only
+        uint32_t m_depth;
+
+        std::atomic<bool> m_threadExited;
+};
+
+struct ProfilerState;
+
+// Drains every thread's stream buffer to the file on its own thread, giving names and threads small ids as it first
+// sees them
+class ProfileStreamWriter
+{
+    public:
+
+        ProfileStreamWriter(ProfilerState& state, uint32_t generation, std::chrono::milliseconds flushInterval);
+        ~ProfileStreamWriter();
+
+        ProfileStreamWriter(const ProfileStreamWriter& rhs) = delete;
+        ProfileStreamWriter& operator =(const ProfileStreamWriter& rhs) = delete;
+
+        // creates the file and writes its header
+        bool Open(const std::experimental::filesystem::path& path);
+
+        void Start();
+
+        // drains whatever is left and closes the file; false if a write failed and the stream ended early
+        bool Stop();
+
+    private:
+
+        struct StreamThread
+        {
+            uint16_t m_index;
+            IP::String m_name;
+        };
+
+        void Run();
+        bool Flush();
+
+        uint16_t FindThreadIndex(const ProfileThreadBuffer& buffer, const IP::String& threadName);
+        uint32_t FindNameId(const char* name);
+
+        void AppendString(const IP::String& value);
+
+        template<typename T>
+        void AppendValue(T value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+        ProfilerState& m_state;
+        uint32_t m_generation;
+        std::chrono::milliseconds m_flushInterval;
+
+        IP::FileUtils::OutputFile m_file;
+        IP::UniquePtr<std::thread> m_thread;
+
+        std::mutex m_stopLock;
+        std::condition_variable m_stopSignal;
+        bool m_stopping;
+
+        // set by the writer thread when it gives up on the file
+        std::atomic<bool> m_failed;
+
+        // writer thread only
+        IP::UnorderedMap<const ProfileThreadBuffer*, StreamThread> m_threads;
+        IP::UnorderedMap<const char*, uint32_t> m_nameIds;
+        IP::Vector<std::shared_ptr<ProfileThreadBuffer>> m_threadBuffers;
+        IP::Vector<ProfileStreamRecord> m_records;
+        IP::String m_threadName;
+        IP::String m_buffer;
+};
+
+struct ProfilerState
+{
+    ProfilerState() :
+        m_profiling(false),
+        m_streaming(false),
+        m_generation(1),
+        m_streamRingCapacity(0),
+        m_lock(),
+        m_threadBuffers(),
+        m_frameTimestamps(),
+        m_controlLock(),
+        m_streamWriter()
+    {}
+
+    std::atomic<bool> m_profiling;
+    std::atomic<bool> m_streaming;
+    std::atomic<uint32_t> m_generation;
+    std::atomic<size_t> m_streamRingCapacity;
+
+    // guards the buffer list and the frame timestamps
+    std::mutex m_lock;
+    IP::Vector<std::shared_ptr<ProfileThreadBuffer>> m_threadBuffers;
+    IP::Vector<uint64_t> m_frameTimestamps;
+
+    // serializes starting and stopping, which for a stream waits on the writer, and so can't hold m_lock
+    std::mutex m_controlLock;
+    IP::UniquePtr<ProfileStreamWriter> m_streamWriter;
+};
+
+ProfileStreamWriter::ProfileStreamWriter(ProfilerState& state, uint32_t generation, std::chrono::milliseconds flushInterval) :
+    m_state(state),
+    m_generation(generation),
+    m_flushInterval(flushInterval),
+    m_file(),
+    m_thread(),
+    m_stopLock(),
+    m_stopSignal(),
+    m_stopping(false),
+    m_failed(false),
+    m_threads(),
+    m_nameIds(),
+    m_threadBuffers(),
+    m_records(),
+    m_threadName(),
+    m_buffer()
+{
+}
+
+ProfileStreamWriter::~ProfileStreamWriter()
+{
+    Stop();
+}
+
+bool ProfileStreamWriter::Open(const std::experimental::filesystem::path& path)
+{
+    if (!m_file.Open(path))
+    {
+        return false;
+    }
+
+    m_buffer.assign(PROFILE_STREAM_MAGIC, sizeof(PROFILE_STREAM_MAGIC));
+    AppendValue(ProfileStreamRecordType::Calibration);
+    AppendValue(IP::Time::GetTimestampCalibration().m_nanosecondsPerTick);
+
+    return m_file.Write(m_buffer.data(), m_buffer.size());
+}
+
+void ProfileStreamWriter::Start()
+{
+    m_thread = IP::MakeUnique<std::thread>(MEMORY_TAG, &ProfileStreamWriter::Run, this);
+}
+
+bool ProfileStreamWriter::Stop()
+{
+    if (!m_thread)
+    {
+        return !m_failed.load(std::memory_order_acquire);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_stopLock);
+        m_stopping = true;
+    }
+    m_stopSignal.notify_one();
+
+    m_thread->join();
+    m_thread.reset();
+
+    m_file.Close();
+
+    return !m_failed.load(std::memory_order_acquire);
+}
+
+void ProfileStreamWriter::Run()
+{
+    bool stopping = false;
+
+    while (!stopping)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_stopLock);
+            m_stopSignal.wait_for(lock, m_flushInterval, [&](){ return m_stopping; });
+            stopping = m_stopping;
+        }
+
+        if (!Flush())
+        {
+            // a short capture is better than one silently missing its end; recording stops until StopProfiling
+            LOG_ERROR("Profile stream write failed, stopping the stream");
+            m_failed.store(true, std::memory_order_release);
+            m_state.m_streaming.store(false, std::memory_order_release);
+            m_state.m_profiling.store(false, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+bool ProfileStreamWriter::Flush()
+{
+    // the list is copied so threads starting up don't wait on the file
+    {
+        std::lock_guard<std::mutex> lock(m_state.m_lock);
+        m_threadBuffers = m_state.m_threadBuffers;
+    }
+
+    m_buffer.clear();
+
+    for (const auto& threadBuffer : m_threadBuffers)
+    {
+        uint64_t droppedEvents = 0;
+        m_records.clear();
+        threadBuffer->DrainStream(m_generation, m_records, droppedEvents, m_threadName);
+
+        if (m_records.empty() && droppedEvents == 0)
+        {
+            continue;
+        }
+
+        uint16_t threadIndex = FindThreadIndex(*threadBuffer, m_threadName);
+
+        if (droppedEvents > 0)
+        {
+            AppendValue(ProfileStreamRecordType::Dropped);
+            AppendValue(threadIndex);
+            AppendValue(droppedEvents);
+        }
+
+        // names are defined ahead of the events that use them
+        for (const auto& record : m_records)
+        {
+            if (record.m_type == ProfileStreamEventType::Begin)
+            {
+                FindNameId(record.m_name);
+            }
+        }
+
+        AppendValue(ProfileStreamRecordType::Events);
+        AppendValue(static_cast<uint32_t>(m_records.size()));
+
+        for (const auto& record : m_records)
+        {
+            ProfileStreamEvent event;
+            event.m_timestamp = record.m_timestamp;
+            event.m_nameId = record.m_type == ProfileStreamEventType::Begin ? m_nameIds[record.m_name] : 0;
+            event.m_threadIndex = threadIndex;
+            event.m_type = record.m_type;
+            event.m_depth = record.m_depth;
+
+            AppendValue(event);
+        }
+    }
+
+    m_threadBuffers.clear();
+
+    return m_buffer.empty() || m_file.Write(m_buffer.data(), m_buffer.size());
+}
+
+uint16_t ProfileStreamWriter::FindThreadIndex(const ProfileThreadBuffer& buffer, const IP::String& threadName)
+{
+    auto found = m_threads.find(&buffer);
+    if (found == m_threads.end())
+    {
+        found = m_threads.emplace(&buffer, StreamThread{ static_cast<uint16_t>(m_threads.size()), IP::String() }).first;
+    }
+    else if (found->second.m_name == threadName)
+    {
+        return found->second.m_index;
+    }
+
+    found->second.m_name = threadName;
+
+    AppendValue(ProfileStreamRecordType::Thread);
+    AppendValue(found->second.m_index);
+    AppendValue(buffer.GetThreadId());
+    AppendString(threadName);
+
+    return found->second.m_index;
+}
+
+uint32_t ProfileStreamWriter::FindNameId(const char* name)
+{
+    auto found = m_nameIds.find(name);
+    if (found != m_nameIds.end())
+    {
+        return found->second;
+    }
+
+    uint32_t nameId = static_cast<uint32_t>(m_nameIds.size()) + 1;
+    m_nameIds.emplace(name, nameId);
+
+    AppendValue(ProfileStreamRecordType::Name);
+    AppendValue(nameId);
+    AppendString(IP::String(name));
+
+    return nameId;
+}
+
+void ProfileStreamWriter::AppendString(const IP::String& value)
+{
+    AppendValue(static_cast<uint32_t>(value.size()));
+    m_buffer.append(value);
+}
+
+static ProfilerState& GetProfilerState()
+{
+    static ProfilerState state;
+
+    return state;
+}
+
+// registers the thread's buffer on first use; the registry keeps it, and its events, after the thread exits
+class ProfileThreadHandle
+{
+    public:
+
+        ProfileThreadHandle() :
+            m_buffer(IP::MakeShared<ProfileThreadBuffer>(MEMORY_TAG))
+        {
+            ProfilerState& state = GetProfilerState();
+
+            std::lock_guard<std::mutex> lock(state.m_lock);
+            state.m_threadBuffers.push_back(m_buffer);
+        }
+
+        ~ProfileThreadHandle()
+        {
+            m_buffer->MarkThreadExited();
+        }
+
+        ProfileThreadBuffer& GetBuffer() { return *m_buffer; }
+
+    private:
+
+        std::shared_ptr<ProfileThreadBuffer> m_buffer;
+};
+
+static ProfileThreadBuffer& GetThreadBuffer()
+{
+    static thread_local ProfileThreadHandle handle;
+
+    return handle.GetBuffer();
+}
+
+// discards the previous capture and returns the new one's generation
+static uint32_t BeginProfileSession(ProfilerState& state)
+{
+    std::lock_guard<std::mutex> lock(state.m_lock);
+
+    // buffers of threads that have exited only held events from the capture being discarded
+    auto& buffers = state.m_threadBuffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<ProfileThreadBuffer>& buffer) { return buffer->HasThreadExited(); }), buffers.end());
+
+    state.m_frameTimestamps.clear();
+
+    return state.m_generation.fetch_add(1, std::memory_order_release) + 1;
+}
+
+// called with the control lock held; false if a stream ended early on a write error
+static bool EndProfileSession(ProfilerState& state)
+{
+    state.m_profiling.store(false, std::memory_order_release);
+    state.m_streaming.store(false, std::memory_order_release);
+
+    bool written = true;
+    if (state.m_streamWriter)
+    {
+        written = state.m_streamWriter->Stop();
+        state.m_streamWriter.reset();
+    }
+
+    return written;
+}
+
+double GetProfileNanoseconds(const ProfileCapture& capture, uint64_t startTimestamp, uint64_t endTimestamp)
+{
+    return IP::Time::ConvertTimestampsToNanoseconds(startTimestamp, endTimestamp, capture.m_nanosecondsPerTick);
+}
+
+void StartProfiling()
+{
+    ProfilerState& state = GetProfilerState();
+
+    std::lock_guard<std::mutex> control(state.m_controlLock);
+    EndProfileSession(state);
+
+    BeginProfileSession(state);
+    state.m_profiling.store(true, std::memory_order_release);
+}
+
+bool StartProfileStream(const std::experimental::filesystem::path& path, const ProfileStreamPolicy& policy)
+{
+    ProfilerState& state = GetProfilerState();
+
+    std::lock_guard<std::mutex> control(state.m_controlLock);
+    EndProfileSession(state);
+
+    uint32_t generation = BeginProfileSession(state);
+
+    IP::UniquePtr<ProfileStreamWriter> writer = IP::MakeUnique<ProfileStreamWriter>(MEMORY_TAG, state, generation, policy.m_flushInterval);
+    if (!writer->Open(path))
+    {
+        return false;
+    }
+
+    writer->Start();
+    state.m_streamWriter = std::move(writer);
+
+    state.m_streamRingCapacity.store(RoundUpToPowerOfTwo(std::max<size_t>(policy.m_threadBufferCapacity, 2)), std::memory_order_relaxed);
+    state.m_streaming.store(true, std::memory_order_release);
+    state.m_profiling.store(true, std::memory_order_release);
+
+    return true;
+}
+
+bool StopProfiling()
+{
+    ProfilerState& state = GetProfilerState();
+
+    std::lock_guard<std::mutex> control(state.m_controlLock);
+    return EndProfileSession(state);
+}
+
+bool IsProfiling()
+{
+    return GetProfilerState().m_profiling.load(std::memory_order_relaxed);
+}
+
+void MarkProfileFrame()
+{
+    ProfilerState& state = GetProfilerState();
+    if (!state.m_profiling.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    if (state.m_streaming.load(std::memory_order_acquire))
+    {
+        GetThreadBuffer().StreamFrame(state.m_generation.load(std::memory_order_acquire), state.m_streamRingCapacity.load(std::memory_order_relaxed));
+        return;
+    }
+
+    uint64_t timestamp = IP::Time::ReadTimestamp();
+
+    std::lock_guard<std::mutex> lock(state.m_lock);
+    state.m_frameTimestamps.push_back(timestamp);
+}
+
+void SetProfileThreadName(const char* name)
+{
+    GetThreadBuffer().SetThreadName(name);
+}
+
+ProfileCapture CaptureProfile()
+{
+    ProfilerState& state = GetProfilerState();
+    ProfileCapture capture;
+    capture.m_nanosecondsPerTick = IP::Time::GetTimestampCalibration().m_nanosecondsPerTick;
+
+    std::lock_guard<std::mutex> lock(state.m_lock);
+
+    uint32_t generation = state.m_generation.load(std::memory_order_acquire);
+    for (const auto& buffer : state.m_threadBuffers)
+    {
+        buffer->Capture(generation, capture);
+    }
+
+    capture.m_frameTimestamps = state.m_frameTimestamps;
+
+    return capture;
+}
+
+ProfileEventRecord* ProfileScope::BeginProfileEvent(const char* name, uint32_t& generation, bool& streamed)
+{
+    ProfilerState& state = GetProfilerState();
+
+    generation = 0;
+    streamed = false;
+    if (!state.m_profiling.load(std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+
+    generation = state.m_generation.load(std::memory_order_acquire);
+
+    if (state.m_streaming.load(std::memory_order_acquire))
+    {
+        streamed = GetThreadBuffer().StreamBegin(name, generation, state.m_streamRingCapacity.load(std::memory_order_relaxed));
+        return nullptr;
+    }
+
+    return GetThreadBuffer().Begin(name, generation);
+}
+
+void ProfileScope::EndProfileEvent(ProfileEventRecord* record, uint32_t generation)
+{
+    GetThreadBuffer().End(record, generation);
+}
+
+void ProfileScope::EndStreamedProfileEvent(uint32_t generation)
+{
+    GetThreadBuffer().StreamEnd(generation);
+}
+
+} // namespace Profiling
+} // namespace IP
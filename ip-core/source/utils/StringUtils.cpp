@@ -21,6 +21,8 @@
 
 #include <ip/core/memory/stl/StringStream.h>
 
+#include <charconv>
+
 namespace IP
 {
 namespace StringUtils
@@ -42,6 +44,20 @@ IP::String ToString(const IP::Vector<IP::String>& items, const char *separator)
     return ss.str();
 }
 
+void AppendZeroPaddedInteger(IP::String& buffer, uint64_t value, uint32_t width)
+{
+    char digits[20];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    size_t digitCount = static_cast<size_t>(result.ptr - digits);
+
+    if (digitCount < width)
+    {
+        buffer.append(width - digitCount, '0');
+    }
+
+    buffer.append(digits, digitCount);
+}
+
 } // namespace String
 } // namespace IP
 
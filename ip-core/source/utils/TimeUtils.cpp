@@ -3,7 +3,12 @@
 #include <ctime>
 #include <iomanip>
 
+#if defined(IP_HAS_TIMESTAMP_COUNTER) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
 #include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/utils/StringUtils.h>
 
 namespace IP
 {
@@ -15,6 +20,18 @@ SystemTimePoint GetCurrentSystemTime(void)
     return std::chrono::system_clock::now();
 }
 
+static const MonotonicTimePoint s_processStartTime = MonotonicClock::now();
+
+MonotonicTimePoint GetCurrentMonotonicTime(void)
+{
+    return MonotonicClock::now();
+}
+
+MonotonicDuration GetElapsedMonotonicTime(void)
+{
+    return MonotonicClock::now() - s_processStartTime;
+}
+
 #ifdef _WINDOWS
 bool GetFileLastModifiedTime(const IP::String &fileName, SystemTimePoint& lastModifiedTime)
 {
@@ -90,6 +107,80 @@ IP::String FormatTimeOfDay(SystemTimePoint timePoint)
     return ss.str();
 }
 
+static void WriteTwoDigits(char* destination, int value)
+{
+    destination[0] = static_cast<char>('0' + (value / 10) % 10);
+    destination[1] = static_cast<char>('0' + value % 10);
+}
+
+CachedTimeOfDayFormatter::CachedTimeOfDayFormatter() :
+    m_cachedSecond(0),
+    m_cacheValid(false),
+    m_cachedPrefix(),
+    m_cachedDate()
+{
+}
+
+void CachedTimeOfDayFormatter::UpdateCache(SystemTimePoint timePoint)
+{
+    auto cTime = std::chrono::system_clock::to_time_t(timePoint);
+    if (m_cacheValid && cTime == m_cachedSecond)
+    {
+        return;
+    }
+
+    auto tmTime = localtime(cTime);
+
+    WriteTwoDigits(m_cachedPrefix, tmTime.tm_hour);
+    m_cachedPrefix[2] = ':';
+    WriteTwoDigits(m_cachedPrefix + 3, tmTime.tm_min);
+    m_cachedPrefix[5] = ':';
+    WriteTwoDigits(m_cachedPrefix + 6, tmTime.tm_sec);
+    m_cachedPrefix[8] = '.';
+
+    int year = tmTime.tm_year + 1900;
+    WriteTwoDigits(m_cachedDate, year / 100);
+    WriteTwoDigits(m_cachedDate + 2, year % 100);
+    m_cachedDate[4] = '-';
+    WriteTwoDigits(m_cachedDate + 5, tmTime.tm_mon + 1);
+    m_cachedDate[7] = '-';
+    WriteTwoDigits(m_cachedDate + 8, tmTime.tm_mday);
+
+    m_cachedSecond = cTime;
+    m_cacheValid = true;
+}
+
+void CachedTimeOfDayFormatter::AppendTimeOfDay(IP::String& buffer, SystemTimePoint timePoint)
+{
+    UpdateCache(timePoint);
+
+    buffer.append(m_cachedPrefix, PREFIX_LENGTH);
+    AppendMilliseconds(buffer, timePoint);
+}
+
+void CachedTimeOfDayFormatter::AppendClockTime(IP::String& buffer, SystemTimePoint timePoint)
+{
+    UpdateCache(timePoint);
+
+    buffer.append(m_cachedPrefix, PREFIX_LENGTH - 1);
+}
+
+void CachedTimeOfDayFormatter::AppendDate(IP::String& buffer, SystemTimePoint timePoint)
+{
+    UpdateCache(timePoint);
+
+    buffer.append(m_cachedDate, DATE_LENGTH);
+}
+
+void CachedTimeOfDayFormatter::AppendMilliseconds(IP::String& buffer, SystemTimePoint timePoint)
+{
+    // Same millisecond derivation as FormatTimeOfDay so the output stays byte-identical
+    auto millisecondsElapsed = std::chrono::time_point_cast< std::chrono::milliseconds >(timePoint);
+    auto millisecondsRemainder = millisecondsElapsed.time_since_epoch().count() % 1000;
+
+    IP::StringUtils::AppendZeroPaddedInteger(buffer, static_cast<uint64_t>(millisecondsRemainder), 3);
+}
+
 IP::String ConvertSystemTimeToFileSuffix(SystemTimePoint timePoint)
 {
     auto cTime = std::chrono::system_clock::to_time_t(timePoint);
@@ -104,17 +195,106 @@ IP::String ConvertSystemTimeToFileSuffix(SystemTimePoint timePoint)
 
 SystemDuration GetElapsedSystemTime(void)
 {
-    auto now = std::chrono::system_clock::now();
+    return std::chrono::system_clock::now().time_since_epoch();
+}
+
+// long enough to pin the counter's rate down to a few parts per million, short enough not to be noticed at startup
+static const std::chrono::milliseconds TIMESTAMP_CALIBRATION_PERIOD(10);
+
+#if defined(IP_HAS_TIMESTAMP_COUNTER)
+
+// without an invariant counter (CPUID leaf 0x80000007, EDX bit 8) the rate changes with power states, and counters
+// on different cores needn't agree
+static bool HasInvariantTimestampCounter()
+{
+    unsigned int registers[4] = {};
+
+#if defined(_MSC_VER)
+    int msvcRegisters[4];
+    __cpuid(msvcRegisters, 0x80000000);
+    if (static_cast<unsigned int>(msvcRegisters[0]) < 0x80000007)
+    {
+        return false;
+    }
+
+    __cpuid(msvcRegisters, 0x80000007);
+    registers[3] = static_cast<unsigned int>(msvcRegisters[3]);
+#else
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+    {
+        return false;
+    }
+
+    __get_cpuid(0x80000007, &registers[0], &registers[1], &registers[2], &registers[3]);
+#endif
+
+    return (registers[3] & (1u << 8)) != 0;
+}
+
+#endif
+
+static TimestampCalibration CalibrateTimestamps()
+{
+    TimestampCalibration calibration;
+    calibration.m_usesCounter = false;
+    calibration.m_nanosecondsPerTick = 1.0;
+    calibration.m_baseTime = MonotonicClock::now();
+    calibration.m_baseTimestamp = static_cast<uint64_t>(ConvertDurationToNanoseconds(calibration.m_baseTime.time_since_epoch()));
 
-    return now - SystemTimePoint::min();
+#if defined(IP_HAS_TIMESTAMP_COUNTER)
+    if (!HasInvariantTimestampCounter())
+    {
+        return calibration;
+    }
+
+    MonotonicTimePoint startTime = MonotonicClock::now();
+    uint64_t startTicks = __rdtsc();
+
+    MonotonicTimePoint endTime;
+    do
+    {
+        endTime = MonotonicClock::now();
+    }
+    while (endTime - startTime < TIMESTAMP_CALIBRATION_PERIOD);
+
+    uint64_t endTicks = __rdtsc();
+    if (endTicks <= startTicks)
+    {
+        return calibration;
+    }
+
+    calibration.m_usesCounter = true;
+    calibration.m_nanosecondsPerTick = static_cast<double>(ConvertDurationToNanoseconds(endTime - startTime)) / static_cast<double>(endTicks - startTicks);
+    calibration.m_baseTime = endTime;
+    calibration.m_baseTimestamp = endTicks;
+#endif
+
+    return calibration;
+}
+
+const TimestampCalibration& GetTimestampCalibration(void)
+{
+    static const TimestampCalibration calibration = CalibrateTimestamps();
+
+    return calibration;
+}
+
+MonotonicDuration ConvertTimestampsToDuration(uint64_t startTimestamp, uint64_t endTimestamp)
+{
+    return ConvertNanosecondsToDuration(ConvertTimestampsToNanoseconds(startTimestamp, endTimestamp, GetTimestampCalibration().m_nanosecondsPerTick));
+}
+
+double ConvertTimestampsToNanoseconds(uint64_t startTimestamp, uint64_t endTimestamp, double nanosecondsPerTick)
+{
+    // the difference is taken as integers so large counter values don't lose precision
+    return static_cast<double>(static_cast<int64_t>(endTimestamp - startTimestamp)) * nanosecondsPerTick;
 }
 
-double ConvertDurationToSeconds(SystemDuration duration)
+MonotonicTimePoint ConvertTimestampToMonotonicTime(uint64_t timestamp)
 {
-    // Question: what is the best way of doing this precision-wise?
-    double rawCount = static_cast< double >(duration.count());
+    const TimestampCalibration& calibration = GetTimestampCalibration();
 
-    return rawCount / static_cast< double >(SystemDuration::period::den) * static_cast< double >(SystemDuration::period::num);
+    return calibration.m_baseTime + ConvertTimestampsToDuration(calibration.m_baseTimestamp, timestamp);
 }
 
 } // namespace Time
@@ -0,0 +1,57 @@
+#include <ip/core/utils/DatagramSocket.h>
+
+namespace IP
+{
+namespace System
+{
+
+// Windows only offers stream sockets in the Unix domain, so there is nothing to connect or bind to and every send
+// reports the receiver as gone.
+
+static const intptr_t INVALID_HANDLE = -1;
+
+DatagramSocket::DatagramSocket() :
+    m_handle(INVALID_HANDLE),
+    m_boundPath()
+{
+}
+
+DatagramSocket::~DatagramSocket()
+{
+}
+
+bool DatagramSocket::Connect(const char*)
+{
+    return false;
+}
+
+bool DatagramSocket::Bind(const char*)
+{
+    return false;
+}
+
+void DatagramSocket::Close()
+{
+}
+
+DatagramSendStatus DatagramSocket::Send(const DatagramBuffer*, size_t, size_t& sentCount)
+{
+    sentCount = 0;
+
+    return DatagramSendStatus::Disconnected;
+}
+
+bool DatagramSocket::WaitUntilWritable(std::chrono::milliseconds)
+{
+    return false;
+}
+
+bool DatagramSocket::Receive(IP::String& datagram, std::chrono::milliseconds)
+{
+    datagram.clear();
+
+    return false;
+}
+
+} // namespace System
+} // namespace IP
@@ -0,0 +1,148 @@
+#include <ip/core/utils/MappedFile.h>
+
+#include <Windows.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+static const intptr_t INVALID_HANDLE = reinterpret_cast<intptr_t>(INVALID_HANDLE_VALUE);
+
+MappedFile::MappedFile() :
+    m_handle(INVALID_HANDLE),
+    m_mode(MappedFileMode::ReadOnly),
+    m_size(0),
+    m_view(nullptr),
+    m_viewLength(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::experimental::filesystem::path& path, MappedFileMode mode)
+{
+    Close();
+
+    DWORD access = (mode == MappedFileMode::ReadWrite) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+    DWORD disposition = (mode == MappedFileMode::ReadWrite) ? CREATE_ALWAYS : OPEN_EXISTING;
+    HANDLE handle = ::CreateFileW(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(handle, &fileSize))
+    {
+        ::CloseHandle(handle);
+        return false;
+    }
+
+    m_handle = reinterpret_cast<intptr_t>(handle);
+    m_mode = mode;
+    m_size = static_cast<uint64_t>(fileSize.QuadPart);
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    Unmap();
+
+    if (m_handle != INVALID_HANDLE)
+    {
+        ::CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+        m_handle = INVALID_HANDLE;
+    }
+
+    m_size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_handle != INVALID_HANDLE;
+}
+
+uint64_t MappedFile::GetSize() const
+{
+    return m_size;
+}
+
+bool MappedFile::Resize(uint64_t size)
+{
+    if (m_handle == INVALID_HANDLE || m_mode != MappedFileMode::ReadWrite)
+    {
+        return false;
+    }
+
+    // a file can't be resized while a view of it is open
+    Unmap();
+
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    HANDLE handle = reinterpret_cast<HANDLE>(m_handle);
+    if (!::SetFilePointerEx(handle, position, nullptr, FILE_BEGIN) || !::SetEndOfFile(handle))
+    {
+        return false;
+    }
+
+    m_size = size;
+    return true;
+}
+
+char* MappedFile::Map(uint64_t offset, size_t length)
+{
+    Unmap();
+
+    if (m_handle == INVALID_HANDLE || length == 0 || offset % GetMappingGranularity() != 0 || offset + length > m_size)
+    {
+        return nullptr;
+    }
+
+    bool writable = (m_mode == MappedFileMode::ReadWrite);
+    HANDLE mapping = ::CreateFileMappingW(reinterpret_cast<HANDLE>(m_handle), nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        return nullptr;
+    }
+
+    void* view = ::MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFFFFFF), length);
+
+    // the view keeps the mapping object alive
+    ::CloseHandle(mapping);
+
+    if (view == nullptr)
+    {
+        return nullptr;
+    }
+
+    m_view = view;
+    m_viewLength = length;
+
+    return static_cast<char*>(m_view);
+}
+
+void MappedFile::Unmap()
+{
+    if (m_view != nullptr)
+    {
+        ::UnmapViewOfFile(m_view);
+        m_view = nullptr;
+        m_viewLength = 0;
+    }
+}
+
+size_t MappedFile::GetMappingGranularity()
+{
+    SYSTEM_INFO systemInfo;
+    ::GetSystemInfo(&systemInfo);
+
+    return systemInfo.dwAllocationGranularity;
+}
+
+} // namespace FileUtils
+} // namespace IP
@@ -0,0 +1,108 @@
+#include <ip/core/utils/OutputFile.h>
+
+#include <Windows.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+static const intptr_t INVALID_HANDLE = reinterpret_cast<intptr_t>(INVALID_HANDLE_VALUE);
+
+OutputFile::OutputFile() :
+    m_handle(INVALID_HANDLE)
+{
+}
+
+OutputFile::~OutputFile()
+{
+    Close();
+}
+
+bool OutputFile::Open(const std::experimental::filesystem::path& path)
+{
+    Close();
+
+    HANDLE handle = ::CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    m_handle = reinterpret_cast<intptr_t>(handle);
+    return true;
+}
+
+bool OutputFile::OpenForAppend(const char* path)
+{
+    Close();
+
+    HANDLE handle = ::CreateFileA(path, FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    m_handle = reinterpret_cast<intptr_t>(handle);
+    return true;
+}
+
+void OutputFile::Close()
+{
+    if (m_handle != INVALID_HANDLE)
+    {
+        ::CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+        m_handle = INVALID_HANDLE;
+    }
+}
+
+bool OutputFile::IsOpen() const
+{
+    return m_handle != INVALID_HANDLE;
+}
+
+bool OutputFile::Write(const void* data, size_t length, size_t* writtenLength)
+{
+    if (writtenLength != nullptr)
+    {
+        *writtenLength = 0;
+    }
+
+    if (m_handle == INVALID_HANDLE)
+    {
+        return false;
+    }
+
+    const char* remaining = static_cast<const char*>(data);
+    while (length > 0)
+    {
+        DWORD chunkSize = length > MAXDWORD ? MAXDWORD : static_cast<DWORD>(length);
+        DWORD written = 0;
+        if (!::WriteFile(reinterpret_cast<HANDLE>(m_handle), remaining, chunkSize, &written, nullptr))
+        {
+            return false;
+        }
+
+        remaining += written;
+        length -= written;
+        if (writtenLength != nullptr)
+        {
+            *writtenLength += written;
+        }
+    }
+
+    return true;
+}
+
+bool OutputFile::SyncData()
+{
+    if (m_handle == INVALID_HANDLE)
+    {
+        return false;
+    }
+
+    return ::FlushFileBuffers(reinterpret_cast<HANDLE>(m_handle)) != 0;
+}
+
+} // namespace FileUtils
+} // namespace IP
@@ -0,0 +1,122 @@
+#include <ip/core/utils/SharedMemory.h>
+
+#include <string.h>
+
+#include <Windows.h>
+
+namespace IP
+{
+namespace System
+{
+
+// Named file mappings backed by the page file; the name disappears with the last handle, so there is never a stale
+// segment to replace and nothing to remove explicitly.
+
+SharedMemory::SharedMemory() :
+    m_handle(0),
+    m_name(),
+    m_isOwner(false),
+    m_data(nullptr),
+    m_size(0)
+{
+}
+
+SharedMemory::~SharedMemory()
+{
+    Close();
+}
+
+bool SharedMemory::Create(const char* name, size_t size)
+{
+    Close();
+
+    m_name = name;
+
+    uint64_t size64 = static_cast<uint64_t>(size);
+    HANDLE handle = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), name);
+    if (handle == nullptr)
+    {
+        return false;
+    }
+
+    // mappings disappear with their last handle, so one that already exists under this name is still in use
+    if (::GetLastError() == ERROR_ALREADY_EXISTS)
+    {
+        ::CloseHandle(handle);
+        return false;
+    }
+
+    m_handle = reinterpret_cast<intptr_t>(handle);
+    m_isOwner = true;
+
+    void* data = ::MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    // pagefile-backed mappings start zero-filled, but say so explicitly for the callers relying on it
+    memset(data, 0, size);
+
+    m_data = data;
+    m_size = size;
+
+    return true;
+}
+
+bool SharedMemory::Open(const char* name)
+{
+    Close();
+
+    m_name = name;
+
+    HANDLE handle = ::OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+    if (handle == nullptr)
+    {
+        return false;
+    }
+
+    m_handle = reinterpret_cast<intptr_t>(handle);
+
+    void* data = ::MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    MEMORY_BASIC_INFORMATION region;
+    if (::VirtualQuery(data, &region, sizeof(region)) == 0)
+    {
+        ::UnmapViewOfFile(data);
+        Close();
+        return false;
+    }
+
+    m_data = data;
+    m_size = region.RegionSize;
+
+    return true;
+}
+
+void SharedMemory::Close()
+{
+    if (m_data != nullptr)
+    {
+        ::UnmapViewOfFile(m_data);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    if (m_handle != 0)
+    {
+        ::CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+        m_handle = 0;
+    }
+
+    m_isOwner = false;
+}
+
+} // namespace System
+} // namespace IP
@@ -0,0 +1,89 @@
+#include <ip/core/utils/StandardOutput.h>
+
+#include <string.h>
+
+#include <Windows.h>
+
+namespace IP
+{
+namespace FileUtils
+{
+
+// there's no gather write for console handles, so small buffers are coalesced into one WriteFile call
+static const size_t STAGING_BUFFER_SIZE = 16 * 1024;
+
+static bool WriteHandle(HANDLE handle, const char* data, size_t length)
+{
+    while (length > 0)
+    {
+        DWORD chunkSize = length > MAXDWORD ? MAXDWORD : static_cast<DWORD>(length);
+        DWORD written = 0;
+        if (!::WriteFile(handle, data, chunkSize, &written, nullptr))
+        {
+            return false;
+        }
+
+        data += written;
+        length -= written;
+    }
+
+    return true;
+}
+
+bool IsStandardOutputTerminal()
+{
+    HANDLE handle = ::GetStdHandle(STD_OUTPUT_HANDLE);
+    if (handle == INVALID_HANDLE_VALUE || handle == nullptr || ::GetFileType(handle) != FILE_TYPE_CHAR)
+    {
+        return false;
+    }
+
+    DWORD mode = 0;
+    return ::GetConsoleMode(handle, &mode) != 0;
+}
+
+bool WriteStandardOutput(const OutputBuffer* buffers, size_t count)
+{
+    HANDLE handle = ::GetStdHandle(STD_OUTPUT_HANDLE);
+    if (handle == INVALID_HANDLE_VALUE || handle == nullptr)
+    {
+        return false;
+    }
+
+    char staging[STAGING_BUFFER_SIZE];
+    size_t stagedLength = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char* data = static_cast<const char*>(buffers[i].m_data);
+        size_t length = buffers[i].m_length;
+
+        if (stagedLength + length > STAGING_BUFFER_SIZE)
+        {
+            if (!WriteHandle(handle, staging, stagedLength))
+            {
+                return false;
+            }
+
+            stagedLength = 0;
+        }
+
+        if (length > STAGING_BUFFER_SIZE)
+        {
+            if (!WriteHandle(handle, data, length))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        memcpy(staging + stagedLength, data, length);
+        stagedLength += length;
+    }
+
+    return WriteHandle(handle, staging, stagedLength);
+}
+
+} // namespace FileUtils
+} // namespace IP
@@ -1,6 +1,7 @@
 #include <ip/core/utils/SystemUtils.h>
 
 #include <ip/core/memory/stl/StringStream.h>
+#include <ip/core/UnreferencedParam.h>
 
 #include <Windows.h>
 
@@ -20,6 +21,53 @@ IP::String GetProcessId()
     return ss.str();
 }
 
+bool IsProcessRunning(uint32_t processId)
+{
+    HANDLE process = ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(processId));
+    if (process == nullptr)
+    {
+        // access denied means the process exists
+        return ::GetLastError() == ERROR_ACCESS_DENIED;
+    }
+
+    DWORD exitCode = 0;
+    bool running = ::GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+    ::CloseHandle(process);
+
+    return running;
+}
+
+uint32_t GetCurrentThreadId()
+{
+    return static_cast<uint32_t>(::GetCurrentThreadId());
+}
+
+void LowerCurrentThreadPriority()
+{
+    // background mode lowers both CPU and I/O priority
+    ::SetThreadPriority(::GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+}
+
+static FatalErrorHandler s_fatalErrorHandler = nullptr;
+
+static LONG WINAPI UnhandledExceptionHandler(EXCEPTION_POINTERS* exceptionPointers)
+{
+    IP_UNREFERENCED_PARAM(exceptionPointers);
+
+    if (s_fatalErrorHandler != nullptr)
+    {
+        s_fatalErrorHandler("unhandled exception");
+    }
+
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void InstallFatalErrorHandler(FatalErrorHandler handler)
+{
+    s_fatalErrorHandler = handler;
+
+    ::SetUnhandledExceptionFilter(UnhandledExceptionHandler);
+}
 
 }
 }
\ No newline at end of file
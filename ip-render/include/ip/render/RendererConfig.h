@@ -26,6 +26,11 @@ struct RendererConfig
     uint8_t m_blueBits;
 
     bool m_windowed;
+
+    // when set, the renderer streams a profile of itself from Initialize to Shutdown to this ProfileStreamFormat file,
+    // which profile-convert turns into a Chrome trace and a per-frame breakdown; Gold builds have no profiling markers,
+    // so their stream is empty
+    IP::String m_profileTracePath;
 };
 
 } // namespace Render
@@ -18,16 +18,18 @@ class FrameRateLimiter
 
         void ResetTargetFrameRate(uint32_t targetFrameRate);
 
-        IP::Time::SystemDuration Service();
+        IP::Time::MonotonicDuration Service();
+
+        IP::Time::MonotonicDuration GetTargetFrameLength() const { return ComputeFrameLength(); }
 
     private:
 
-        IP::Time::SystemDuration ComputeFrameLength() const;
+        IP::Time::MonotonicDuration ComputeFrameLength() const;
 
         uint32_t m_targetFrameRate;
 
-        IP::Time::SystemTimePoint m_startTime;
-        IP::Time::SystemTimePoint m_lastFrameCheckpoint;
+        IP::Time::MonotonicTimePoint m_startTime;
+        IP::Time::MonotonicTimePoint m_lastFrameCheckpoint;
 };
 
 } // namespace Render
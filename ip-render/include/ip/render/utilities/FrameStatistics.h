@@ -0,0 +1,136 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/metrics/Histogram.h>
+#include <ip/core/utils/TimeUtils.h>
+
+namespace IP
+{
+
+namespace Metrics
+{
+class Counter;
+}
+
+namespace Render
+{
+
+enum class FramePhase
+{
+    // waiting for the swap chain to hand over an image
+    Acquire,
+    Submit,
+    Present,
+
+    // the rest of the frame: waits for idle, swap chain rebuilds, bookkeeping
+    Other,
+
+    Count
+};
+
+static const size_t FRAME_PHASE_COUNT = static_cast<size_t>(FramePhase::Count);
+
+const char* GetFramePhaseName(FramePhase phase);
+
+struct FrameDurationStatistics
+{
+    IP::Time::MonotonicDuration m_p50;
+    IP::Time::MonotonicDuration m_p95;
+    IP::Time::MonotonicDuration m_p99;
+    IP::Time::MonotonicDuration m_max;
+};
+
+// The frames since the last report
+struct FrameStatisticsReport
+{
+    size_t m_frameCount;
+
+    // CPU time from the start of the frame to the end of present
+    FrameDurationStatistics m_frameTime;
+    FrameDurationStatistics m_phaseTimes[FRAME_PHASE_COUNT];
+
+    // hitches by the phase that took longest in the hitching frame
+    size_t m_hitchCount;
+    size_t m_hitchesByPhase[FRAME_PHASE_COUNT];
+};
+
+// Times each frame and its phases on the render thread.  Frames taking longer than a multiple of the target frame
+// length are logged as hitches, naming the phase that took longest, and every report interval the frame and phase time
+// percentiles of the frames since the previous report are logged and the window starts over.  Totals since startup also
+// go to the metrics registry, for the monitoring scraper.
+class FrameStatistics
+{
+    public:
+
+        FrameStatistics();
+        FrameStatistics(double hitchMultiple, std::chrono::milliseconds reportInterval);
+
+        FrameStatistics(const FrameStatistics& rhs) = delete;
+        FrameStatistics& operator =(const FrameStatistics& rhs) = delete;
+
+        void BeginFrame();
+
+        void RecordPhase(FramePhase phase, uint64_t startTimestamp, uint64_t endTimestamp);
+
+        // returns true if the frame hitched
+        bool EndFrame(IP::Time::MonotonicDuration targetFrameLength);
+
+        FrameStatisticsReport BuildReport() const;
+
+        // appends the report as a text table, times in milliseconds
+        static void FormatReport(IP::String& buffer, const FrameStatisticsReport& report);
+
+    private:
+
+        void ResetWindow();
+
+        double m_hitchMultiple;
+        std::chrono::milliseconds m_reportInterval;
+
+        uint64_t m_frameStartTimestamp;
+        uint64_t m_phaseNanoseconds[FRAME_PHASE_COUNT];
+
+        // the current report window, accumulated on the render thread
+        IP::Metrics::HistogramSnapshot m_frameWindow;
+        IP::Metrics::HistogramSnapshot m_phaseWindows[FRAME_PHASE_COUNT];
+        size_t m_hitchCount;
+        size_t m_hitchesByPhase[FRAME_PHASE_COUNT];
+        IP::Time::MonotonicTimePoint m_windowStartTime;
+
+        IP::Metrics::Histogram& m_frameMetric;
+        IP::Metrics::Histogram* m_phaseMetrics[FRAME_PHASE_COUNT];
+        IP::Metrics::Counter& m_hitchMetric;
+};
+
+// Records the time between construction and destruction as one phase of the current frame
+class FramePhaseTimer
+{
+    public:
+
+        FramePhaseTimer(FrameStatistics& statistics, FramePhase phase) :
+            m_statistics(statistics),
+            m_phase(phase),
+            m_startTimestamp(IP::Time::ReadTimestamp())
+        {
+        }
+
+        ~FramePhaseTimer()
+        {
+            m_statistics.RecordPhase(m_phase, m_startTimestamp, IP::Time::ReadTimestamp());
+        }
+
+        FramePhaseTimer(const FramePhaseTimer& rhs) = delete;
+        FramePhaseTimer& operator =(const FramePhaseTimer& rhs) = delete;
+
+    private:
+
+        FrameStatistics& m_statistics;
+        FramePhase m_phase;
+        uint64_t m_startTimestamp;
+};
+
+} // namespace Render
+} // namespace IP
@@ -8,6 +8,7 @@
 #include <ip/render/IRenderer.h>
 #include <ip/render/RendererConfig.h>
 #include <ip/render/utilities/FrameRateLimiter.h>
+#include <ip/render/utilities/FrameStatistics.h>
 #include <ip/render/vulkan/VulkanDeviceProperties.h>
 
 namespace IP
@@ -18,6 +19,11 @@ namespace Logging
 enum class LogLevel;
 }
 
+namespace Metrics
+{
+class Counter;
+}
+
 class IPException;
 
 namespace Render
@@ -46,6 +52,9 @@ class VulkanRenderer : public IRenderer
         void InitializeRenderer();
         void CleanupRenderer();
 
+        // stops profiling, writes the trace and logs the per-frame report
+        void WriteProfile();
+
         void ResetSwapChainRelatedResources();
         void CleanupSwapChainRelatedResources();
 
@@ -136,6 +145,9 @@ class VulkanRenderer : public IRenderer
         bool m_windowResized;
 
         IP::Render::FrameRateLimiter m_frameRateController;
+        IP::Render::FrameStatistics m_frameStatistics;
+
+        IP::Metrics::Counter& m_swapChainResetMetric;
 };
 
 } // namespace Render
@@ -7,7 +7,7 @@ namespace Render
 
 FrameRateLimiter::FrameRateLimiter(uint32_t targetFrameRate) :
     m_targetFrameRate(targetFrameRate),
-    m_startTime(IP::Time::GetCurrentSystemTime()),
+    m_startTime(IP::Time::GetCurrentMonotonicTime()),
     m_lastFrameCheckpoint()
 {
     m_lastFrameCheckpoint = m_startTime - ComputeFrameLength();
@@ -20,14 +20,14 @@ FrameRateLimiter::~FrameRateLimiter()
 void FrameRateLimiter::ResetTargetFrameRate(uint32_t targetFrameRate)
 {
     m_targetFrameRate = targetFrameRate;
-    m_lastFrameCheckpoint = IP::Time::GetCurrentSystemTime();
+    m_lastFrameCheckpoint = IP::Time::GetCurrentMonotonicTime();
 }
 
-IP::Time::SystemDuration FrameRateLimiter::Service()
+IP::Time::MonotonicDuration FrameRateLimiter::Service()
 {
-    IP::Time::SystemDuration frameLength = ComputeFrameLength();
-    IP::Time::SystemTimePoint nextFrameTime = m_lastFrameCheckpoint + frameLength;
-    IP::Time::SystemTimePoint currentTime = IP::Time::GetCurrentSystemTime();
+    IP::Time::MonotonicDuration frameLength = ComputeFrameLength();
+    IP::Time::MonotonicTimePoint nextFrameTime = m_lastFrameCheckpoint + frameLength;
+    IP::Time::MonotonicTimePoint currentTime = IP::Time::GetCurrentMonotonicTime();
 
     if (nextFrameTime <= currentTime)
     {
@@ -42,15 +42,15 @@ IP::Time::SystemDuration FrameRateLimiter::Service()
             m_lastFrameCheckpoint += frameLength;
         }
 
-        return IP::Time::SystemDuration::zero();
+        return IP::Time::MonotonicDuration::zero();
     }
 
     return nextFrameTime - currentTime;
 }
 
-IP::Time::SystemDuration FrameRateLimiter::ComputeFrameLength() const
+IP::Time::MonotonicDuration FrameRateLimiter::ComputeFrameLength() const
 {
-    IP::Time::SystemDuration oneSecond(std::chrono::seconds(1));
+    IP::Time::MonotonicDuration oneSecond(std::chrono::seconds(1));
 
     return oneSecond / m_targetFrameRate;
 }
@@ -0,0 +1,217 @@
+#include <ip/render/utilities/FrameStatistics.h>
+
+#include <algorithm>
+#include <stdio.h>
+
+#include <ip/core/logging/LogSystem.h>
+#include <ip/core/logging/RateLimitedLogging.h>
+#include <ip/core/metrics/MetricsRegistry.h>
+
+namespace IP
+{
+namespace Render
+{
+
+static const double DEFAULT_HITCH_MULTIPLE = 2.0;
+static const std::chrono::milliseconds DEFAULT_REPORT_INTERVAL(10000);
+
+static const char* const PHASE_METRIC_NAMES[FRAME_PHASE_COUNT] = {
+    "ip_render_acquire_time_nanoseconds",
+    "ip_render_submit_time_nanoseconds",
+    "ip_render_present_time_nanoseconds",
+    "ip_render_frame_other_time_nanoseconds"
+};
+
+const char* GetFramePhaseName(FramePhase phase)
+{
+    switch (phase)
+    {
+        case FramePhase::Acquire: return "acquire";
+        case FramePhase::Submit: return "submit";
+        case FramePhase::Present: return "present";
+        case FramePhase::Other: return "other";
+        default: return "unknown";
+    }
+}
+
+static void ClearWindow(IP::Metrics::HistogramSnapshot& window)
+{
+    window.m_precisionBits = IP::Metrics::DEFAULT_HISTOGRAM_PRECISION_BITS;
+    window.m_bucketCounts.assign(IP::Metrics::GetHistogramBucketIndex(window.m_precisionBits, UINT64_MAX) + 1, 0);
+    window.m_count = 0;
+    window.m_sum = 0;
+    window.m_min = 0;
+    window.m_max = 0;
+}
+
+static void AddToWindow(IP::Metrics::HistogramSnapshot& window, uint64_t value)
+{
+    ++window.m_bucketCounts[IP::Metrics::GetHistogramBucketIndex(window.m_precisionBits, value)];
+    window.m_min = window.m_count == 0 ? value : std::min(window.m_min, value);
+    window.m_max = std::max(window.m_max, value);
+    window.m_sum += value;
+    ++window.m_count;
+}
+
+static FrameDurationStatistics BuildDurationStatistics(const IP::Metrics::HistogramSnapshot& window)
+{
+    FrameDurationStatistics statistics;
+    statistics.m_p50 = IP::Time::ConvertNanosecondsToDuration(IP::Metrics::GetHistogramPercentile(window, 50.0));
+    statistics.m_p95 = IP::Time::ConvertNanosecondsToDuration(IP::Metrics::GetHistogramPercentile(window, 95.0));
+    statistics.m_p99 = IP::Time::ConvertNanosecondsToDuration(IP::Metrics::GetHistogramPercentile(window, 99.0));
+    statistics.m_max = IP::Time::ConvertNanosecondsToDuration(window.m_max);
+
+    return statistics;
+}
+
+static void FormatDurationStatistics(IP::String& buffer, const char* name, const FrameDurationStatistics& statistics, size_t hitches)
+{
+    char line[128];
+    snprintf(line, sizeof(line), "%-10s %9.3f %9.3f %9.3f %9.3f %8zu\n",
+        name,
+        IP::Time::ConvertDurationToMilliseconds(statistics.m_p50),
+        IP::Time::ConvertDurationToMilliseconds(statistics.m_p95),
+        IP::Time::ConvertDurationToMilliseconds(statistics.m_p99),
+        IP::Time::ConvertDurationToMilliseconds(statistics.m_max),
+        hitches);
+    buffer.append(line);
+}
+
+FrameStatistics::FrameStatistics() :
+    FrameStatistics(DEFAULT_HITCH_MULTIPLE, DEFAULT_REPORT_INTERVAL)
+{
+}
+
+FrameStatistics::FrameStatistics(double hitchMultiple, std::chrono::milliseconds reportInterval) :
+    m_hitchMultiple(hitchMultiple),
+    m_reportInterval(reportInterval),
+    m_frameStartTimestamp(0),
+    m_phaseNanoseconds(),
+    m_frameWindow(),
+    m_phaseWindows(),
+    m_hitchCount(0),
+    m_hitchesByPhase(),
+    m_windowStartTime(),
+    m_frameMetric(IP::Metrics::GetMetricsRegistry().GetHistogram("ip_render_frame_cpu_time_nanoseconds", "CPU time spent on each frame, from its start to the end of present")),
+    m_phaseMetrics(),
+    m_hitchMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_render_frame_hitches_total", "Frames that took longer than the hitch multiple of the target frame length"))
+{
+    for (size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        m_phaseMetrics[phase] = &IP::Metrics::GetMetricsRegistry().GetHistogram(PHASE_METRIC_NAMES[phase], "CPU time spent in one phase of each frame");
+    }
+
+    ResetWindow();
+}
+
+void FrameStatistics::BeginFrame()
+{
+    std::fill(std::begin(m_phaseNanoseconds), std::end(m_phaseNanoseconds), 0);
+    m_frameStartTimestamp = IP::Time::ReadTimestamp();
+}
+
+void FrameStatistics::RecordPhase(FramePhase phase, uint64_t startTimestamp, uint64_t endTimestamp)
+{
+    int64_t nanoseconds = IP::Time::ConvertDurationToNanoseconds(IP::Time::ConvertTimestampsToDuration(startTimestamp, endTimestamp));
+
+    m_phaseNanoseconds[static_cast<size_t>(phase)] += static_cast<uint64_t>(std::max<int64_t>(nanoseconds, 0));
+}
+
+bool FrameStatistics::EndFrame(IP::Time::MonotonicDuration targetFrameLength)
+{
+    int64_t elapsed = IP::Time::ConvertDurationToNanoseconds(IP::Time::ConvertTimestampsToDuration(m_frameStartTimestamp, IP::Time::ReadTimestamp()));
+    uint64_t frameNanoseconds = static_cast<uint64_t>(std::max<int64_t>(elapsed, 0));
+
+    // whatever the timed phases don't account for
+    uint64_t timedNanoseconds = 0;
+    for (size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        if (phase != static_cast<size_t>(FramePhase::Other))
+        {
+            timedNanoseconds += m_phaseNanoseconds[phase];
+        }
+    }
+    m_phaseNanoseconds[static_cast<size_t>(FramePhase::Other)] += frameNanoseconds - std::min(frameNanoseconds, timedNanoseconds);
+
+    AddToWindow(m_frameWindow, frameNanoseconds);
+    m_frameMetric.Record(frameNanoseconds);
+
+    for (size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        AddToWindow(m_phaseWindows[phase], m_phaseNanoseconds[phase]);
+        m_phaseMetrics[phase]->Record(m_phaseNanoseconds[phase]);
+    }
+
+    double hitchNanoseconds = m_hitchMultiple * static_cast<double>(IP::Time::ConvertDurationToNanoseconds(targetFrameLength));
+    bool hitch = targetFrameLength.count() > 0 && static_cast<double>(frameNanoseconds) > hitchNanoseconds;
+
+    if (hitch)
+    {
+        size_t cause = static_cast<size_t>(std::max_element(std::begin(m_phaseNanoseconds), std::end(m_phaseNanoseconds)) - std::begin(m_phaseNanoseconds));
+
+        ++m_hitchCount;
+        ++m_hitchesByPhase[cause];
+        m_hitchMetric.Increment();
+
+        LOG_WARN_EVERY_MS(1000, "Frame hitch: " << frameNanoseconds / 1000000.0 << " ms against a " << IP::Time::ConvertDurationToMilliseconds(targetFrameLength) << " ms target, "
+            << GetFramePhaseName(static_cast<FramePhase>(cause)) << " took " << m_phaseNanoseconds[cause] / 1000000.0 << " ms");
+    }
+
+    IP::Time::MonotonicTimePoint currentTime = IP::Time::GetCurrentMonotonicTime();
+    if (currentTime - m_windowStartTime >= m_reportInterval)
+    {
+        IP::String report;
+        FormatReport(report, BuildReport());
+        LOG_CH_INFO(IP::Logging::LogChannel::Render, "Frame statistics:\n" << report);
+
+        ResetWindow();
+    }
+
+    return hitch;
+}
+
+FrameStatisticsReport FrameStatistics::BuildReport() const
+{
+    FrameStatisticsReport report;
+    report.m_frameCount = static_cast<size_t>(m_frameWindow.m_count);
+    report.m_frameTime = BuildDurationStatistics(m_frameWindow);
+    report.m_hitchCount = m_hitchCount;
+
+    for (size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        report.m_phaseTimes[phase] = BuildDurationStatistics(m_phaseWindows[phase]);
+        report.m_hitchesByPhase[phase] = m_hitchesByPhase[phase];
+    }
+
+    return report;
+}
+
+void FrameStatistics::FormatReport(IP::String& buffer, const FrameStatisticsReport& report)
+{
+    char line[128];
+    snprintf(line, sizeof(line), "%zu frames, %zu hitches\n%-10s %9s %9s %9s %9s %8s\n", report.m_frameCount, report.m_hitchCount, "ms", "p50", "p95", "p99", "max", "hitches");
+    buffer.append(line);
+
+    FormatDurationStatistics(buffer, "frame", report.m_frameTime, report.m_hitchCount);
+
+    for (size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        FormatDurationStatistics(buffer, GetFramePhaseName(static_cast<FramePhase>(phase)), report.m_phaseTimes[phase], report.m_hitchesByPhase[phase]);
+    }
+}
+
+void FrameStatistics::ResetWindow()
+{
+    ClearWindow(m_frameWindow);
+    for (auto& window : m_phaseWindows)
+    {
+        ClearWindow(window);
+    }
+
+    m_hitchCount = 0;
+    std::fill(std::begin(m_hitchesByPhase), std::end(m_hitchesByPhase), 0);
+    m_windowStartTime = IP::Time::GetCurrentMonotonicTime();
+}
+
+} // namespace Render
+} // namespace IP
@@ -7,7 +7,10 @@
 
 #include <ip/core/debug/IPException.h>
 #include <ip/core/logging/LogSystem.h>
+#include <ip/core/logging/RateLimitedLogging.h>
 #include <ip/core/memory/stl/Set.h>
+#include <ip/core/metrics/MetricsRegistry.h>
+#include <ip/core/profiling/Profiler.h>
 #include <ip/core/UnreferencedParam.h>
 #include <ip/core/utils/FileUtils.h>
 #include <ip/core/utils/StringUtils.h>
@@ -36,7 +39,8 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugReportFlagsEXT flags,
     IP_UNREFERENCED_PARAM(layerPrefix);
     IP_UNREFERENCED_PARAM(userData);
 
-    LOG_DEBUG("Vulkan validation layer: " << msg);
+    // validation layers repeat the same complaint every frame
+    LOG_DEDUP(IP::Logging::LogLevel::Debug, "Vulkan validation layer: " << msg);
 
     return VK_FALSE;
 }
@@ -88,7 +92,9 @@ VulkanRenderer::VulkanRenderer() :
     m_swapExtents(),
     m_glfwTerminate(false),
     m_windowResized(false),
-    m_frameRateController(60)
+    m_frameRateController(60),
+    m_frameStatistics(),
+    m_swapChainResetMetric(IP::Metrics::GetMetricsRegistry().GetCounter("ip_render_swapchain_resets_total", "Swap chains rebuilt after a resize or an out of date surface"))
 {
     glfwSetErrorCallback(GlfwErrorTracker::GlfwErrorCallback);
 
@@ -144,15 +150,26 @@ void VulkanRenderer::FillInConfig()
 
 void VulkanRenderer::Initialize(const RendererConfig& config)
 {
-    LOG_INFO("VulkanRenderer::Initialize - Start");
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "VulkanRenderer::Initialize - Start");
 
     m_config = config;
     FillInConfig();
 
-    LOG_INFO("Render Window RGB depths: " << m_config.m_redBits << "/" << m_config.m_greenBits << "/" << m_config.m_blueBits);
-    LOG_INFO("Render Window Dimensions: " << m_config.m_windowWidth << " x " << m_config.m_windowHeight);
-    LOG_INFO("Render Window Refresh Rate: " << m_config.m_refreshRate << " Hz");
-    LOG_INFO("Render Window Mode: " << m_config.m_windowed ? "Windowed" : "FullScreen");
+    if (!m_config.m_profileTracePath.empty())
+    {
+        IP::Profiling::SetProfileThreadName("Render");
+        if (!IP::Profiling::StartProfileStream(m_config.m_profileTracePath.c_str()))
+        {
+            LOG_CH_WARN(IP::Logging::LogChannel::Render, "Unable to create profile stream " << m_config.m_profileTracePath);
+        }
+    }
+
+    IP_PROFILE_SCOPE("VulkanRenderer::Initialize");
+
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "Render Window RGB depths: " << m_config.m_redBits << "/" << m_config.m_greenBits << "/" << m_config.m_blueBits);
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "Render Window Dimensions: " << m_config.m_windowWidth << " x " << m_config.m_windowHeight);
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "Render Window Refresh Rate: " << m_config.m_refreshRate << " Hz");
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "Render Window Mode: " << m_config.m_windowed ? "Windowed" : "FullScreen");
 
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
     glfwWindowHint(GLFW_RED_BITS, m_config.m_redBits);
@@ -173,7 +190,7 @@ void VulkanRenderer::Initialize(const RendererConfig& config)
 
     m_frameRateController.ResetTargetFrameRate(m_config.m_refreshRate);
 
-    LOG_INFO("VulkanRenderer::Initialize - End");
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "VulkanRenderer::Initialize - End");
 }
 
 void VulkanRenderer::OnWindowResized(GLFWwindow* window, int width, int height) 
@@ -189,7 +206,12 @@ void VulkanRenderer::OnWindowResized(GLFWwindow* window, int width, int height)
 
 void VulkanRenderer::Shutdown()
 {
-    LOG_INFO("VulkanRenderer::Shutdown - Start");
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "VulkanRenderer::Shutdown - Start");
+
+    if (!m_config.m_profileTracePath.empty())
+    {
+        WriteProfile();
+    }
 
     CleanupRenderer();
 
@@ -205,7 +227,18 @@ void VulkanRenderer::Shutdown()
         m_glfwTerminate = false;
     }
 
-    LOG_INFO("VulkanRenderer::Shutdown - End");
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "VulkanRenderer::Shutdown - End");
+}
+
+void VulkanRenderer::WriteProfile()
+{
+    if (!IP::Profiling::StopProfiling())
+    {
+        LOG_CH_WARN(IP::Logging::LogChannel::Render, "Profile stream " << m_config.m_profileTracePath << " stopped early on a write error");
+        return;
+    }
+
+    LOG_CH_INFO(IP::Logging::LogChannel::Render, "Profile streamed to " << m_config.m_profileTracePath << "; profile-convert turns it into a Chrome trace and frame report");
 }
 
 bool VulkanRenderer::HandleInput()
@@ -222,6 +255,8 @@ bool VulkanRenderer::HandleInput()
 
 void VulkanRenderer::InitializeRenderer()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeRenderer");
+
     InitializeVulkanInstance();
     InitializeValidationCallback();
     InitializeSurface();
@@ -238,7 +273,12 @@ void VulkanRenderer::InitializeRenderer()
 
 void VulkanRenderer::ResetSwapChainRelatedResources()
 {
-    LOG_INFO("VulkanRenderer::ResetSwapChainRelatedResources - Start");
+    IP_PROFILE_SCOPE("VulkanRenderer::ResetSwapChainRelatedResources");
+
+    m_swapChainResetMetric.Increment();
+
+    // fires on every frame of a window resize
+    LOG_EVERY_MS(IP::Logging::LogLevel::Info, 1000, "VulkanRenderer::ResetSwapChainRelatedResources - Start");
 
     vkDeviceWaitIdle(m_logicalDevice);
 
@@ -253,7 +293,7 @@ void VulkanRenderer::ResetSwapChainRelatedResources()
     InitializeFramebuffers();
     InitializeCommandBuffers();
 
-    LOG_INFO("VulkanRenderer::ResetSwapChainRelatedResources - End");
+    LOG_EVERY_MS(IP::Logging::LogLevel::Info, 1000, "VulkanRenderer::ResetSwapChainRelatedResources - End");
 }
 
 void VulkanRenderer::CleanupSwapChainRelatedResources()
@@ -295,17 +335,19 @@ void VulkanRenderer::CleanupSwapChainRelatedResources()
 
 void VulkanRenderer::InitializeVulkanInstance()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeVulkanInstance");
+
     BuildValidationLayerSet();
     IP::Vector<const char *> rawLayerNames;
     std::for_each(m_validationLayerNames.cbegin(), m_validationLayerNames.cend(), [&](const IP::String& name){ rawLayerNames.push_back(name.c_str()); });
 
-    LOG_INFO("Vulkan Validation Layers Selected: " << IP::StringUtils::ToString(m_validationLayerNames, ", "));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Vulkan Validation Layers Selected: " << IP::StringUtils::ToString(m_validationLayerNames, ", "));
 
     BuildVulkanExtensionSet();
     IP::Vector<const char *> rawExtensionNames;
     std::for_each(m_vulkanExtensionNames.cbegin(), m_vulkanExtensionNames.cend(), [&](const IP::String& name){ rawExtensionNames.push_back(name.c_str()); });
 
-    LOG_INFO("Vulkan Extensions Selected: " << IP::StringUtils::ToString(m_vulkanExtensionNames, ", "));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Vulkan Extensions Selected: " << IP::StringUtils::ToString(m_vulkanExtensionNames, ", "));
 
     VkApplicationInfo applicationInfo = {};
     applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -398,7 +440,7 @@ void VulkanRenderer::BuildVulkanExtensionSet()
     IP::Vector<VkExtensionProperties> extensions(extensionCount);
     vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensions.data());
 
-    LOG_INFO("Detected Vulkan Extensions:\n\t" << IP::StringUtils::ToString(extensions, ",\n\t", [](const VkExtensionProperties& props) { return IP::String(props.extensionName); }));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Detected Vulkan Extensions:\n\t" << IP::StringUtils::ToString(extensions, ",\n\t", [](const VkExtensionProperties& props) { return IP::String(props.extensionName); }));
 
     // make an easy to search set
     IP::Set<IP::String> presentExtensions;
@@ -423,7 +465,7 @@ void VulkanRenderer::BuildVulkanExtensionSet()
         requiredExtensions.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
     }
 
-    LOG_INFO("Required Vulkan Extensions:\n\t" << IP::StringUtils::ToString(requiredExtensions, ",\n\t"));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Required Vulkan Extensions:\n\t" << IP::StringUtils::ToString(requiredExtensions, ",\n\t"));
 
     for (const auto& requiredExtension : requiredExtensions)
     {
@@ -461,7 +503,7 @@ void VulkanRenderer::BuildValidationLayerSet()
     IP::Vector<VkLayerProperties> availableLayers(layerCount);
     vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
 
-    LOG_INFO("Available Vulkan Validation Layers: \n\t" << IP::StringUtils::ToString(availableLayers, ",\n\t", [](const VkLayerProperties& layer) { return IP::String(layer.layerName); }));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Available Vulkan Validation Layers: \n\t" << IP::StringUtils::ToString(availableLayers, ",\n\t", [](const VkLayerProperties& layer) { return IP::String(layer.layerName); }));
 
     IP::Set<IP::String> layerSet;
     for (const auto& layer : availableLayers)
@@ -476,7 +518,7 @@ void VulkanRenderer::BuildValidationLayerSet()
         std::copy(s_debugValidationLayers, s_debugValidationLayers + sizeof(s_debugValidationLayers) / sizeof(s_debugValidationLayers[0]), std::back_inserter(requiredLayers));
     }
 
-    LOG_INFO("Required Vulkan Validation Layers: " << IP::StringUtils::ToString(requiredLayers, ", "));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Required Vulkan Validation Layers: " << IP::StringUtils::ToString(requiredLayers, ", "));
 
     for(const auto& requiredLayer : requiredLayers)
     {
@@ -508,6 +550,8 @@ IP::Vector<IP::String> VulkanRenderer::GetOptionalValidationLayers() const
 
 void VulkanRenderer::InitializeValidationCallback()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeValidationCallback");
+
     if (m_validationLayerNames.empty())
     {
         return;
@@ -543,14 +587,16 @@ void VulkanRenderer::CleanupValidationCallback()
 void VulkanRenderer::LogPhysicalDeviceScore(IP::Logging::LogLevel logLevel, const VulkanDeviceProperties& deviceProperties) const
 {
 
-    LOG(logLevel, "[" << deviceProperties.m_name << "] GraphicsQueueFamilyIndex: " << deviceProperties.m_graphicsQueueFamilyIndex);
-    LOG(logLevel, "[" << deviceProperties.m_name << "] PresentationQueueFamilyIndex: " << deviceProperties.m_presentationQueueFamilyIndex);
-    LOG(logLevel, "[" << deviceProperties.m_name << "] SupportedExtensions: \n\t" << IP::StringUtils::ToString(deviceProperties.m_extensionNames, ",\n\t"));
-    LOG(logLevel, "[" << deviceProperties.m_name << "] SupportsRequiredExtensions: " << deviceProperties.m_supportsRequiredExtensions);
+    LOG_CH(IP::Logging::LogChannel::Vulkan, logLevel, "[" << deviceProperties.m_name << "] GraphicsQueueFamilyIndex: " << deviceProperties.m_graphicsQueueFamilyIndex);
+    LOG_CH(IP::Logging::LogChannel::Vulkan, logLevel, "[" << deviceProperties.m_name << "] PresentationQueueFamilyIndex: " << deviceProperties.m_presentationQueueFamilyIndex);
+    LOG_CH(IP::Logging::LogChannel::Vulkan, logLevel, "[" << deviceProperties.m_name << "] SupportedExtensions: \n\t" << IP::StringUtils::ToString(deviceProperties.m_extensionNames, ",\n\t"));
+    LOG_CH(IP::Logging::LogChannel::Vulkan, logLevel, "[" << deviceProperties.m_name << "] SupportsRequiredExtensions: " << deviceProperties.m_supportsRequiredExtensions);
 }
 
 void VulkanRenderer::InitializeDevice()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeDevice");
+
     uint32_t deviceCount = 0;
     vkEnumeratePhysicalDevices(m_vulkanInstance, &deviceCount, nullptr);
 
@@ -570,7 +616,7 @@ void VulkanRenderer::InitializeDevice()
         VulkanDeviceProperties deviceProperties;
         int32_t score = ScorePhysicalDevice(device, deviceProperties);
 
-        LOG_DEBUG("Vulkan physical device " << deviceProperties.m_name << " detected with score " << score);
+        LOG_CH_DEBUG(IP::Logging::LogChannel::Vulkan, "Vulkan physical device " << deviceProperties.m_name << " detected with score " << score);
         LogPhysicalDeviceScore(IP::Logging::LogLevel::Debug, deviceProperties);
 
         if (score > bestDeviceScore) 
@@ -586,7 +632,7 @@ void VulkanRenderer::InitializeDevice()
         THROW_IP_EXCEPTION("Vulkan: no physical devices meet application requirements");
     }
 
-    LOG_INFO("Vulkan physical device " << bestDeviceProperties.m_name << " selected with score " << bestDeviceScore);
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Vulkan physical device " << bestDeviceProperties.m_name << " selected with score " << bestDeviceScore);
     LogPhysicalDeviceScore(IP::Logging::LogLevel::Info, bestDeviceProperties);
 
     m_physicalDevice = bestDevice;
@@ -619,7 +665,7 @@ void VulkanRenderer::InitializeDevice()
         THROW_IP_EXCEPTION("Vulkan: selected device does not have support for required extensions");
     }
 
-    LOG_INFO("Using device extensions:\n\t" << IP::StringUtils::ToString(m_deviceExtensionNames, ",\n\t"));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Using device extensions:\n\t" << IP::StringUtils::ToString(m_deviceExtensionNames, ",\n\t"));
 
     IP::Vector<const char *> deviceExtensions;
     std::for_each(m_deviceExtensionNames.cbegin(), m_deviceExtensionNames.cend(), [&](const IP::String& name){deviceExtensions.push_back(name.c_str());});
@@ -635,7 +681,7 @@ void VulkanRenderer::InitializeDevice()
         createInfo.ppEnabledLayerNames = validationLayers.data();
     } 
 
-    LOG_INFO("Using device validation layers:\n\t" << IP::StringUtils::ToString(m_validationLayerNames, ",\n\t"));
+    LOG_CH_INFO(IP::Logging::LogChannel::Vulkan, "Using device validation layers:\n\t" << IP::StringUtils::ToString(m_validationLayerNames, ",\n\t"));
 
     VkResult result = vkCreateDevice(m_physicalDevice, &createInfo, nullptr, &m_logicalDevice);
     if (result != VK_SUCCESS) 
@@ -782,6 +828,8 @@ int32_t VulkanRenderer::ScorePhysicalDevice(VkPhysicalDevice device, VulkanDevic
 
 void VulkanRenderer::InitializeSurface()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeSurface");
+
     VkResult result = glfwCreateWindowSurface(m_vulkanInstance, m_window, nullptr, &m_surface);
     if (result != VK_SUCCESS) {
         THROW_IP_EXCEPTION("Failed to create window surface");
@@ -883,6 +931,8 @@ VkExtent2D VulkanRenderer::SelectSwapExtent() const
 
 void VulkanRenderer::InitializeSwapChain()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeSwapChain");
+
     m_swapSurfaceFormat = SelectSwapSurfaceFormat();
     m_swapPresentationMode = SelectSwapPresentationMode();
     m_swapExtents = SelectSwapExtent();
@@ -948,6 +998,8 @@ void VulkanRenderer::InitializeSwapChain()
 
 void VulkanRenderer::InitializeSwapChainImageViews()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeSwapChainImageViews");
+
     for (size_t i = 0; i < m_swapChainImages.size(); ++i)
     {
         VkImageViewCreateInfo createInfo = {};
@@ -988,6 +1040,8 @@ void VulkanRenderer::CleanupSwapChainImageViews()
 
 void VulkanRenderer::InitializeRenderPass()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeRenderPass");
+
     VkAttachmentDescription colorAttachmentConfig = {};
     colorAttachmentConfig.format = m_swapSurfaceFormat.format;
     colorAttachmentConfig.samples = VK_SAMPLE_COUNT_1_BIT;
@@ -1033,6 +1087,8 @@ void VulkanRenderer::InitializeRenderPass()
 
 void VulkanRenderer::InitializeGraphicsPipeline()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeGraphicsPipeline");
+
     ScopedVulkanShader vertexShader(IP::FileUtils::LoadFileData("resources/shaders/hard_coded_triangle_vert.spv"), m_logicalDevice);
     ScopedVulkanShader fragmentShader(IP::FileUtils::LoadFileData("resources/shaders/hard_coded_triangle_frag.spv"), m_logicalDevice);
 
@@ -1146,6 +1202,8 @@ void VulkanRenderer::InitializeGraphicsPipeline()
 
 void VulkanRenderer::InitializeFramebuffers()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeFramebuffers");
+
     for (size_t i = 0; i < m_swapChainImageViews.size(); ++i) 
     {
         VkImageView attachments[] = {
@@ -1184,6 +1242,8 @@ void VulkanRenderer::CleanupFramebuffers()
 
 void VulkanRenderer::InitializeCommandPool()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeCommandPool");
+
     VkCommandPoolCreateInfo commandPoolConfig = {};
     commandPoolConfig.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     commandPoolConfig.queueFamilyIndex = m_selectedDeviceProperties.m_graphicsQueueFamilyIndex;
@@ -1198,6 +1258,8 @@ void VulkanRenderer::InitializeCommandPool()
 
 void VulkanRenderer::InitializeCommandBuffers()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeCommandBuffers");
+
     for (size_t i = 0; i < m_swapChainFramebuffers.size(); ++i)
     {
         VkCommandBufferAllocateInfo commandBufferAllocConfig = {};
@@ -1253,6 +1315,8 @@ void VulkanRenderer::InitializeCommandBuffers()
 
 void VulkanRenderer::InitializeSynchronization()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::InitializeSynchronization");
+
     VkSemaphoreCreateInfo semaphoreConfig = {};
     semaphoreConfig.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
@@ -1273,15 +1337,19 @@ bool VulkanRenderer::HandleRenderingError(VkResult result)
 {
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
     {
+        LOG_WARN_EVERY_MS(1000, "Swap chain out of date or suboptimal, result " << (int32_t)result);
         ResetSwapChainRelatedResources();
         return true;
     }
-    
+
+    LOG_ERROR_FIRST_N(10, "Unrecoverable rendering error, result " << (int32_t)result);
     return false;
 }
 
 bool VulkanRenderer::RenderFrame()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::RenderFrame");
+
     if (ShouldUseValidationLayers(m_config))
     {
         vkQueueWaitIdle(m_presentationQueue);
@@ -1294,7 +1362,11 @@ bool VulkanRenderer::RenderFrame()
     }
 
     uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(m_logicalDevice, m_swapChain, std::numeric_limits<uint64_t>::max(), m_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    VkResult result = VK_SUCCESS;
+    {
+        FramePhaseTimer phaseTimer(m_frameStatistics, FramePhase::Acquire);
+        result = vkAcquireNextImageKHR(m_logicalDevice, m_swapChain, std::numeric_limits<uint64_t>::max(), m_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    }
 
     if (result != VK_SUCCESS)
     {
@@ -1315,10 +1387,16 @@ bool VulkanRenderer::RenderFrame()
     submitConfig.signalSemaphoreCount = 1;
     submitConfig.pSignalSemaphores = signalSemaphores;
 
-    result = vkQueueSubmit(m_graphicsQueue, 1, &submitConfig, VK_NULL_HANDLE);
+    {
+        FramePhaseTimer phaseTimer(m_frameStatistics, FramePhase::Submit);
+        result = vkQueueSubmit(m_graphicsQueue, 1, &submitConfig, VK_NULL_HANDLE);
+    }
+
     if (result != VK_SUCCESS)
     {
-        return true; // Log, no exceptions inside rendering
+        // no exceptions inside rendering
+        LOG_ERROR_EVERY_MS(1000, "Failed to submit draw command buffer, result " << (int32_t)result);
+        return true;
     }
 
     VkSwapchainKHR swapChains[] = { m_swapChain };
@@ -1331,7 +1409,10 @@ bool VulkanRenderer::RenderFrame()
     presentConfig.pSwapchains = swapChains;
     presentConfig.pImageIndices = &imageIndex;
 
-    result = vkQueuePresentKHR(m_presentationQueue, &presentConfig);
+    {
+        FramePhaseTimer phaseTimer(m_frameStatistics, FramePhase::Present);
+        result = vkQueuePresentKHR(m_presentationQueue, &presentConfig);
+    }
 
     if (result != VK_SUCCESS)
     {
@@ -1366,14 +1447,19 @@ void VulkanRenderer::EnumerateDisplayModes(IP::Vector<DisplayMode>& modes) const
 
 void VulkanRenderer::Run()
 {
+    IP_PROFILE_SCOPE("VulkanRenderer::Run");
+
     while (HandleInput())
     {
         auto timeTilNextFrame = m_frameRateController.Service();
         if (timeTilNextFrame.count() == 0)
         {
-            LOG_TRACE("FrameRender Start");
+            IP_PROFILE_FRAME();
+            LOG_CH_TRACE(IP::Logging::LogChannel::Render, "FrameRender Start");
+            m_frameStatistics.BeginFrame();
             bool success = RenderFrame();
-            LOG_TRACE("FrameRender End");
+            m_frameStatistics.EndFrame(m_frameRateController.GetTargetFrameLength());
+            LOG_CH_TRACE(IP::Logging::LogChannel::Render, "FrameRender End");
             if (!success)
             {
                 break;
@@ -0,0 +1,517 @@
+#include <iostream>
+
+#include <ip/core/logging/AsyncFileLogger.h>
+#include <ip/core/logging/BackgroundLogger.h>
+#include <ip/core/logging/BinaryFileLogger.h>
+#include <ip/core/logging/CompositeLogger.h>
+#include <ip/core/logging/ConsoleLogger.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/logging/LogSystem.h>
+#include <ip/core/logging/MappedFileLogger.h>
+#include <ip/core/logging/PatternLogLineFormatter.h>
+#include <ip/core/logging/RollingFileLogger.h>
+#include <ip/core/logging/SharedMemoryLogger.h>
+#include <ip/core/logging/StandardLogLineFormatter.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include <stdio.h>
+#include <string.h>
+
+// Drives LOG_INFO from a number of producer threads through BackgroundLogger into each sink and reports what it costs
+// the callers, how long lines take to reach the sink, sustained throughput, how many lines were dropped and how many
+// heap allocations a warm producer thread makes per LOG statement.  Text buffers are recycled, so allocations only
+// come from the queue backlog reaching a new high.
+//
+// With --steady-state, the producers repeat their messages in passes, with the queue drained in between.  The first pass
+// grows the text pool and queues to the backlog the workload reaches, and the run stops at the first later pass that
+// makes no allocations at all.  A pass can still allocate if its backlog peaks higher than any before it; the
+// benchmark fails if none of MAX_STEADY_STATE_PASSES gets to zero.
+//
+// usage: log-benchmark [--threads N] [--messages N] [--size BYTES] [--capacity N] [--overflow drop-newest|drop-oldest|block|sample]
+//                      [--sink NAME] [--directory PATH] [--steady-state]
+
+using namespace IP::Logging;
+
+using SteadyClock = std::chrono::steady_clock;
+
+// producer statements excluded from the allocation count while thread-local buffers and pools warm up
+static const uint32_t MAX_WARMUP_MESSAGES = 1000;
+
+static const uint32_t MAX_STEADY_STATE_PASSES = 5;
+
+// how long the queue has to go without delivering anything for a steady-state run to consider it drained
+static const std::chrono::milliseconds DRAIN_SETTLE_TIME(200);
+
+static thread_local uint64_t t_allocationCount = 0;
+
+// Counts allocations made through IP::Malloc and global operator new, per thread
+class CountingAllocator : public IP::IMemoryAllocator
+{
+    public:
+
+        virtual void* Allocate(const char*, size_t size) override
+        {
+            ++t_allocationCount;
+            return malloc(size);
+        }
+
+        virtual void Free(void* memory) override
+        {
+            free(memory);
+        }
+};
+
+void* operator new(size_t size)
+{
+    ++t_allocationCount;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+struct BenchmarkConfig
+{
+    uint32_t m_threadCount = 4;
+    uint32_t m_messagesPerThread = 250000;
+    size_t m_messageSize = 100;
+    LogQueuePolicy m_queuePolicy;
+    IP::String m_sinkName = "all";
+    IP::String m_directory = "log-benchmark-output";
+    bool m_steadyState = false;
+};
+
+// what the probe in front of the sink observed; written only by the background thread, read after it has exited
+// except for the delivered count, which a steady-state run watches to see the queue drain
+struct SinkStatistics
+{
+    IP::Vector<int64_t> m_endToEndLatencies;
+    std::atomic<uint64_t> m_deliveredCount{0};
+};
+
+// Sits between the BackgroundLogger and the sink being measured, recording when each benchmark line arrives
+class LatencyProbeLogger : public ILogger
+{
+    public:
+
+        LatencyProbeLogger(IP::UniquePtr<ILogger>&& logger, const std::shared_ptr<SinkStatistics>& statistics) :
+            m_logger(std::move(logger)),
+            m_statistics(statistics)
+        {}
+
+        virtual void Log(LogEntry&& entry) override
+        {
+            // BackgroundLogger's own drop reports are Warn; benchmark lines are Info
+            if (entry.m_level == LogLevel::Info)
+            {
+                auto latency = IP::Time::GetCurrentSystemTime() - entry.m_time;
+                m_statistics->m_endToEndLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+                m_statistics->m_deliveredCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            m_logger->Log(std::move(entry));
+        }
+
+        virtual void Flush() override { m_logger->Flush(); }
+        virtual void Service() override { m_logger->Service(); }
+
+    private:
+
+        IP::UniquePtr<ILogger> m_logger;
+        std::shared_ptr<SinkStatistics> m_statistics;
+};
+
+struct SinkDescription
+{
+    const char* m_name;
+    std::function<IP::UniquePtr<ILogger>(const IP::String& directory)> m_factory;
+};
+
+static IP::UniquePtr<ILogLineFormatter> CreateFormatter()
+{
+    return IP::MakeUniqueUpcast<StandardLogLineFormatter, ILogLineFormatter>(MEMORY_TAG);
+}
+
+static IP::Vector<SinkDescription> BuildSinkDescriptions()
+{
+    IP::Vector<SinkDescription> sinks;
+
+    sinks.push_back({ "rolling-standard", [](const IP::String& directory) {
+        return IP::MakeUniqueUpcast<RollingFileLogger, ILogger>(MEMORY_TAG, CreateFormatter(), "rolling", directory.c_str()); } });
+
+    sinks.push_back({ "rolling-pattern", [](const IP::String& directory) {
+        return IP::MakeUniqueUpcast<RollingFileLogger, ILogger>(MEMORY_TAG,
+            IP::MakeUniqueUpcast<PatternLogLineFormatter, ILogLineFormatter>(MEMORY_TAG, "%D %T.%e [%l] [%t] %v"), "pattern", directory.c_str()); } });
+
+    sinks.push_back({ "mapped-standard", [](const IP::String& directory) {
+        return IP::MakeUniqueUpcast<MappedFileLogger, ILogger>(MEMORY_TAG, CreateFormatter(), "mapped", directory.c_str()); } });
+
+#ifndef _WIN32
+    sinks.push_back({ "async-standard", [](const IP::String& directory) {
+        return IP::MakeUniqueUpcast<AsyncFileLogger, ILogger>(MEMORY_TAG, CreateFormatter(), "async", directory.c_str()); } });
+#endif
+
+    sinks.push_back({ "binary", [](const IP::String& directory) {
+        return IP::MakeUniqueUpcast<BinaryFileLogger, ILogger>(MEMORY_TAG, "binary", directory.c_str()); } });
+
+    sinks.push_back({ "composite-rolling-binary", [](const IP::String& directory) {
+        IP::Vector<IP::UniquePtr<ILogger>> loggers;
+        loggers.push_back(IP::MakeUniqueUpcast<RollingFileLogger, ILogger>(MEMORY_TAG, CreateFormatter(), "composite", directory.c_str()));
+        loggers.push_back(IP::MakeUniqueUpcast<BinaryFileLogger, ILogger>(MEMORY_TAG, "composite", directory.c_str()));
+        return IP::MakeUniqueUpcast<CompositeLogger, ILogger>(MEMORY_TAG, std::move(loggers)); } });
+
+    sinks.push_back({ "shared-memory", [](const IP::String&) {
+        return IP::MakeUniqueUpcast<SharedMemoryLogger, ILogger>(MEMORY_TAG, CreateFormatter(), "log-benchmark"); } });
+
+    // not part of "all"; the terminal is usually the bottleneck
+    sinks.push_back({ "console-standard", [](const IP::String&) {
+        return IP::MakeUniqueUpcast<ConsoleLogger, ILogger>(MEMORY_TAG, CreateFormatter()); } });
+
+    return sinks;
+}
+
+static int64_t Percentile(const IP::Vector<int64_t>& sortedValues, double percentile)
+{
+    if (sortedValues.empty())
+    {
+        return 0;
+    }
+
+    size_t index = static_cast<size_t>(percentile * (sortedValues.size() - 1));
+    return sortedValues[index];
+}
+
+static void PrintLatencies(const char* label, IP::Vector<int64_t>& latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+
+    printf("  %-10s p50 %9.2f us  p90 %9.2f us  p99 %9.2f us  p99.9 %9.2f us  max %9.2f us\n", label,
+        Percentile(latencies, 0.5) / 1000.0,
+        Percentile(latencies, 0.9) / 1000.0,
+        Percentile(latencies, 0.99) / 1000.0,
+        Percentile(latencies, 0.999) / 1000.0,
+        latencies.empty() ? 0.0 : latencies.back() / 1000.0);
+}
+
+// waits until the background thread has delivered everything it's going to, dropped lines included
+static void WaitForDrain(const SinkStatistics& statistics, uint64_t producedCount)
+{
+    uint64_t deliveredCount = statistics.m_deliveredCount.load();
+    auto lastProgressTime = SteadyClock::now();
+
+    while (deliveredCount < producedCount && SteadyClock::now() - lastProgressTime < DRAIN_SETTLE_TIME)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        uint64_t currentCount = statistics.m_deliveredCount.load();
+        if (currentCount != deliveredCount)
+        {
+            deliveredCount = currentCount;
+            lastProgressTime = SteadyClock::now();
+        }
+    }
+}
+
+// returns false if a steady-state run never stopped allocating
+static bool RunBenchmark(const BenchmarkConfig& config, const SinkDescription& sink)
+{
+    uint32_t maxPassCount = config.m_steadyState ? MAX_STEADY_STATE_PASSES : 1;
+    uint64_t passMessageCount = static_cast<uint64_t>(config.m_threadCount) * config.m_messagesPerThread;
+
+    auto statistics = std::make_shared<SinkStatistics>();
+    statistics->m_endToEndLatencies.reserve(static_cast<size_t>(maxPassCount * passMessageCount));
+
+    IP::String directory = config.m_directory;
+    auto backgroundLogger = IP::MakeUnique<BackgroundLogger>(MEMORY_TAG, [&]() {
+        return IP::MakeUniqueUpcast<LatencyProbeLogger, ILogger>(MEMORY_TAG, sink.m_factory(directory), statistics); }, config.m_queuePolicy);
+
+    Initialize(backgroundLogger.get());
+
+    IP::String payload(config.m_messageSize, 'x');
+    IP::Vector<IP::Vector<int64_t>> callerLatencies(config.m_threadCount);
+    IP::Vector<uint64_t> passAllocationCounts(config.m_threadCount);
+    uint32_t warmupMessages = config.m_steadyState ? 0 : std::min(MAX_WARMUP_MESSAGES, config.m_messagesPerThread / 10);
+    IP::Vector<std::thread> producers;
+
+    // in a steady-state run producers finish each pass and wait for the next to be released, or for the run to end
+    std::atomic<bool> start(false);
+    std::atomic<uint32_t> passDoneCount(0);
+    std::atomic<uint32_t> releasedPass(0);
+    std::atomic<bool> passesFinished(false);
+    auto startTime = SteadyClock::now();
+
+    for (uint32_t threadIndex = 0; threadIndex < config.m_threadCount; ++threadIndex)
+    {
+        producers.emplace_back([&, threadIndex]() {
+            IP::Vector<int64_t>& latencies = callerLatencies[threadIndex];
+            latencies.reserve(config.m_messagesPerThread);
+
+            while (!start)
+            {
+                std::this_thread::yield();
+            }
+
+            for (uint32_t pass = 0; ; ++pass)
+            {
+                // caller latencies are reported for the last pass only
+                latencies.clear();
+
+                uint64_t allocationsAtStart = t_allocationCount;
+                for (uint32_t i = 0; i < config.m_messagesPerThread; ++i)
+                {
+                    if (i == warmupMessages)
+                    {
+                        allocationsAtStart = t_allocationCount;
+                    }
+
+                    auto callStart = SteadyClock::now();
+                    LOG_INFO("benchmark thread " << threadIndex << " message " << i << " " << payload);
+                    auto callEnd = SteadyClock::now();
+
+                    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(callEnd - callStart).count());
+                }
+
+                passAllocationCounts[threadIndex] = t_allocationCount - allocationsAtStart;
+                if (!config.m_steadyState)
+                {
+                    break;
+                }
+
+                ++passDoneCount;
+                while (releasedPass <= pass && !passesFinished)
+                {
+                    std::this_thread::yield();
+                }
+
+                if (passesFinished)
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    startTime = SteadyClock::now();
+    start = true;
+
+    uint32_t passCount = 1;
+    uint64_t passAllocations = 0;
+    if (config.m_steadyState)
+    {
+        // the first pass grows the pools and queues; later passes run until one makes no allocations at all
+        for (uint32_t pass = 0; ; ++pass)
+        {
+            while (passDoneCount < config.m_threadCount * (pass + 1))
+            {
+                std::this_thread::yield();
+            }
+
+            WaitForDrain(*statistics, (pass + 1) * passMessageCount);
+
+            passCount = pass + 1;
+            passAllocations = 0;
+            for (uint64_t count : passAllocationCounts)
+            {
+                passAllocations += count;
+            }
+
+            if ((pass > 0 && passAllocations == 0) || passCount == maxPassCount)
+            {
+                passesFinished = true;
+                break;
+            }
+
+            releasedPass = pass + 1;
+        }
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    auto producersDoneTime = SteadyClock::now();
+
+    // destroying the BackgroundLogger drains its queue and flushes the sink
+    Shutdown();
+    backgroundLogger = nullptr;
+
+    auto drainedTime = SteadyClock::now();
+
+    uint64_t producedCount = passCount * passMessageCount;
+    uint64_t deliveredCount = statistics->m_deliveredCount;
+    double produceSeconds = std::chrono::duration<double>(producersDoneTime - startTime).count();
+    double drainSeconds = std::chrono::duration<double>(drainedTime - startTime).count();
+
+    IP::Vector<int64_t> allCallerLatencies;
+    allCallerLatencies.reserve(passMessageCount);
+    for (auto& latencies : callerLatencies)
+    {
+        allCallerLatencies.insert(allCallerLatencies.end(), latencies.begin(), latencies.end());
+    }
+
+    if (!config.m_steadyState)
+    {
+        for (uint64_t count : passAllocationCounts)
+        {
+            passAllocations += count;
+        }
+    }
+
+    printf("%s\n", sink.m_name);
+    printf("  produced %llu lines in %.3f s (%.0f lines/s offered), delivered %llu in %.3f s (%.0f lines/s sustained), dropped %llu\n",
+        static_cast<unsigned long long>(producedCount), produceSeconds, producedCount / produceSeconds,
+        static_cast<unsigned long long>(deliveredCount), drainSeconds, deliveredCount / drainSeconds,
+        static_cast<unsigned long long>(producedCount - deliveredCount));
+
+    bool allocationFree = true;
+    if (config.m_steadyState)
+    {
+        allocationFree = passAllocations == 0;
+        printf("  %llu heap allocations in %llu LOG calls on pass %u of %u%s\n", static_cast<unsigned long long>(passAllocations),
+            static_cast<unsigned long long>(passMessageCount), passCount, maxPassCount, allocationFree ? ", steady state reached" : ", never reached a steady state");
+    }
+    else
+    {
+        uint64_t warmCallCount = static_cast<uint64_t>(config.m_threadCount) * (config.m_messagesPerThread - warmupMessages);
+        printf("  %llu heap allocations in %llu warm LOG calls (%.4f per call)\n", static_cast<unsigned long long>(passAllocations),
+            static_cast<unsigned long long>(warmCallCount), warmCallCount > 0 ? static_cast<double>(passAllocations) / warmCallCount : 0.0);
+    }
+
+    PrintLatencies("caller", allCallerLatencies);
+    PrintLatencies("end-to-end", statistics->m_endToEndLatencies);
+
+    return allocationFree;
+}
+
+static bool ParseArguments(int argc, char* argv[], BenchmarkConfig& config)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* option = argv[i];
+        if (!strcmp(option, "--steady-state"))
+        {
+            config.m_steadyState = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+
+        const char* value = argv[++i];
+
+        if (!strcmp(option, "--threads"))
+        {
+            config.m_threadCount = std::max(1, atoi(value));
+        }
+        else if (!strcmp(option, "--messages"))
+        {
+            config.m_messagesPerThread = std::max(1, atoi(value));
+        }
+        else if (!strcmp(option, "--size"))
+        {
+            config.m_messageSize = std::max(0, atoi(value));
+        }
+        else if (!strcmp(option, "--capacity"))
+        {
+            config.m_queuePolicy.m_capacity = std::max(0, atoi(value));
+        }
+        else if (!strcmp(option, "--overflow"))
+        {
+            if (!strcmp(value, "drop-newest")) config.m_queuePolicy.m_overflowPolicy = LogOverflowPolicy::DropNewest;
+            else if (!strcmp(value, "drop-oldest")) config.m_queuePolicy.m_overflowPolicy = LogOverflowPolicy::DropOldest;
+            else if (!strcmp(value, "block")) config.m_queuePolicy.m_overflowPolicy = LogOverflowPolicy::Block;
+            else if (!strcmp(value, "sample")) config.m_queuePolicy.m_overflowPolicy = LogOverflowPolicy::SampleByLevel;
+            else return false;
+        }
+        else if (!strcmp(option, "--sink"))
+        {
+            config.m_sinkName = value;
+        }
+        else if (!strcmp(option, "--directory"))
+        {
+            config.m_directory = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkConfig config;
+    if (!ParseArguments(argc, argv, config))
+    {
+        std::cerr << "usage: log-benchmark [--threads N] [--messages N] [--size BYTES] [--capacity N] "
+                     "[--overflow drop-newest|drop-oldest|block|sample] [--sink NAME] [--directory PATH] [--steady-state]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CountingAllocator countingAllocator;
+    IP::ScopedMemoryAllocator allocatorScope(&countingAllocator);
+
+    SetLogLevel(LogLevel::Info);
+
+    printf("%u threads x %u messages, %zu byte payload, queue capacity %zu\n\n", config.m_threadCount, config.m_messagesPerThread, config.m_messageSize, config.m_queuePolicy.m_capacity);
+
+    bool ranAny = false;
+    bool allocationFree = true;
+    for (const auto& sink : BuildSinkDescriptions())
+    {
+        bool selected = config.m_sinkName == sink.m_name || (config.m_sinkName == "all" && strncmp(sink.m_name, "console", 7));
+        if (!selected)
+        {
+            continue;
+        }
+
+        // the console sink writes to the stdout descriptor directly, bypassing stdio's buffer
+        fflush(stdout);
+
+        try
+        {
+            allocationFree = RunBenchmark(config, sink) && allocationFree;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "log-benchmark: " << sink.m_name << ": " << e.what() << std::endl;
+        }
+
+        ranAny = true;
+    }
+
+    if (!ranAny)
+    {
+        std::cerr << "log-benchmark: unknown sink " << config.m_sinkName << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return allocationFree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
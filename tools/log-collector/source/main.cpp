@@ -0,0 +1,155 @@
+#include <iostream>
+
+#include <ip/core/logging/BinaryLogFormat.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/logging/StandardLogLineFormatter.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/utils/DatagramSocket.h>
+
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// A stand-in for a log collector daemon: binds a Unix datagram socket, receives what DatagramLoggers send to it and
+// prints one line per datagram until interrupted.  Binary datagrams are decoded to StandardLogLineFormatter text.
+// --delay-us makes it a deliberately slow collector, for exercising a sender's retry and drop policies.
+//
+// usage: log-collector [--binary] [--delay-us MICROSECONDS] [--quiet] <socket path>
+
+// how often an idle collector checks for interruption
+static const std::chrono::milliseconds RECEIVE_TIMEOUT(250);
+
+static volatile std::sig_atomic_t s_interrupted = 0;
+
+static void HandleInterrupt(int)
+{
+    s_interrupted = 1;
+}
+
+static void PrintUsage()
+{
+    std::cerr << "usage: log-collector [--binary] [--delay-us MICROSECONDS] [--quiet] <socket path>" << std::endl;
+}
+
+// each binary datagram is a single self-contained entry record, which the file reader decodes once given a header
+static bool DecodeBinaryDatagram(const IP::String& datagram, IP::String& record, IP::String& line)
+{
+    record.assign(IP::Logging::BINARY_LOG_MAGIC, sizeof(IP::Logging::BINARY_LOG_MAGIC));
+    record.append(datagram);
+
+    IP::Logging::BinaryLogReader reader(record.data(), record.size());
+    IP::Logging::LogEntry entry;
+    if (!reader.ReadNext(entry))
+    {
+        return false;
+    }
+
+    static IP::Logging::StandardLogLineFormatter formatter;
+    formatter.FormatLogLine(line, entry);
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    bool binary = false;
+    bool quiet = false;
+    long delayMicroseconds = 0;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--binary"))
+        {
+            binary = true;
+        }
+        else if (!strcmp(argv[i], "--quiet"))
+        {
+            quiet = true;
+        }
+        else if (!strcmp(argv[i], "--delay-us") && i + 1 < argc)
+        {
+            delayMicroseconds = atol(argv[++i]);
+        }
+        else if (path == nullptr && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (path == nullptr)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    IP::System::DatagramSocket socket;
+    if (!socket.Bind(path))
+    {
+        std::cerr << "log-collector: unable to bind " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::signal(SIGINT, HandleInterrupt);
+    std::signal(SIGTERM, HandleInterrupt);
+
+    IP::String datagram;
+    IP::String record;
+    IP::String line;
+    uint64_t received = 0;
+    uint64_t malformed = 0;
+
+    while (!s_interrupted)
+    {
+        if (!socket.Receive(datagram, RECEIVE_TIMEOUT))
+        {
+            fflush(stdout);
+            continue;
+        }
+
+        ++received;
+
+        if (delayMicroseconds > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(delayMicroseconds));
+        }
+
+        if (quiet)
+        {
+            continue;
+        }
+
+        line.clear();
+        if (!binary)
+        {
+            line.append(datagram);
+        }
+        else if (!DecodeBinaryDatagram(datagram, record, line))
+        {
+            ++malformed;
+            continue;
+        }
+
+        line.push_back('\n');
+        fwrite(line.data(), 1, line.size(), stdout);
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "log-collector: received %llu datagrams", static_cast<unsigned long long>(received));
+    if (malformed > 0)
+    {
+        fprintf(stderr, ", %llu malformed", static_cast<unsigned long long>(malformed));
+    }
+    fprintf(stderr, "\n");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+#include <iostream>
+
+#include <ip/core/logging/BinaryLogFormat.h>
+#include <ip/core/logging/LogEntry.h>
+#include <ip/core/logging/StandardLogLineFormatter.h>
+#include <ip/core/utils/MappedFile.h>
+
+#include <stdio.h>
+#include <string.h>
+
+// Decodes files written by BinaryFileLogger to stdout, either as StandardLogLineFormatter text or as one JSON object
+// per line.  Archived files have to be decompressed first.
+
+static void PrintUsage()
+{
+    std::cerr << "usage: log-decoder [--json] <file.blog>..." << std::endl;
+}
+
+static void AppendJsonString(IP::String& buffer, const char* value, size_t length)
+{
+    buffer.push_back('"');
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        char c = value[i];
+        switch (c)
+        {
+            case '"': buffer.append("\\\""); break;
+            case '\\': buffer.append("\\\\"); break;
+            case '\n': buffer.append("\\n"); break;
+            case '\r': buffer.append("\\r"); break;
+            case '\t': buffer.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escape[8];
+                    snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    buffer.append(escape);
+                }
+                else
+                {
+                    buffer.push_back(c);
+                }
+                break;
+        }
+    }
+
+    buffer.push_back('"');
+}
+
+static void AppendJsonString(IP::String& buffer, const char* value)
+{
+    AppendJsonString(buffer, value, strlen(value));
+}
+
+static void FormatJsonLine(IP::String& buffer, const IP::Logging::LogEntry& entry)
+{
+    int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.m_time.time_since_epoch()).count();
+
+    buffer.append("{\"time_ns\":");
+    buffer.append(std::to_string(time).c_str());
+    buffer.append(",\"level\":");
+    AppendJsonString(buffer, entry.m_levelName);
+
+    if (entry.m_channel != IP::Logging::LogChannel::General)
+    {
+        buffer.append(",\"channel\":");
+        AppendJsonString(buffer, IP::Logging::GetLogChannelName(entry.m_channel));
+    }
+
+    if (entry.m_site == nullptr)
+    {
+        buffer.append(",\"message\":");
+        AppendJsonString(buffer, entry.m_text.data(), entry.m_text.size());
+        buffer.push_back('}');
+        return;
+    }
+
+    buffer.append(",\"file\":");
+    AppendJsonString(buffer, entry.m_site->m_file);
+    buffer.append(",\"line\":");
+    buffer.append(std::to_string(entry.m_site->m_line).c_str());
+    buffer.append(",\"message\":");
+    AppendJsonString(buffer, entry.m_site->m_message);
+    buffer.append(",\"fields\":{");
+
+    const char* separator = "";
+    for (const auto& field : entry.m_fields)
+    {
+        buffer.append(separator);
+        separator = ",";
+
+        AppendJsonString(buffer, field.m_key);
+        buffer.push_back(':');
+
+        if (field.m_type == IP::Logging::LogFieldType::String)
+        {
+            AppendJsonString(buffer, field.m_string.data(), field.m_string.size());
+        }
+        else
+        {
+            IP::Logging::AppendLogFieldValue(buffer, field);
+        }
+    }
+
+    buffer.append("}}");
+}
+
+static bool DecodeFile(const char* path, bool json)
+{
+    IP::FileUtils::MappedFile file;
+    if (!file.Open(path, IP::FileUtils::MappedFileMode::ReadOnly))
+    {
+        std::cerr << "log-decoder: unable to open " << path << std::endl;
+        return false;
+    }
+
+    if (file.GetSize() == 0)
+    {
+        return true;
+    }
+
+    const char* data = file.Map(0, static_cast<size_t>(file.GetSize()));
+    if (data == nullptr)
+    {
+        std::cerr << "log-decoder: unable to map " << path << std::endl;
+        return false;
+    }
+
+    IP::Logging::StandardLogLineFormatter formatter;
+    IP::Logging::BinaryLogReader reader(data, static_cast<size_t>(file.GetSize()));
+    IP::Logging::LogEntry entry;
+    IP::String line;
+
+    while (reader.ReadNext(entry))
+    {
+        line.clear();
+
+        if (json)
+        {
+            FormatJsonLine(line, entry);
+        }
+        else
+        {
+            formatter.FormatLogLine(line, entry);
+        }
+
+        line.push_back('\n');
+        fwrite(line.data(), 1, line.size(), stdout);
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    bool json = false;
+    int firstFile = 1;
+
+    if (argc > 1 && !strcmp(argv[1], "--json"))
+    {
+        json = true;
+        firstFile = 2;
+    }
+
+    if (firstFile >= argc)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    bool success = true;
+    for (int i = firstFile; i < argc; ++i)
+    {
+        try
+        {
+            success = DecodeFile(argv[i], json) && success;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "log-decoder: " << argv[i] << ": " << e.what() << std::endl;
+            success = false;
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,373 @@
+#include <iostream>
+
+#include <ip/core/logging/LogFileIndex.h>
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/memory/stl/Vector.h>
+#include <ip/core/utils/MappedFile.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+// Prints the lines of a RollingFileLogger file that fall in a time window and/or are at or above a level, using the
+// file's sidecar index to map and scan only the byte ranges that can contain them.  Times are local times of day on
+// the date the file starts; without seconds, --from starts at the beginning of the minute and --to runs to its end.
+// The index records every entry's level, so indexed lines are selected without parsing them.  Lines past the end of the
+// index (the file was still being written, or the process crashed) are always scanned, taking each line's level from its
+// first bracketed level name and its time from its first HH:MM:SS; a line with neither continues the entry before it.
+//
+// usage: log-query [--from HH:MM[:SS]] [--to HH:MM[:SS]] [--level LEVEL] [--stats] <file.log>
+
+using namespace IP::Logging;
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct QueryOptions
+{
+    const char* m_from = nullptr;
+    const char* m_to = nullptr;
+    LogLevel m_minimumLevel = LogLevel::Trace;
+    bool m_printStatistics = false;
+    const char* m_logFile = nullptr;
+};
+
+static void PrintUsage()
+{
+    std::cerr << "usage: log-query [--from HH:MM[:SS]] [--to HH:MM[:SS]] [--level Trace|Debug|Info|Warn|Error|Fatal] [--stats] <file.log>" << std::endl;
+}
+
+static bool ParseLevel(const char* value, LogLevel& level)
+{
+    for (size_t i = 0; i < LOG_INDEX_LEVEL_COUNT; ++i)
+    {
+        if (!strcmp(value, GetLogLevelName(static_cast<LogLevel>(i))))
+        {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// what the unindexed lines at the end of the file are filtered by
+struct LineFilter
+{
+    LogLevel m_minimumLevel;
+    int64_t m_fromTime;
+    int64_t m_toTime;
+    int64_t m_referenceTime;
+};
+
+// a local time of day on the date of referenceTime, in milliseconds since the epoch
+static int64_t ResolveTimeOfDay(int64_t referenceTime, int hours, int minutes, int seconds)
+{
+    std::time_t referenceSeconds = static_cast<std::time_t>(referenceTime / 1000);
+    std::tm localTime = *std::localtime(&referenceSeconds);
+    localTime.tm_hour = hours;
+    localTime.tm_min = minutes;
+    localTime.tm_sec = seconds;
+    localTime.tm_isdst = -1;
+
+    return static_cast<int64_t>(std::mktime(&localTime)) * 1000;
+}
+
+static bool ParseTimeOfDay(const char* value, int64_t referenceTime, bool endOfPeriod, int64_t& time)
+{
+    int hours = 0;
+    int minutes = 0;
+    int seconds = 0;
+    int fieldCount = sscanf(value, "%d:%d:%d", &hours, &minutes, &seconds);
+    if (fieldCount < 2)
+    {
+        return false;
+    }
+
+    time = ResolveTimeOfDay(referenceTime, hours, minutes, seconds);
+    if (endOfPeriod)
+    {
+        time += fieldCount == 2 ? 59999 : 999;
+    }
+
+    return true;
+}
+
+// The start of the hour in the file's name, which BuildLogFileName ends with _YYYY_MM_DD_HH and possibly a sequence
+// number, or failing that its modification time.  Only used when the index is empty, to give times of day a date.
+static int64_t FindFileReferenceTime(const std::experimental::filesystem::path& logFile)
+{
+    IP::String name = logFile.stem().string().c_str();
+    for (size_t separator = name.find('_'); separator != IP::String::npos; separator = name.find('_', separator + 1))
+    {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        int hour = 0;
+        int length = 0;
+        if (sscanf(name.c_str() + separator, "_%4d_%2d_%2d_%2d%n", &year, &month, &day, &hour, &length) == 4 && length == 14 &&
+            month >= 1 && month <= 12 && day >= 1 && day <= 31 && hour >= 0 && hour <= 23)
+        {
+            std::tm localTime = {};
+            localTime.tm_year = year - 1900;
+            localTime.tm_mon = month - 1;
+            localTime.tm_mday = day;
+            localTime.tm_hour = hour;
+            localTime.tm_isdst = -1;
+
+            return static_cast<int64_t>(std::mktime(&localTime)) * 1000;
+        }
+    }
+
+    auto modifiedTime = std::experimental::filesystem::last_write_time(logFile);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(modifiedTime.time_since_epoch()).count();
+}
+
+// the first HH:MM:SS on an unindexed line, resolved on the reference date; false if there isn't one
+static bool FindLineTime(const char* line, size_t length, int64_t referenceTime, int64_t& lineTime)
+{
+    auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+    for (size_t i = 0; i + 8 <= length; ++i)
+    {
+        const char* text = line + i;
+        if (isDigit(text[0]) && isDigit(text[1]) && text[2] == ':' && isDigit(text[3]) && isDigit(text[4]) && text[5] == ':' && isDigit(text[6]) && isDigit(text[7]))
+        {
+            int hours = (text[0] - '0') * 10 + (text[1] - '0');
+            int minutes = (text[3] - '0') * 10 + (text[4] - '0');
+            int seconds = (text[6] - '0') * 10 + (text[7] - '0');
+            lineTime = ResolveTimeOfDay(referenceTime, hours, minutes, seconds);
+
+            if (i + 12 <= length && text[8] == '.' && isDigit(text[9]) && isDigit(text[10]) && isDigit(text[11]))
+            {
+                lineTime += (text[9] - '0') * 100 + (text[10] - '0') * 10 + (text[11] - '0');
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// the first "[Level]" on an unindexed line, which the standard layout and the usual patterns put before the message;
+// false for a continuation line
+static bool FindLineLevel(const char* line, size_t length, LogLevel& lineLevel)
+{
+    const char* end = line + length;
+    for (const char* bracket = static_cast<const char*>(memchr(line, '[', length)); bracket != nullptr;
+        bracket = static_cast<const char*>(memchr(bracket + 1, '[', end - bracket - 1)))
+    {
+        for (size_t level = 0; level < LOG_INDEX_LEVEL_COUNT; ++level)
+        {
+            const char* name = GetLogLevelName(static_cast<LogLevel>(level));
+            size_t nameLength = strlen(name);
+            if (static_cast<size_t>(end - bracket) > nameLength + 1 && !memcmp(bracket + 1, name, nameLength) && bracket[nameLength + 1] == ']')
+            {
+                lineLevel = static_cast<LogLevel>(level);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Indexed ranges hold only matching entries and are printed whole.  Unindexed ones are filtered line by line: a line with
+// a level or a time of day starts an entry, and lines with neither continue the one before.
+static uint64_t ScanRange(IP::FileUtils::MappedFile& file, const LogFileRange& range, const LineFilter* unindexedFilter)
+{
+    uint64_t mapStart = range.m_startOffset - range.m_startOffset % IP::FileUtils::MappedFile::GetMappingGranularity();
+    const char* view = file.Map(mapStart, static_cast<size_t>(range.m_endOffset - mapStart));
+    if (view == nullptr)
+    {
+        std::cerr << "log-query: unable to map offset " << range.m_startOffset << std::endl;
+        return 0;
+    }
+
+    const char* position = view + (range.m_startOffset - mapStart);
+    const char* end = view + (range.m_endOffset - mapStart);
+    uint64_t matchedLines = 0;
+    bool entryMatched = unindexedFilter == nullptr;
+
+    while (position < end)
+    {
+        const char* lineEnd = static_cast<const char*>(memchr(position, '\n', end - position));
+        lineEnd = lineEnd != nullptr ? lineEnd + 1 : end;
+
+        if (unindexedFilter != nullptr)
+        {
+            LogLevel lineLevel = LogLevel::Trace;
+            int64_t lineTime = 0;
+            bool hasLevel = FindLineLevel(position, lineEnd - position, lineLevel);
+            bool hasTime = FindLineTime(position, lineEnd - position, unindexedFilter->m_referenceTime, lineTime);
+
+            if (hasLevel || hasTime)
+            {
+                // an entry without a readable level only passes when every level is wanted
+                entryMatched = (hasLevel || unindexedFilter->m_minimumLevel == LogLevel::Trace) && lineLevel >= unindexedFilter->m_minimumLevel &&
+                    (!hasTime || (lineTime >= unindexedFilter->m_fromTime && lineTime <= unindexedFilter->m_toTime));
+            }
+        }
+
+        if (entryMatched)
+        {
+            fwrite(position, 1, lineEnd - position, stdout);
+            ++matchedLines;
+        }
+
+        position = lineEnd;
+    }
+
+    return matchedLines;
+}
+
+static bool RunQuery(const QueryOptions& options)
+{
+    auto startTime = SteadyClock::now();
+
+    LogIndex index = ReadLogIndex(BuildLogIndexFileName(options.m_logFile));
+    const IP::Vector<LogIndexBucket>& buckets = index.m_buckets;
+
+    IP::FileUtils::MappedFile file;
+    if (!file.Open(options.m_logFile, IP::FileUtils::MappedFileMode::ReadOnly))
+    {
+        std::cerr << "log-query: unable to open " << options.m_logFile << std::endl;
+        return false;
+    }
+
+    int64_t referenceTime = buckets.empty() ? FindFileReferenceTime(options.m_logFile) : buckets.front().m_firstTime;
+    int64_t fromTime = INT64_MIN;
+    int64_t toTime = INT64_MAX;
+    if ((options.m_from != nullptr && !ParseTimeOfDay(options.m_from, referenceTime, false, fromTime)) ||
+        (options.m_to != nullptr && !ParseTimeOfDay(options.m_to, referenceTime, true, toTime)))
+    {
+        PrintUsage();
+        return false;
+    }
+
+    IP::Vector<LogFileRange> ranges = FindLogIndexRanges(index, fromTime, toTime, options.m_minimumLevel);
+
+    uint64_t fileSize = file.GetSize();
+    uint64_t indexedEnd = buckets.empty() ? 0 : buckets.back().m_endOffset;
+    int64_t indexedLastTime = buckets.empty() ? INT64_MIN : buckets.back().m_lastTime;
+    bool scanUnindexed = fileSize > indexedEnd && toTime >= indexedLastTime;
+    if (scanUnindexed)
+    {
+        ranges.push_back({ indexedEnd, fileSize });
+    }
+
+    uint64_t scannedBytes = 0;
+    uint64_t matchedLines = 0;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        LogFileRange& range = ranges[i];
+        bool indexed = !scanUnindexed || i + 1 < ranges.size();
+        LineFilter unindexedFilter = { options.m_minimumLevel, fromTime, toTime, referenceTime };
+
+        // the index can run ahead of lines still buffered by the logger
+        range.m_endOffset = std::min(range.m_endOffset, fileSize);
+        if (range.m_startOffset >= range.m_endOffset)
+        {
+            continue;
+        }
+
+        matchedLines += ScanRange(file, range, indexed ? nullptr : &unindexedFilter);
+        scannedBytes += range.m_endOffset - range.m_startOffset;
+    }
+
+    fflush(stdout);
+
+    if (options.m_printStatistics)
+    {
+        double elapsedMs = std::chrono::duration<double, std::milli>(SteadyClock::now() - startTime).count();
+        fprintf(stderr, "%zu buckets, %zu ranges, scanned %llu of %llu bytes, %llu lines matched in %.2f ms\n",
+            buckets.size(), ranges.size(), static_cast<unsigned long long>(scannedBytes), static_cast<unsigned long long>(fileSize),
+            static_cast<unsigned long long>(matchedLines), elapsedMs);
+    }
+
+    return true;
+}
+
+static bool ParseArguments(int argc, char* argv[], QueryOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* option = argv[i];
+
+        if (!strcmp(option, "--stats"))
+        {
+            options.m_printStatistics = true;
+            continue;
+        }
+
+        if (option[0] != '-' || option[1] != '-')
+        {
+            if (options.m_logFile != nullptr)
+            {
+                return false;
+            }
+
+            options.m_logFile = option;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+
+        const char* value = argv[++i];
+
+        if (!strcmp(option, "--from"))
+        {
+            options.m_from = value;
+        }
+        else if (!strcmp(option, "--to"))
+        {
+            options.m_to = value;
+        }
+        else if (!strcmp(option, "--level"))
+        {
+            if (!ParseLevel(value, options.m_minimumLevel))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return options.m_logFile != nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    QueryOptions options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        return RunQuery(options) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "log-query: " << options.m_logFile << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
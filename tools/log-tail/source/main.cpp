@@ -0,0 +1,138 @@
+#include <iostream>
+
+#include <ip/core/logging/LogLevel.h>
+#include <ip/core/logging/SharedMemoryLogFormat.h>
+#include <ip/core/memory/stl/String.h>
+
+#include <chrono>
+#include <thread>
+
+#include <stdio.h>
+#include <string.h>
+
+// Follows a SharedMemoryLogger's ring and prints its lines as they're published, until the writer shuts down.  Reading
+// never blocks the writer; if this falls a full ring behind, the overwritten entries are reported on stderr.
+//
+// usage: log-tail [--from-start] [--level LEVEL] <name>
+
+using namespace IP::Logging;
+
+// how long to sleep once caught up with the writer
+static const std::chrono::milliseconds POLL_INTERVAL(10);
+
+static void PrintUsage()
+{
+    std::cerr << "usage: log-tail [--from-start] [--level Trace|Debug|Info|Warn|Error|Fatal] <name>" << std::endl;
+}
+
+static bool ParseLevel(const char* value, LogLevel& level)
+{
+    for (int i = 0; i < static_cast<int>(LogLevel::None); ++i)
+    {
+        if (!strcmp(value, GetLogLevelName(static_cast<LogLevel>(i))))
+        {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    bool fromStart = false;
+    LogLevel minimumLevel = LogLevel::Trace;
+    const char* name = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--from-start"))
+        {
+            fromStart = true;
+        }
+        else if (!strcmp(argv[i], "--level") && i + 1 < argc)
+        {
+            if (!ParseLevel(argv[++i], minimumLevel))
+            {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (name == nullptr && argv[i][0] != '-')
+        {
+            name = argv[i];
+        }
+        else
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (name == nullptr)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        SharedMemoryLogReader reader(name);
+        if (!fromStart)
+        {
+            reader.SeekToEnd();
+        }
+
+        IP::String line;
+        LogLevel level = LogLevel::None;
+        uint64_t lostCount = 0;
+
+        while (true)
+        {
+            // sample before draining, so entries published just before the writer closed are still printed
+            bool writerOpen = reader.IsWriterOpen();
+
+            bool readAny = false;
+            while (reader.ReadNext(line, level, lostCount))
+            {
+                readAny = true;
+
+                if (lostCount > 0)
+                {
+                    fprintf(stderr, "log-tail: %llu entries lost\n", static_cast<unsigned long long>(lostCount));
+                }
+
+                if (level >= minimumLevel)
+                {
+                    line.push_back('\n');
+                    fwrite(line.data(), 1, line.size(), stdout);
+                }
+            }
+
+            if (!writerOpen)
+            {
+                break;
+            }
+
+            if (readAny)
+            {
+                fflush(stdout);
+            }
+            else
+            {
+                std::this_thread::sleep_for(POLL_INTERVAL);
+            }
+        }
+
+        fflush(stdout);
+        fprintf(stderr, "log-tail: writer %u closed %s\n", reader.GetWriterProcessId(), name);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "log-tail: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+
+#include <ip/core/memory/stl/String.h>
+#include <ip/core/profiling/ChromeTrace.h>
+#include <ip/core/profiling/ProfileReport.h>
+#include <ip/core/profiling/ProfileStreamFormat.h>
+#include <ip/core/utils/MappedFile.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Converts a file written by StartProfileStream into a Chrome trace, for chrome://tracing or ui.perfetto.dev, and
+// prints its per-frame report along with any events threads dropped because the writer didn't keep up.
+//
+// usage: profile-convert [--trace <out.json>] [--no-report] <capture.iprof>
+
+static void PrintUsage()
+{
+    std::cerr << "usage: profile-convert [--trace <out.json>] [--no-report] <capture.iprof>" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* tracePath = nullptr;
+    const char* path = nullptr;
+    bool report = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--no-report"))
+        {
+            report = false;
+        }
+        else if (path == nullptr && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (path == nullptr)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    IP::FileUtils::MappedFile file;
+    if (!file.Open(path, IP::FileUtils::MappedFileMode::ReadOnly))
+    {
+        std::cerr << "profile-convert: unable to open " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const char* data = file.GetSize() > 0 ? file.Map(0, static_cast<size_t>(file.GetSize())) : nullptr;
+
+    IP::Profiling::ProfileCapture capture;
+    if (data == nullptr || !IP::Profiling::ReadProfileStream(data, static_cast<size_t>(file.GetSize()), capture))
+    {
+        std::cerr << "profile-convert: " << path << " isn't a profile stream" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    file.Close();
+
+    for (const auto& thread : capture.m_threads)
+    {
+        if (thread.m_droppedEvents > 0)
+        {
+            std::cerr << "profile-convert: thread " << thread.m_threadId << " (" << thread.m_threadName << ") dropped " << thread.m_droppedEvents << " events" << std::endl;
+        }
+    }
+
+    if (tracePath != nullptr && !IP::Profiling::WriteChromeTrace(capture, tracePath))
+    {
+        std::cerr << "profile-convert: unable to write " << tracePath << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (report)
+    {
+        IP::String text;
+        IP::Profiling::FormatProfileFrameReport(text, IP::Profiling::BuildProfileFrameReport(capture));
+        fwrite(text.data(), 1, text.size(), stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,7 +1,11 @@
 #include <iostream>
 
+#include <ip/core/logging/FlightRecorder.h>
 #include <ip/core/logging/LoggingMacros.h>
 #include <ip/core/logging/LogSystem.h>
+#include <ip/core/metrics/CountingMemoryAllocator.h>
+#include <ip/core/metrics/MetricsDumper.h>
+#include <ip/core/metrics/MetricsRegistry.h>
 #include <ip/core/UnreferencedParam.h>
 
 #include <vulkan-dev/tutorial/TutorialApplication.h>
@@ -16,6 +20,14 @@ int main(int argc, char* argv[])
     const char *layer_path = getenv("VK_LAYER_PATH");
     assert(layer_path != nullptr);
 
+    // allocation counts alongside the renderer and logger metrics, rewritten every second for the monitoring scraper
+    IP::Metrics::CountingMemoryAllocator countingAllocator(IP::Metrics::GetMetricsRegistry());
+    IP::ScopedMemoryAllocator allocatorScope(&countingAllocator);
+    IP::Metrics::MetricsDumper metricsDumper(IP::Metrics::GetMetricsRegistry(), "Tutorial.prom", std::chrono::milliseconds(1000));
+
+    // keeps recent Trace history in memory, dumped if we hit LOG_FATAL or crash
+    IP::Logging::FlightRecorderScope flightRecorder(4096, IP::Logging::LogLevel::Trace, ".");
+
     IP::Logging::SetLogLevel(IP::Logging::LogLevel::Debug);
     DECLARE_BACKGROUND_FILE_LOGGER(logScope, "Tutorial", ".")
 